@@ -0,0 +1,797 @@
+/**
+ * @file bench.cpp
+ * @brief Repeatable micro and macro benchmarks of the rendering and input pipeline, with JSON output and baseline comparison.
+ *
+ * Build target: ggui_bench (wired via bin/meson.build, run with `meson test --benchmark`)
+ *
+ * Usage:
+ *   ./ggui_bench [--filter <text>] [--rounds <count>] [--output <file>] [--baseline <file>] [--tolerance <ratio>]
+ *
+ * Behavior:
+ * - Each benchmark is calibrated to run for at least a millisecond per round, then timed over the rounds.
+ * - The best round is reported in nanoseconds per unit of work (cell, byte or frame), the median alongside it for the noise.
+ * - The results are printed as JSON, and written into --output when given, which is how a baseline is recorded.
+ * - With --baseline, every result slower than the baseline by more than the tolerance (0.10 by default) is reported
+ *   and the exit code is 1, so that changes can be gated on it. A missing baseline file only warns.
+ * - animation/minute runs a minute of memory driven animations on a fast forwarded INTERNAL::CLOCK, so it takes as long
+ *   as rendering its frames does and every run renders exactly the same frames.
+ *
+ * Scaling matrix:
+ *   ./ggui_bench --matrix [--csv] [--sizes 80x24,...] [--elements 10,...] [--depths 1,...] [--dirty 1,...] [--filter <text>] [--rounds <count>] [--output <file>]
+ *
+ * - Times whole headless frames for every terminal size x element count x tree depth x percentage of dirty elements,
+ *   each opaque and with every element half transparent.
+ * - Prints the table as JSON, or as CSV with --csv, followed by the scaling exponent of each axis: the slope of
+ *   log(frame time) over log(axis value) with the other axes held still, as the median, minimum and maximum over
+ *   all of their combinations. An exponent near 1 is linear in that axis, near 0 independent of it, above 1 worse.
+ */
+
+#include <ggui_dev.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace GGUI;
+
+namespace {
+    // Renders directly, like the rendering thread does.
+    class renderedElement : public element {
+    public:
+        using element::element;
+        using element::render;
+    };
+
+    // Exposes the line cache rebuild, which setText() and the size calculations run.
+    class cachedTextField : public textField {
+    public:
+        using textField::textField;
+        using textField::updateTextCache;
+    };
+
+    struct result {
+        std::string name;
+        std::string unit;
+        double best = 0;        // Nanoseconds per unit in the fastest round.
+        double median = 0;      // Nanoseconds per unit in the median round.
+    };
+
+    struct options {
+        std::string filter;
+        std::string output;
+        std::string baseline;
+        double tolerance = 0.10;
+        int rounds = 15;
+
+        // The scaling matrix, with --matrix.
+        bool matrix = false;
+        bool csv = false;
+        std::vector<std::pair<unsigned int, unsigned int>> sizes = { {80, 24}, {160, 48}, {240, 72}, {400, 120} };
+        std::vector<unsigned int> elements = { 10, 100, 1000, 10000 };
+        std::vector<unsigned int> depths = { 1, 4, 16 };
+        std::vector<unsigned int> dirty = { 1, 10, 100 };   // Percentages of the elements changed before each frame.
+    };
+
+    /**
+     * @brief Times the job over the rounds, each running it enough times to take at least a millisecond, unless filtered out.
+     * @param work Units of work done by one run of the job, the results are divided by it.
+     */
+    void measure(std::vector<result>& results, const options& settings, const std::string& name, const std::string& unit, size_t work, const std::function<void()>& job) {
+        using clock = std::chrono::high_resolution_clock;
+
+        if (name.find(settings.filter) == std::string::npos)
+            return;
+
+        // Warm up the caches and find how many runs fill a round.
+        size_t runs = 1;
+        while (true) {
+            auto start = clock::now();
+            for (size_t i = 0; i < runs; i++)
+                job();
+
+            if (clock::now() - start >= std::chrono::milliseconds(1) || runs >= (1u << 24))
+                break;
+
+            runs *= 2;
+        }
+
+        std::vector<double> perUnit;
+        for (int round = 0; round < settings.rounds; round++) {
+            auto start = clock::now();
+            for (size_t i = 0; i < runs; i++)
+                job();
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+
+            perUnit.push_back((double)elapsed / (double)(runs * work));
+        }
+
+        std::sort(perUnit.begin(), perUnit.end());
+
+        results.push_back({ name, unit, perUnit.front(), perUnit[perUnit.size() / 2] });
+    }
+
+    /**
+     * @brief A frame of cells in runs of eight equally coloured cells, like rows of buttons and labels.
+     */
+    std::vector<UTF> stripedCells(unsigned int width, unsigned int height) {
+        static const RGB palette[] = { COLOR::RED, COLOR::GREEN, COLOR::BLUE, COLOR::WHITE, COLOR::BLACK, COLOR::YELLOW };
+
+        std::vector<UTF> cells(width * height);
+        for (size_t i = 0; i < cells.size(); i++) {
+            cells[i] = UTF((char)('a' + i % 26), { palette[(i / 8) % 6], palette[(i / 8 + 3) % 6] });
+        }
+
+        return cells;
+    }
+
+    void benchPipeline(const options& settings, std::vector<result>& results) {
+        constexpr unsigned int width = 200;
+        constexpr unsigned int height = 60;
+        constexpr size_t cells = width * height;
+
+        std::vector<UTF> frame = stripedCells(width, height);
+
+        measure(results, settings, "encodeBuffer", "ns/cell", cells, [&]() {
+            INTERNAL::encodeBuffer(&frame);
+        });
+
+        unsigned int liquefiedSize = 0;
+        measure(results, settings, "liquifyUTFText", "ns/cell", cells, [&]() {
+            INTERNAL::liquifyUTFText(&frame, liquefiedSize, width, height);
+        });
+
+        INTERNAL::conveyorAllocator<INTERNAL::compactString> liquefied = INTERNAL::liquifyUTFText(&frame, liquefiedSize, width, height);
+        std::string encoded;
+        measure(results, settings, "toString", "ns/cell", cells, [&]() {
+            INTERNAL::toString(liquefied, liquefiedSize, encoded);
+        });
+    }
+
+    void benchNesting(const options& settings, std::vector<result>& results) {
+        renderedElement parent(width(200) | height(60), true);
+        renderedElement* child = new renderedElement(width(120) | height(40) | position(IVector3(40, 10)));
+        parent.addChild(child);
+
+        std::vector<UTF> parentCells = stripedCells(200, 60);
+        std::vector<UTF> childCells = stripedCells(120, 40);
+
+        measure(results, settings, "nestElement", "ns/cell", childCells.size(), [&]() {
+            INTERNAL::nestElement(&parent, child, parentCells, childCells);
+        });
+
+        // The same cells half transparent, which blends instead of copying.
+        renderedElement* translucent = new renderedElement(width(120) | height(40) | position(IVector3(40, 10)) | opacity(0.5f));
+        parent.addChild(translucent);
+
+        measure(results, settings, "nestElement/translucent", "ns/cell", childCells.size(), [&]() {
+            INTERNAL::nestElement(&parent, translucent, parentCells, childCells);
+        });
+    }
+
+    // The roots are embedded on construction like initGGUI() does for the real main element, so that their size applies right away.
+
+    /**
+     * @brief Renders the tree after recolouring all of its leaves, so that every frame redraws them.
+     */
+    void benchTree(const options& settings, std::vector<result>& results, const std::string& shape, renderedElement* root, std::vector<element*>& leaves) {
+        bool toggle = false;
+
+        measure(results, settings, "render/" + shape, "ns/cell", root->getWidth() * root->getHeight(), [&]() {
+            toggle = !toggle;
+
+            for (element* leaf : leaves)
+                leaf->setBackgroundColor(toggle ? COLOR::RED : COLOR::BLUE);
+
+            root->render();
+        });
+
+        delete root;
+    }
+
+    void benchTrees(const options& settings, std::vector<result>& results) {
+        std::vector<element*> leaves;
+
+        // Flat: a grid of 8 x 6 panels directly under the root.
+        renderedElement* flat = new renderedElement(width(200) | height(60), true);
+        for (int y = 0; y < 6; y++)
+            for (int x = 0; x < 8; x++) {
+                element* panel = new element(width(25) | height(10) | position(IVector3(x * 25, y * 10)) | enableBorder(true));
+                flat->addChild(panel);
+                leaves.push_back(panel);
+            }
+        benchTree(settings, results, "flat", flat, leaves);
+
+        // Deep: 24 levels, each inset by one cell from its parent.
+        leaves.clear();
+        renderedElement* deep = new renderedElement(width(200) | height(60), true);
+        element* parent = deep;
+        for (int level = 1; level <= 24; level++) {
+            element* inner = new element(width(200 - level * 2) | height(60 - level * 2) | position(IVector3(1, 1)));
+            parent->addChild(inner);
+            parent = inner;
+        }
+        leaves.push_back(parent);
+        benchTree(settings, results, "deep", deep, leaves);
+
+        // Wide: 1200 small cells, like a table or a character grid made of elements.
+        auto buildWide = [&leaves]() {
+            leaves.clear();
+            renderedElement* wide = new renderedElement(width(200) | height(60), true);
+            for (int y = 0; y < 30; y++)
+                for (int x = 0; x < 40; x++) {
+                    element* cell = new element(width(5) | height(2) | position(IVector3(x * 5, y * 2)));
+                    wide->addChild(cell);
+                    leaves.push_back(cell);
+                }
+            return wide;
+        };
+        benchTree(settings, results, "wide", buildWide(), leaves);
+
+        // The same with the element profiler accounting every one of the renders, for its overhead.
+        INTERNAL::PROFILER::enable(true);
+        benchTree(settings, results, "wide/profiled", buildWide(), leaves);
+        INTERNAL::PROFILER::enable(false);
+        INTERNAL::PROFILER::reset();
+
+        // Translucent: overlapping half transparent panels, which blend into each other.
+        leaves.clear();
+        renderedElement* translucent = new renderedElement(width(200) | height(60), true);
+        for (int i = 0; i < 16; i++) {
+            element* panel = new element(width(80) | height(24) | position(IVector3(i * 7, i * 2)) | opacity(0.5f));
+            translucent->addChild(panel);
+            leaves.push_back(panel);
+        }
+        benchTree(settings, results, "translucent", translucent, leaves);
+    }
+
+    /**
+     * @brief Whole frames through renderCycle() into the headless backend, encoding included.
+     */
+    void benchFrames(const options& settings, std::vector<result>& results) {
+        INTERNAL::headlessBackend output(200, 60);
+        INTERNAL::backend* previous = getBackend();
+        setBackend(&output);
+
+        element* previousMain = INTERNAL::currentContext->main;
+        INTERNAL::currentContext->main = new element(width(200) | height(60), true);
+
+        std::vector<element*> panels;
+        for (int y = 0; y < 6; y++)
+            for (int x = 0; x < 8; x++) {
+                element* panel = new element(width(25) | height(10) | position(IVector3(x * 25, y * 10)) | enableBorder(true));
+                INTERNAL::currentContext->main->addChild(panel);
+                panels.push_back(panel);
+            }
+
+        size_t frame = 0;
+        measure(results, settings, "frame/oneDirty", "ns/frame", 1, [&]() {
+            frame++;
+            panels[frame % panels.size()]->setBackgroundColor(frame % 2 ? COLOR::RED : COLOR::BLUE);
+            INTERNAL::renderCycle();
+        });
+
+        measure(results, settings, "frame/allDirty", "ns/frame", 1, [&]() {
+            frame++;
+            for (element* panel : panels)
+                panel->setBackgroundColor(frame % 2 ? COLOR::RED : COLOR::BLUE);
+            INTERNAL::renderCycle();
+        });
+
+        delete INTERNAL::currentContext->main;
+        INTERNAL::currentContext->main = previousMain;
+        setBackend(previous);
+    }
+
+    /**
+     * @brief A minute of animations at 60 frames per second, driven by retriggering memories on a fast forwarded clock.
+     * @details Each run starts from the same virtual time in a fresh context, the clock moves a frame at a time instead of waiting.
+     */
+    void benchAnimation(const options& settings, std::vector<result>& results) {
+        constexpr auto frameTime = std::chrono::microseconds(16667);
+        constexpr size_t frames = 60 * 60;
+
+        INTERNAL::headlessBackend output(80, 24);
+        INTERNAL::backend* previous = getBackend();
+        INTERNAL::context* previousContext = INTERNAL::currentContext;
+
+        measure(results, settings, "animation/minute", "ns/minute", 1, [&]() {
+            INTERNAL::context session;
+            INTERNAL::currentContext = &session;
+            setBackend(&output);
+            INTERNAL::updateMaxWidthAndHeight();
+            INTERNAL::CLOCK::fastForward(INTERNAL::CLOCK::timePoint());
+
+            session.main = new element(width(80) | height(24), true);
+
+            // Panels blinking on their own periods in milliseconds, from a frame to half a second.
+            const size_t periods[] = { 16, 33, 50, 100, 150, 250, 333, 500 };
+
+            for (int i = 0; i < 8; i++) {
+                element* panel = new element(width(10) | height(12) | position(IVector3(i * 10, 0)) | enableBorder(true));
+                session.main->addChild(panel);
+
+                addMemory(memory(periods[i], [panel](event*) {
+                    panel->setBackgroundColor(panel->getBackgroundColor() == COLOR::RED ? COLOR::BLUE : COLOR::RED);
+                    return true;
+                }, MEMORY_FLAGS::RETRIGGER));
+            }
+
+            for (size_t frame = 0; frame < frames; frame++) {
+                INTERNAL::CLOCK::advance(frameTime);
+                INTERNAL::runEventTasks();
+                INTERNAL::renderCycle();
+            }
+
+            delete session.main;
+            session.main = nullptr;
+        });
+
+        INTERNAL::CLOCK::useReal();
+        INTERNAL::currentContext = previousContext;
+        setBackend(previous);
+    }
+
+    void benchInput(const options& settings, std::vector<result>& results) {
+        // Typing, arrows and mouse movement, as one read would bring them.
+        const std::string sample = "hello world\x1b[A\x1b[B\x1b[<35;10;5M\x1b[<35;11;5M\x1b[C\x1b[D";
+        std::string payload;
+        while (payload.size() + sample.size() <= 500)
+            payload += sample;
+
+        measure(results, settings, "Translate_Inputs", "ns/byte", payload.size(), [&]() {
+            INTERNAL::setRawInput(payload.data(), payload.size());
+            while (INTERNAL::Translate_Inputs());
+
+            for (input* translated : INTERNAL::currentContext->inputs)
+                delete translated;
+            INTERNAL::currentContext->inputs.clear();
+        });
+    }
+
+    void benchText(const options& settings, std::vector<result>& results) {
+        std::string text;
+        for (int line = 0; text.size() < 16 * 1024; line++)
+            text += "Line " + std::to_string(line) + " of the text which the field splits into its cache\n";
+
+        cachedTextField field(width(80) | height(24));
+        field.setText(text);
+
+        measure(results, settings, "textField::updateTextCache", "ns/byte", text.size(), [&]() {
+            field.updateTextCache();
+        });
+    }
+
+    std::string escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::string toJSON(const std::vector<result>& results, const options& settings) {
+        std::ostringstream json;
+
+        const char* build =
+        #if defined(GGUI_RELEASE)
+            "release";
+        #elif defined(GGUI_PROFILE)
+            "profile";
+        #elif defined(GGUI_DEBUG)
+            "debug";
+        #else
+            "unknown";
+        #endif
+
+        json << "{\n  \"build\": \"" << build << "\",\n  \"rounds\": " << settings.rounds << ",\n  \"results\": [\n";
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const result& current = results[i];
+
+            json << "    { \"name\": \"" << escape(current.name) << "\", \"unit\": \"" << current.unit
+                 << "\", \"value\": " << current.best << ", \"median\": " << current.median
+                 << ", \"perSecond\": " << (current.best > 0 ? 1e9 / current.best : 0) << " }"
+                 << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+
+        json << "  ]\n}\n";
+        return json.str();
+    }
+
+    /**
+     * @brief Reads the name and value pairs from a file written with --output.
+     */
+    std::vector<std::pair<std::string, double>> readBaseline(const std::string& content) {
+        std::vector<std::pair<std::string, double>> entries;
+
+        for (size_t at = content.find("\"name\": \""); at != std::string::npos; at = content.find("\"name\": \"", at)) {
+            at += 9;
+            size_t end = content.find('"', at);
+            size_t value = content.find("\"value\": ", end);
+
+            if (end == std::string::npos || value == std::string::npos)
+                break;
+
+            entries.emplace_back(content.substr(at, end - at), std::strtod(content.c_str() + value + 9, nullptr));
+            at = value;
+        }
+
+        return entries;
+    }
+
+    /**
+     * @brief Compares the results to the baseline.
+     * @return The count of results slower than the baseline by more than the tolerance.
+     */
+    int compare(const std::vector<result>& results, const options& settings) {
+        std::ifstream file(settings.baseline);
+
+        if (!file.is_open()) {
+            std::cerr << "No baseline at '" << settings.baseline << "', record one with --output " << settings.baseline << "\n";
+            return 0;
+        }
+
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        int regressions = 0;
+
+        for (auto& [name, expected] : readBaseline(content)) {
+            auto current = std::find_if(results.begin(), results.end(), [&name](const result& r) { return r.name == name; });
+
+            if (current == results.end() || expected <= 0)
+                continue;
+
+            double ratio = current->best / expected;
+            bool regressed = ratio > 1 + settings.tolerance;
+
+            std::cerr << (regressed ? "REGRESSED " : "ok        ") << name << ": " << current->best << " " << current->unit
+                      << " against " << expected << " (" << (ratio - 1) * 100 << "%)\n";
+
+            regressions += regressed;
+        }
+
+        return regressions;
+    }
+}
+
+namespace {
+    struct scenario {
+        unsigned int width = 0;
+        unsigned int height = 0;
+        unsigned int elements = 0;
+        unsigned int depth = 0;
+        unsigned int dirty = 0;     // Percentage.
+        bool translucent = false;
+        double best = 0;            // Nanoseconds per frame in the fastest round.
+        double median = 0;          // Nanoseconds per frame in the median round.
+    };
+
+    struct exponent {
+        std::string axis;
+        double median = 0;
+        double min = 0;
+        double max = 0;
+        size_t fits = 0;            // Combinations of the other axes which had at least two points to fit.
+    };
+
+    /**
+     * @brief Builds the elements as chains of the given depth, whose heads are laid out in a grid covering the main element.
+     * @details Every link of a chain fills its parent, so that the depth is nesting and not area.
+     * @return Every element of the chains, in the order they are made dirty.
+     */
+    std::vector<element*> buildChains(element* main, unsigned int count, unsigned int depth, bool translucent) {
+        std::vector<element*> built;
+        built.reserve(count);
+
+        unsigned int chains = (count + depth - 1) / depth;
+        unsigned int columns = std::max(1u, (unsigned int)std::ceil(std::sqrt((double)chains * main->getWidth() / main->getHeight())));
+        unsigned int rows = (chains + columns - 1) / columns;
+
+        unsigned int cellWidth = std::max(1u, main->getWidth() / columns);
+        unsigned int cellHeight = std::max(1u, main->getHeight() / rows);
+
+        for (unsigned int chain = 0; chain < chains; chain++) {
+            element* parent = main;
+            IVector3 at((chain % columns) * cellWidth % main->getWidth(), (chain / columns) * cellHeight % main->getHeight());
+
+            for (unsigned int link = 0; link < depth && built.size() < count; link++) {
+                element* current = new element(width(cellWidth) | height(cellHeight) | position(at) | opacity(translucent ? 0.5f : 1.0f));
+                parent->addChild(current);
+                built.push_back(current);
+
+                parent = current;
+                at = IVector3(0, 0);
+            }
+        }
+
+        return built;
+    }
+
+    /**
+     * @brief Times whole frames through renderCycle() into a headless backend, for every scenario of the matrix.
+     */
+    std::vector<scenario> runMatrix(const options& settings) {
+        std::vector<scenario> scenarios;
+
+        INTERNAL::backend* previous = getBackend();
+        element* previousMain = INTERNAL::currentContext->main;
+
+        for (auto [columns, rows] : settings.sizes) {
+            INTERNAL::headlessBackend output(columns, rows);
+            setBackend(&output);
+
+            for (unsigned int count : settings.elements)
+                for (unsigned int depth : settings.depths)
+                    for (bool translucent : { false, true }) {
+                        INTERNAL::currentContext->main = new element(width(columns) | height(rows), true);
+                        std::vector<element*> built = buildChains(INTERNAL::currentContext->main, count, depth, translucent);
+
+                        // The first frame renders everything, so that the scenarios only differ by what they change.
+                        INTERNAL::renderCycle();
+
+                        for (unsigned int percent : settings.dirty) {
+                            size_t changed = std::max<size_t>(1, (built.size() * percent + 99) / 100);
+                            size_t next = 0;
+                            bool toggle = false;
+
+                            std::ostringstream name;
+                            name << "matrix/" << columns << "x" << rows << "/n" << count << "/d" << depth << "/dirty" << percent << (translucent ? "/translucent" : "/opaque");
+
+                            std::vector<result> timed;
+                            measure(timed, settings, name.str(), "ns/frame", 1, [&]() {
+                                toggle = !toggle;
+
+                                for (size_t i = 0; i < changed; i++, next++)
+                                    built[next % built.size()]->setBackgroundColor(toggle ? COLOR::RED : COLOR::BLUE);
+
+                                INTERNAL::renderCycle();
+                            });
+
+                            if (!timed.empty())
+                                scenarios.push_back({ columns, rows, count, depth, percent, translucent, timed.front().best, timed.front().median });
+                        }
+
+                        delete INTERNAL::currentContext->main;
+                    }
+        }
+
+        INTERNAL::currentContext->main = previousMain;
+        setBackend(previous);
+
+        return scenarios;
+    }
+
+    /**
+     * @brief Fits the slope of log(time) over log(axis) for every combination of the other axes.
+     * @param value Gives the axis value of a scenario.
+     * @param others Gives a key which is equal for the scenarios that differ only by this axis.
+     */
+    exponent fitExponent(const std::vector<scenario>& scenarios, const std::string& axis, const std::function<double(const scenario&)>& value, const std::function<std::string(const scenario&)>& others) {
+        std::vector<std::pair<std::string, std::vector<std::pair<double, double>>>> groups;
+
+        for (const scenario& current : scenarios) {
+            if (current.best <= 0 || value(current) <= 0)
+                continue;
+
+            std::string key = others(current);
+            auto group = std::find_if(groups.begin(), groups.end(), [&key](auto& existing) { return existing.first == key; });
+
+            if (group == groups.end()) {
+                groups.push_back({ key, {} });
+                group = groups.end() - 1;
+            }
+
+            group->second.emplace_back(std::log(value(current)), std::log(current.best));
+        }
+
+        std::vector<double> slopes;
+        for (auto& [key, points] : groups) {
+            if (points.size() < 2)
+                continue;
+
+            double meanX = 0, meanY = 0;
+            for (auto& [x, y] : points) {
+                meanX += x;
+                meanY += y;
+            }
+            meanX /= points.size();
+            meanY /= points.size();
+
+            double covariance = 0, variance = 0;
+            for (auto& [x, y] : points) {
+                covariance += (x - meanX) * (y - meanY);
+                variance += (x - meanX) * (x - meanX);
+            }
+
+            if (variance > 0)
+                slopes.push_back(covariance / variance);
+        }
+
+        exponent fitted;
+        fitted.axis = axis;
+        fitted.fits = slopes.size();
+
+        if (!slopes.empty()) {
+            std::sort(slopes.begin(), slopes.end());
+            fitted.median = slopes[slopes.size() / 2];
+            fitted.min = slopes.front();
+            fitted.max = slopes.back();
+        }
+
+        return fitted;
+    }
+
+    std::vector<exponent> fitExponents(const std::vector<scenario>& scenarios) {
+        auto key = [](const scenario& s, bool size, bool count, bool depth, bool dirty) {
+            std::ostringstream text;
+            if (size) text << s.width << "x" << s.height << "/";
+            if (count) text << s.elements << "/";
+            if (depth) text << s.depth << "/";
+            if (dirty) text << s.dirty << "/";
+            text << s.translucent;
+            return text.str();
+        };
+
+        return {
+            fitExponent(scenarios, "area", [](const scenario& s) { return (double)s.width * s.height; }, [&key](const scenario& s) { return key(s, false, true, true, true); }),
+            fitExponent(scenarios, "elements", [](const scenario& s) { return (double)s.elements; }, [&key](const scenario& s) { return key(s, true, false, true, true); }),
+            fitExponent(scenarios, "depth", [](const scenario& s) { return (double)s.depth; }, [&key](const scenario& s) { return key(s, true, true, false, true); }),
+            fitExponent(scenarios, "dirty", [](const scenario& s) { return (double)s.dirty; }, [&key](const scenario& s) { return key(s, true, true, true, false); }),
+        };
+    }
+
+    std::string matrixToCSV(const std::vector<scenario>& scenarios, const std::vector<exponent>& exponents) {
+        std::ostringstream csv;
+
+        csv << "width,height,elements,depth,dirty,translucent,best_ns,median_ns\n";
+        for (const scenario& s : scenarios)
+            csv << s.width << "," << s.height << "," << s.elements << "," << s.depth << "," << s.dirty << "," << s.translucent << "," << s.best << "," << s.median << "\n";
+
+        csv << "\naxis,exponent,min,max,fits\n";
+        for (const exponent& e : exponents)
+            csv << e.axis << "," << e.median << "," << e.min << "," << e.max << "," << e.fits << "\n";
+
+        return csv.str();
+    }
+
+    std::string matrixToJSON(const std::vector<scenario>& scenarios, const std::vector<exponent>& exponents, const options& settings) {
+        std::ostringstream json;
+
+        json << "{\n  \"rounds\": " << settings.rounds << ",\n  \"scenarios\": [\n";
+        for (size_t i = 0; i < scenarios.size(); i++) {
+            const scenario& s = scenarios[i];
+
+            json << "    { \"width\": " << s.width << ", \"height\": " << s.height << ", \"elements\": " << s.elements
+                 << ", \"depth\": " << s.depth << ", \"dirty\": " << s.dirty << ", \"translucent\": " << (s.translucent ? "true" : "false")
+                 << ", \"value\": " << s.best << ", \"median\": " << s.median << " }"
+                 << (i + 1 < scenarios.size() ? ",\n" : "\n");
+        }
+
+        json << "  ],\n  \"exponents\": [\n";
+        for (size_t i = 0; i < exponents.size(); i++) {
+            const exponent& e = exponents[i];
+
+            json << "    { \"axis\": \"" << e.axis << "\", \"exponent\": " << e.median << ", \"min\": " << e.min << ", \"max\": " << e.max << ", \"fits\": " << e.fits << " }"
+                 << (i + 1 < exponents.size() ? ",\n" : "\n");
+        }
+
+        json << "  ]\n}\n";
+        return json.str();
+    }
+
+    /**
+     * @brief Parses a comma separated list of numbers, or of WIDTHxHEIGHT pairs.
+     */
+    std::vector<unsigned int> parseList(const std::string& text) {
+        std::vector<unsigned int> values;
+        std::istringstream stream(text);
+
+        for (std::string item; std::getline(stream, item, ',');)
+            if (unsigned int value = (unsigned int)std::strtoul(item.c_str(), nullptr, 10))
+                values.push_back(value);
+
+        return values;
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> parseSizes(const std::string& text) {
+        std::vector<std::pair<unsigned int, unsigned int>> sizes;
+        std::istringstream stream(text);
+
+        for (std::string item; std::getline(stream, item, ',');) {
+            size_t separator = item.find('x');
+            if (separator == std::string::npos)
+                continue;
+
+            unsigned int columns = (unsigned int)std::strtoul(item.c_str(), nullptr, 10);
+            unsigned int rows = (unsigned int)std::strtoul(item.c_str() + separator + 1, nullptr, 10);
+
+            if (columns && rows)
+                sizes.emplace_back(columns, rows);
+        }
+
+        return sizes;
+    }
+}
+
+int main(int argc, char** argv) {
+    options settings;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--filter" && hasValue)
+            settings.filter = argv[++i];
+        else if (argument == "--rounds" && hasValue)
+            settings.rounds = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--output" && hasValue)
+            settings.output = argv[++i];
+        else if (argument == "--baseline" && hasValue)
+            settings.baseline = argv[++i];
+        else if (argument == "--tolerance" && hasValue)
+            settings.tolerance = std::strtod(argv[++i], nullptr);
+        else if (argument == "--matrix")
+            settings.matrix = true;
+        else if (argument == "--csv")
+            settings.csv = true;
+        else if (argument == "--sizes" && hasValue)
+            settings.sizes = parseSizes(argv[++i]);
+        else if (argument == "--elements" && hasValue)
+            settings.elements = parseList(argv[++i]);
+        else if (argument == "--depths" && hasValue)
+            settings.depths = parseList(argv[++i]);
+        else if (argument == "--dirty" && hasValue)
+            settings.dirty = parseList(argv[++i]);
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--filter <text>] [--rounds <count>] [--output <file>] [--baseline <file>] [--tolerance <ratio>]\n"
+                      << "       " << argv[0] << " --matrix [--csv] [--sizes 80x24,...] [--elements 10,...] [--depths 1,...] [--dirty 1,...] [--filter <text>] [--rounds <count>] [--output <file>]\n";
+            return 2;
+        }
+    }
+
+    if (settings.matrix) {
+        std::vector<scenario> scenarios = runMatrix(settings);
+        std::vector<exponent> exponents = fitExponents(scenarios);
+
+        std::string table = settings.csv ? matrixToCSV(scenarios, exponents) : matrixToJSON(scenarios, exponents, settings);
+        std::cout << table;
+
+        if (!settings.output.empty()) {
+            std::ofstream file(settings.output);
+            file << table;
+        }
+
+        return 0;
+    }
+
+    std::vector<result> results;
+
+    benchPipeline(settings, results);
+    benchNesting(settings, results);
+    benchTrees(settings, results);
+    benchFrames(settings, results);
+    benchAnimation(settings, results);
+    benchInput(settings, results);
+    benchText(settings, results);
+
+    std::string json = toJSON(results, settings);
+    std::cout << json;
+
+    if (!settings.output.empty()) {
+        std::ofstream file(settings.output);
+        file << json;
+    }
+
+    if (!settings.baseline.empty() && compare(results, settings) > 0)
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file latency.cpp
+ * @brief Measure the input-to-photon latency of keystrokes through a pseudo terminal, from writing the key to reading the changed frame.
+ *
+ * Build target: latencyBenchmark (wired via bin/meson.build)
+ *
+ * Usage:
+ *   ./latencyBenchmark [keystrokes] [metrics file]
+ *
+ * Behavior:
+ * - Starts itself as a GGUI application on the other side of a pseudo terminal, which counts the typed keys on the screen.
+ * - Writes one key at a time into the terminal, and times until the first bytes of the changed frame are read
+ *   and until the frame has been read whole, which is when no more bytes arrive for quietMilliseconds.
+ * - The keys are spaced with a varying pause, so that they don't line up with the event loop.
+ * - With a metrics file the application also appends its own INTERNAL::METRICS, whose input.latency ends at the write.
+ * - Prints the percentiles of both in microseconds. POSIX only.
+ */
+
+#include <ggui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <sys/ioctl.h>
+    #include <sys/wait.h>
+    #include <termios.h>
+    #include <unistd.h>
+#endif
+
+// How long the terminal has to stay silent for the frame to count as read whole.
+static constexpr int quietMilliseconds = 20;
+
+/**
+ * @brief The application under measurement: a counter of the typed keys in the middle of the screen.
+ */
+static int runApplication(int argc, char** argv) {
+    using namespace GGUI;
+
+    SETTINGS::parseCommandLineArguments(argc, argv);
+
+    textField* counter = new textField(position(STYLES::center) | text("0"));
+    GGUI::GGUI(node(counter));
+
+    // The key presses only reach the focused elements.
+    pauseGGUI([counter]() {
+        getRoot()->setFocus(true);
+        getRoot()->on(constants::KEY_PRESS, [counter](event*) {
+            counter->setText(std::to_string(std::stoul(counter->getText()) + 1));
+            return true;
+        }, true);
+    });
+
+    waitForTermination();
+    return 0;
+}
+
+#if !defined(_WIN32)
+using timePoint = std::chrono::high_resolution_clock::time_point;
+
+/**
+ * @brief Reads until the terminal has been quiet for the given time or the timeout passes.
+ * @param firstRead Set to when the first bytes were read, if any.
+ * @param lastRead Set to when the last bytes were read, if any.
+ * @return The count of bytes read.
+ */
+static size_t readFrame(int terminal, int quiet, int timeout, timePoint& firstRead, timePoint& lastRead) {
+    using clock = std::chrono::high_resolution_clock;
+
+    char buffer[65536];
+    size_t total = 0;
+    timePoint deadline = clock::now() + std::chrono::milliseconds(timeout);
+
+    while (clock::now() < deadline) {
+        pollfd readable = { terminal, POLLIN, 0 };
+
+        if (poll(&readable, 1, total ? quiet : timeout) <= 0)
+            break;
+
+        ssize_t got = read(terminal, buffer, sizeof(buffer));
+        if (got <= 0)
+            break;
+
+        lastRead = clock::now();
+        if (!total)
+            firstRead = lastRead;
+
+        total += got;
+    }
+
+    return total;
+}
+
+static long long percentile(std::vector<long long> values, double wanted) {
+    if (values.empty())
+        return 0;
+
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t)(wanted / 100.0 * values.size()))];
+}
+
+static void report(const char* label, const std::vector<long long>& values) {
+    std::cout << label << "p50 " << percentile(values, 50) << " us, p95 " << percentile(values, 95)
+              << " us, p99 " << percentile(values, 99) << " us, max " << percentile(values, 100) << " us\n";
+}
+#endif
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "--application") {
+        // The rest are GGUI settings, given after the program name like on a normal start.
+        argv[1] = argv[0];
+        return runApplication(argc - 1, argv + 1);
+    }
+
+#if defined(_WIN32)
+    std::cerr << "The latency benchmark needs a POSIX pseudo terminal.\n";
+    return 1;
+#else
+    using clock = std::chrono::high_resolution_clock;
+
+    int keystrokes = argc > 1 ? std::atoi(argv[1]) : 200;
+    std::string metrics = argc > 2 ? argv[2] : "";
+
+    if (keystrokes <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [keystrokes] [metrics file]\n";
+        return 1;
+    }
+
+    int terminal = posix_openpt(O_RDWR | O_NOCTTY);
+    if (terminal < 0 || grantpt(terminal) != 0 || unlockpt(terminal) != 0) {
+        std::cerr << "Could not open a pseudo terminal!\n";
+        return 1;
+    }
+
+    std::string device = ptsname(terminal);
+
+    winsize size = {};
+    size.ws_row = 24;
+    size.ws_col = 80;
+    ioctl(terminal, TIOCSWINSZ, &size);
+
+    pid_t application = fork();
+
+    if (application == 0) {
+        // Becomes the session leader, so that the pseudo terminal turns into its controlling terminal.
+        setsid();
+
+        int follower = open(device.c_str(), O_RDWR);
+        dup2(follower, STDIN_FILENO);
+        dup2(follower, STDOUT_FILENO);
+        dup2(follower, STDERR_FILENO);
+        close(follower);
+        close(terminal);
+
+        std::string metricsArgument = "--metrics=" + metrics;
+        std::vector<char*> arguments = { argv[0], (char*)"--application" };
+        if (!metrics.empty())
+            arguments.push_back((char*)metricsArgument.c_str());
+        arguments.push_back(nullptr);
+
+        execv(argv[0], arguments.data());
+        _exit(127);
+    }
+
+    timePoint firstRead, lastRead;
+
+    if (readFrame(terminal, 300, 5000, firstRead, lastRead) == 0) {
+        std::cerr << "The application did not draw its first frame!\n";
+        kill(application, SIGKILL);
+        return 1;
+    }
+
+    std::vector<long long> firstBytes;
+    std::vector<long long> wholeFrames;
+    int missed = 0;
+
+    for (int i = 0; i < keystrokes; i++) {
+        // Between 2 and 9 milliseconds, so that the keys land at different points of the event loop.
+        usleep(2000 + (i * 7919) % 7000);
+
+        timePoint written = clock::now();
+
+        if (write(terminal, "k", 1) != 1)
+            break;
+
+        if (readFrame(terminal, quietMilliseconds, 1000, firstRead, lastRead) == 0) {
+            missed++;
+            continue;
+        }
+
+        firstBytes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(firstRead - written).count());
+        wholeFrames.push_back(std::chrono::duration_cast<std::chrono::microseconds>(lastRead - written).count());
+    }
+
+    kill(application, SIGINT);
+
+    timePoint ignored;
+    readFrame(terminal, 100, 2000, ignored, ignored);
+    waitpid(application, nullptr, 0);
+    close(terminal);
+
+    std::cout << "keystrokes:   " << keystrokes << " (" << missed << " without a frame)\n";
+    report("first byte:   ", firstBytes);
+    report("whole frame:  ", wholeFrames);
+
+    if (!metrics.empty())
+        std::cout << "metrics:      " << metrics << "\n";
+
+    return missed == keystrokes ? 1 : 0;
+#endif
+}
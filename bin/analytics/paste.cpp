@@ -0,0 +1,114 @@
+/**
+ * @file paste.cpp
+ * @brief Measure how long a 1 MB bracketed paste takes from raw terminal reads into a focused textField.
+ *
+ * Build target: pasteBenchmark (wired via bin/meson.build)
+ *
+ * Usage:
+ *   ./pasteBenchmark [megabytes] [rounds]
+ *
+ * Behavior:
+ * - Feeds the payload in read() sized chunks through INTERNAL::consumeBracketedPaste(), like Translate_Inputs() does.
+ * - Lets INTERNAL::eventHandler() deliver the single PASTE input into the focused textField.
+ * - Prints the best and average time over all rounds, and the throughput of the best round.
+ */
+
+#include <ggui_dev.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Same as the Raw_Input_Capacity of the Unix input reader, so the chunking matches real reads.
+static constexpr size_t readSize = UINT8_MAX * 2;
+
+/**
+ * @brief Build a payload of printable text with a line break every 80 characters, terminated with the paste end marker.
+ */
+static std::string buildPayload(size_t bytes) {
+    std::string payload;
+    payload.reserve(bytes + GGUI::constants::ANSI::BRACKETED_PASTE_END.size);
+
+    for (size_t i = 0; i < bytes; i++) {
+        payload.push_back((i % 80 == 79) ? '\r' : (char)('a' + (i % 26)));
+    }
+
+    payload.append(GGUI::constants::ANSI::BRACKETED_PASTE_END.text, GGUI::constants::ANSI::BRACKETED_PASTE_END.size);
+    return payload;
+}
+
+/**
+ * @brief Paste the payload into the field and return the elapsed time in microseconds.
+ */
+static long long pasteOnce(GGUI::textField& field, const std::string& payload) {
+    using namespace GGUI;
+
+    field.setText("");
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    INTERNAL::pasteInProgress = true;
+    for (size_t offset = 0; offset < payload.size() && INTERNAL::pasteInProgress; offset += readSize) {
+        size_t chunk = std::min(readSize, payload.size() - offset);
+        INTERNAL::consumeBracketedPaste((const unsigned char*)payload.data() + offset, chunk);
+    }
+
+    INTERNAL::eventHandler();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    using namespace GGUI;
+
+    size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    if (megabytes == 0 || rounds <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [megabytes] [rounds]\n";
+        return 1;
+    }
+
+    const size_t bytes = megabytes * 1024 * 1024;
+    const std::string payload = buildPayload(bytes);
+
+    textField field(width(80) | height(24));
+    field.compile();
+    field.input([](textField*, char) {});
+
+    // Hover and then click the field, so that it receives the paste.
+    INTERNAL::mouse = {0, 0, 0};
+    INTERNAL::eventHandler();
+    INTERNAL::currentContext->inputs.push_back(new input(0, constants::MOUSE_LEFT_CLICKED));
+    INTERNAL::eventHandler();
+
+    if (!field.isFocused()) {
+        std::cerr << "Could not focus the text field!\n";
+        return 1;
+    }
+
+    long long best = 0;
+    long long total = 0;
+
+    for (int i = 0; i < rounds; i++) {
+        long long elapsed = pasteOnce(field, payload);
+
+        if (field.getText().size() != bytes) {
+            std::cerr << "Paste was not delivered whole: " << field.getText().size() << " / " << bytes << " bytes\n";
+            return 1;
+        }
+
+        total += elapsed;
+        best = (i == 0) ? elapsed : std::min(best, elapsed);
+    }
+
+    std::cout << "paste size:   " << megabytes << " MB in " << (payload.size() + readSize - 1) / readSize << " reads\n";
+    std::cout << "best:         " << best << " us\n";
+    std::cout << "average:      " << total / rounds << " us\n";
+    std::cout << "throughput:   " << (best > 0 ? (double)bytes / best : 0.0) << " MB/s\n";
+
+    return 0;
+}
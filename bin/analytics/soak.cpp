@@ -0,0 +1,187 @@
+/**
+ * @file soak.cpp
+ * @brief Run a scripted headless workload for a long time and track how the resident memory and each subsystem grow.
+ *
+ * Build target: soakTest (wired via bin/meson.build, run by analytics/time.sh)
+ *
+ * Usage:
+ *   ./soakTest [seconds] [limit KB/min] [samples file]
+ *
+ * Behavior:
+ * - Renders frames as fast as it can into a headless backend, while an animated canvas, a text field whose text grows
+ *   and is cleared, a list whose items are added and removed, and recoloured panels keep changing.
+ * - Samples the resident set size and INTERNAL::MEMORY_USAGE::subsystems() every second, into the samples file as JSON lines when given.
+ * - Fits the growth of each over the samples after the first fifth of the run, which is left for the caches to warm up,
+ *   and prints it in KB per minute. The exit code is 1 if the resident memory grew faster than the limit (256 KB/min by default).
+ */
+
+#include <ggui_dev.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace GGUI;
+
+namespace {
+    struct sample {
+        double seconds = 0;
+        size_t frames = 0;
+        size_t resident = 0;
+        std::vector<INTERNAL::MEMORY_USAGE::subsystemUsage> subsystems;
+    };
+
+    /**
+     * @brief Least squares slope of the bytes over the seconds, in KB per minute.
+     */
+    double growthPerMinute(const std::vector<std::pair<double, double>>& points) {
+        if (points.size() < 2)
+            return 0;
+
+        double meanX = 0, meanY = 0;
+        for (auto& [x, y] : points) {
+            meanX += x;
+            meanY += y;
+        }
+        meanX /= points.size();
+        meanY /= points.size();
+
+        double covariance = 0, variance = 0;
+        for (auto& [x, y] : points) {
+            covariance += (x - meanX) * (y - meanY);
+            variance += (x - meanX) * (x - meanX);
+        }
+
+        return variance > 0 ? covariance / variance * 60 / 1024 : 0;
+    }
+
+    std::string toJSON(const sample& current) {
+        std::string result = "{\"seconds\":" + std::to_string(current.seconds) + ",\"frames\":" + std::to_string(current.frames) +
+                             ",\"resident\":" + std::to_string(current.resident) + ",\"subsystems\":{";
+
+        for (size_t i = 0; i < current.subsystems.size(); i++)
+            result += (i ? ",\"" : "\"") + current.subsystems[i].name + "\":" + std::to_string(current.subsystems[i].bytes);
+
+        return result + "}}";
+    }
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::strtod(argv[1], nullptr) : 60;
+    double limit = argc > 2 ? std::strtod(argv[2], nullptr) : 256;
+    std::ofstream samplesFile;
+
+    if (argc > 3)
+        samplesFile.open(argv[3], std::ios::trunc);
+
+    INTERNAL::headlessBackend output(120, 40);
+    setBackend(&output);
+
+    INTERNAL::currentContext->main = new element(width(120) | height(40), true);
+    element* main = INTERNAL::currentContext->main;
+
+    canvas* animated = new canvas(width(40) | height(20) | position(IVector3(0, 0)));
+    textField* typed = new textField(width(40) | height(20) | position(IVector3(40, 0)) | enableBorder(true));
+    listView* list = new listView(width(40) | height(20) | position(IVector3(80, 0)) | flowPriority(DIRECTION::COLUMN));
+    main->addChild(animated);
+    main->addChild(typed);
+    main->addChild(list);
+
+    std::vector<element*> panels;
+    for (int i = 0; i < 12; i++) {
+        element* panel = new element(width(10) | height(10) | position(IVector3(i * 10, 20)) | enableBorder(true));
+        main->addChild(panel);
+        panels.push_back(panel);
+    }
+
+    // The canvas has room for its sprites once it has been rendered.
+    INTERNAL::renderCycle();
+
+    for (int y = 0; y < animated->getHeight(); y++)
+        for (int x = 0; x < animated->getWidth(); x++)
+            animated->set(x, y, sprite({ UTF(' ', { COLOR::RED, COLOR::RED }), UTF(' ', { COLOR::BLUE, COLOR::BLUE }) }, x + y, 1), false);
+
+    std::vector<sample> samples;
+    std::string typing;
+    size_t frames = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto nextSample = start;
+
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - start).count();
+
+        if (now >= nextSample) {
+            sample current{ elapsed, frames, INTERNAL::MEMORY_USAGE::residentBytes(), INTERNAL::MEMORY_USAGE::subsystems() };
+
+            if (samplesFile.is_open())
+                samplesFile << toJSON(current) << "\n";
+
+            samples.push_back(std::move(current));
+            nextSample += std::chrono::seconds(1);
+        }
+
+        if (elapsed >= seconds)
+            break;
+
+        frames++;
+
+        // The script, each part on its own period so that their combinations vary.
+        animated->flush(true);
+
+        typing += (char)('a' + frames % 26);
+        if (frames % 64 == 0)
+            typing += '\n';
+        if (typing.size() >= 2048)
+            typing.clear();
+        typed->setText(typing);
+
+        if (frames % 3 == 0) {
+            textField* item = new textField(width(20) | height(1));
+            item->setText("item " + std::to_string(frames));
+            list->addChild(item);
+        }
+        if (list->getChilds().size() > 16)
+            list->remove(list->getChilds().front());
+
+        panels[frames % panels.size()]->setBackgroundColor(frames % 2 ? COLOR::RED : COLOR::BLUE);
+
+        INTERNAL::renderCycle();
+    }
+
+    // Growth after the warm up.
+    size_t from = samples.size() / 5;
+    std::vector<std::pair<double, double>> resident;
+    for (size_t i = from; i < samples.size(); i++)
+        resident.emplace_back(samples[i].seconds, (double)samples[i].resident);
+
+    double residentGrowth = growthPerMinute(resident);
+
+    std::cout << "Frames: " << frames << " in " << seconds << "s\n";
+    std::cout << "Resident: " << (samples.empty() ? 0 : samples.back().resident / 1024) << " KB, growth " << residentGrowth << " KB/min\n";
+
+    if (!samples.empty()) {
+        for (size_t system = 0; system < samples.back().subsystems.size(); system++) {
+            std::vector<std::pair<double, double>> points;
+            for (size_t i = from; i < samples.size(); i++)
+                points.emplace_back(samples[i].seconds, (double)samples[i].subsystems[system].bytes);
+
+            std::cout << "  " << samples.back().subsystems[system].name << ": " << samples.back().subsystems[system].bytes / 1024
+                      << " KB, growth " << growthPerMinute(points) << " KB/min\n";
+        }
+    }
+
+    delete INTERNAL::currentContext->main;
+    INTERNAL::currentContext->main = nullptr;
+
+    if (residentGrowth > limit) {
+        std::cout << "Resident memory grew faster than " << limit << " KB/min\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,9 +1,9 @@
 #!/usr/bin/env bash
 
-# Wrapper for generating two Callgrind profiles via analytics/time.sh and
-# then comparing them using the C++ tool analytics/time2.cpp (built as 'time2').
-# Finally, open the resulting filtered.out in KCachegrind and optionally
-# clean up the inputs and ask about keeping the output.
+# Wrapper for generating two Callgrind profiles, of the standing and of the busy
+# timing wrappers, and then comparing them using the C++ tool analytics/time2.cpp
+# (built as 'time2'). Finally, open the resulting filtered.out in KCachegrind and
+# optionally clean up the inputs and ask about keeping the output.
 
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 ROOT_DIR="${SCRIPT_DIR}/../.."
@@ -13,20 +13,18 @@ source "${SCRIPT_DIR}/utils/common.sh"
 source "${SCRIPT_DIR}/utils/valgrind.sh"
 
 show_help() {
-  echo "Usage: $(basename "$0") <short_sec> <long_sec> <threshold>"
-  echo "  short_sec  - duration for first run (seconds)"
-  echo "  long_sec   - duration for second run (seconds)"
+  echo "Usage: $(basename "$0") <seconds> <threshold> [build_type]"
+  echo "  seconds    - duration of each profiled run (seconds)"
   echo "  threshold  - ratio threshold (e.g., 5.0)"
   echo "  build_type - {debug, profile, release}"
 }
 
-if [[ "$#" -lt 3 || "$1" =~ ^(-h|--help)$ ]]; then
+if [[ "$#" -lt 2 || "$1" =~ ^(-h|--help)$ ]]; then
   show_help
   exit 0
 fi
 
-SHORT_SEC="$1"; shift
-LONG_SEC="$1"; shift
+SECONDS_PER_RUN="$1"; shift
 THRESHOLD="${1:-"5.0"}"; shift
 BUILD_TYPE="${1:-debug}"; shift
 
@@ -37,20 +35,17 @@ meson_compile_target "${BUILD_TYPE}" time2
 meson_compile_target "${BUILD_TYPE}" timingStanding
 meson_compile_target "${BUILD_TYPE}" timingBusy
 
-# Generate two callgrind outputs using analytics/time.sh but keep files
-STAMP="cg$(date +%Y%m%d_%H%M%S)"
-RUN1="${STAMP}_standing_long.out" # we will run standing short/long and busy short/long, but for diffing we need two files
-RUN2="${STAMP}_busy_long.out"
+BUILD_DIR=$(get_build_dir_for_type $BUILD_TYPE)
 
-# Use time.sh to emit 4 profiles with a prefix; it will name them <prefix>_<label>.out
-"${SCRIPT_DIR}/time.sh" "${SHORT_SEC}" "${LONG_SEC}" --emit-callgrind-prefix "${STAMP}" || handle_error "time.sh failed"
+validate_valgrind_installation
 
-# time.sh created files: ${STAMP}_standing_short.out, ${STAMP}_standing_long.out, ${STAMP}_busy_short.out, ${STAMP}_busy_long.out
-# We'll compare long vs long to highlight steady-state growth differences between modes, as an example.
-RUN1="${STAMP}_standing_long.out"
-RUN2="${STAMP}_busy_long.out"
+# Profile both wrappers for the same time, the difference highlights what the busy workload grows.
+STAMP="cg$(date +%Y%m%d_%H%M%S)"
+RUN1="${STAMP}_standing.out"
+RUN2="${STAMP}_busy.out"
 
-BUILD_DIR=$(get_build_dir_for_type $BUILD_TYPE)
+run_callgrind_timed "${SECONDS_PER_RUN}" "${BUILD_DIR}/timingStanding" "full" "${RUN1}"
+run_callgrind_timed "${SECONDS_PER_RUN}" "${BUILD_DIR}/timingBusy" "full" "${RUN2}"
 
 # Run the comparison tool (from build dir)
 TOOL="${BUILD_DIR}/time2"
@@ -64,7 +59,7 @@ validate_tools "kcachegrind"
 open_profile_in_kcachegrind "filtered.out"
 
 # Clean up input profiles now that we're done
-rm -f "${STAMP}_standing_short.out" "${STAMP}_standing_long.out" "${STAMP}_busy_short.out" "${STAMP}_busy_long.out"
+rm -f "${RUN1}" "${RUN2}"
 
 # Ask to keep the filtered output
 if prompt_yes_no "Keep filtered.out?" "y"; then
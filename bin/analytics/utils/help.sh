@@ -206,7 +206,7 @@ EOF
 }
 
 ##
-# Generates help text for timing and performance measurement tools.
+# Generates help text for the memory growth analysis.
 #
 # Arguments:
 #   $1 - Script name
@@ -217,50 +217,46 @@ EOF
 generate_timing_help() {
     local script_name="$1"
     
-    generate_help_header "$script_name" "Performance timing and instruction count analysis" "\$0 [OPTIONS] time_short time_long"
+    generate_help_header "$script_name" "Memory growth analysis over a long scripted run" "\$0 [OPTIONS] seconds [limit]"
     
     cat << EOF
 Arguments:
-  time_short      Duration for short run (in seconds).
-  time_long       Duration for long run (in seconds).
+  seconds         How long the scripted workload runs (in seconds).
+  limit           The allowed resident memory growth in KB per minute
+                  (defaults to 256).
 
 Options:
   -t, --type=release
                   Specify the build type (debug or release, defaults to debug).
-  --emit-callgrind-prefix <prefix>
-                  Save generated Callgrind outputs with the given prefix instead
-                  of deleting them (files like <prefix>_standing_short.out).
+  --samples <file>
+                  Write one JSON line per second with the resident memory and
+                  the bytes held by each subsystem.
   -h, --help      Display this help message and exit.
 
 Description:
-  This script measures instruction execution over two different durations
-  and computes performance metrics:
+  This script builds and runs soakTest (analytics/soak.cpp), which renders a
+  headless scene with an animated canvas, a growing text field, a list with
+  items added and removed, and recoloured panels, for the given time.
 
-  - Slope1: Instructions per second during the short run.
-  - Slope2: Additional instructions per second during extended execution.
-  - Ratio:  Slope2 / Slope1, indicating performance change over time.
+  Every second it samples the resident set size and the bytes held by each
+  subsystem (elements, frame, events, names, classes, logger), then fits their
+  growth after the first fifth of the run and prints it in KB per minute.
 
   The analysis helps identify:
-  - Performance degradation over time
-  - Memory leaks (increasing instruction counts)
-  - Initialization overhead vs. steady-state performance
+  - Memory leaks, as steady resident memory growth
+  - Which subsystem the growth comes from
+  - Caches that never stop growing
 
 Method:
-  Uses Valgrind Callgrind to measure exact instruction counts during
-  timed execution runs. The executable is run twice with timeout control.
-  The build type controls whether wrappers are run from bin/build or
-  bin/build-release.
-
-Requirements:
-  - Valgrind with Callgrind support
-  - callgrind_annotate tool
-  - timeout command
-  - bc calculator
+  The resident set size is read from /proc/self/statm on Linux and from the
+  process memory counters on Windows. The subsystems are accounted through
+  INTERNAL::MEMORY_USAGE, the same figures the Inspect tool shows.
+  The exit code is 1 when the resident memory grew faster than the limit.
 
 Examples:
-  Basic run (debug build):      \$0 3 15
-  Run using release build:      \$0 -t release 3 15
-  Keep callgrind outputs:       \$0 3 15 --emit-callgrind-prefix runA
+  Basic run (debug build):      \$0 60
+  Run using release build:      \$0 -t release 300 128
+  Keep the samples:             \$0 120 --samples soak.jsonl
 
 EOF
     
@@ -35,7 +35,18 @@ void Compile_Headers(const std::string& destination, const std::string& source_r
         "src/core/utils/utils.h",
         "src/core/utils/logger.h",
         "src/core/utils/fileStreamer.h",
+        "src/core/utils/clock.h",
+        "src/core/utils/trace.h",
+        "src/core/utils/metrics.h",
+        "src/core/utils/profiler.h",
+        "src/core/utils/allocations.h",
+        "src/core/utils/memoryUsage.h",
+        "src/core/utils/eventLoop.h",
+        "src/core/utils/handlerPool.h",
+        "src/core/utils/frameServer.h",
         "src/core/utils/drm.h",
+        "src/core/utils/backend.h",
+        "src/core/utils/session.h",
         "src/elements/element.h",
         "src/elements/listView.h",
         "src/elements/textField.h",
@@ -120,6 +131,17 @@ std::vector<std::string> Get_Cpp_Files(){
         "src/core/utils/logger.cpp", 
         "src/core/utils/utils.cpp",
         "src/core/utils/fileStreamer.cpp",
+        "src/core/utils/eventLoop.cpp",
+        "src/core/utils/handlerPool.cpp",
+        "src/core/utils/frameServer.cpp",
+        "src/core/utils/backend.cpp",
+        "src/core/utils/clock.cpp",
+        "src/core/utils/session.cpp",
+        "src/core/utils/trace.cpp",
+        "src/core/utils/metrics.cpp",
+        "src/core/utils/profiler.cpp",
+        "src/core/utils/allocations.cpp",
+        "src/core/utils/memoryUsage.cpp",
         "src/core/utils/settings.cpp",
         "src/core/utils/drm.cpp",
         
@@ -150,6 +172,17 @@ std::vector<std::string> Get_Object_Files(){
         "logger.o",
         "utils.o", 
         "fileStreamer.o",
+        "eventLoop.o",
+        "handlerPool.o",
+        "frameServer.o",
+        "backend.o",
+        "clock.o",
+        "session.o",
+        "trace.o",
+        "metrics.o",
+        "profiler.o",
+        "allocations.o",
+        "memoryUsage.o",
         "settings.o",
         "drm.o",
         
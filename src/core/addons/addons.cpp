@@ -5,16 +5,15 @@
 
 #include "../renderer.h"
 #include "../utils/utils.h"
+#include "../utils/metrics.h"
+#include "../utils/profiler.h"
+#include "../utils/memoryUsage.h"
 
 #include <vector>
 
 namespace GGUI{
     std::vector<element*> addons;
 
-    namespace INTERNAL{
-        extern element* main;
-    }
-
     /**
      * @brief Initializes all addons and adds them to the main internal structure.
      *
@@ -32,38 +31,98 @@ namespace GGUI{
         }
     }
 
+    /**
+     * @brief Formats nanoseconds as milliseconds with two decimals.
+     */
+    static std::string toMilliseconds(uint64_t nanoseconds){
+        std::string result = std::to_string(nanoseconds / 1000000) + ".";
+        unsigned int hundredths = (nanoseconds / 10000) % 100;
+
+        return result + (hundredths < 10 ? "0" : "") + std::to_string(hundredths) + "ms";
+    }
+
     /**
      * @brief Generates a string containing various internal statistics.
-     * 
-     * This function collects and formats several internal statistics into a single
-     * string. The statistics include:
-     * - Encoded buffer size
-     * - Raw buffer size
-     * - Number of elements
-     * - Render delay in milliseconds
-     * - Event delay in milliseconds
-     * - Input delay in milliseconds
-     * - Resolution (width x height)
-     * - Task scheduler update speed in milliseconds
-     * 
+     * @details The frame, input and event figures are read from the INTERNAL::METRICS histograms since the start:
+     * - Presented and dropped frames
+     * - Frame and render time percentiles
+     * - Bytes written and cells changed per frame
+     * - Input latency and event round percentiles
+     * Followed by the number of elements, the resolution and the mouse position.
      * @return A formatted string containing the collected statistics.
      */
     std::string getStatsText(){
-        std::string optimized = std::to_string((float)(INTERNAL::BEFORE_ENCODE_BUFFER_SIZE - INTERNAL::AFTER_ENCODE_BUFFER_SIZE) / (float)INTERNAL::Max(INTERNAL::BEFORE_ENCODE_BUFFER_SIZE, 1) * 100.0f);
+        INTERNAL::METRICS::snapshot current = INTERNAL::METRICS::takeSnapshot();
 
-        // cut from the decimal point
-        optimized = optimized.substr(0, optimized.find('.'));
+        INTERNAL::METRICS::histogramSnapshot frame = current.getHistogram("frame.time");
+        INTERNAL::METRICS::histogramSnapshot render = current.getHistogram("frame.render");
+        INTERNAL::METRICS::histogramSnapshot bytes = current.getHistogram("frame.bytes");
+        INTERNAL::METRICS::histogramSnapshot cells = current.getHistogram("frame.cellsChanged");
+        INTERNAL::METRICS::histogramSnapshot latency = current.getHistogram("input.latency");
+        INTERNAL::METRICS::histogramSnapshot events = current.getHistogram("event.time");
 
-        return  "Optimized: " + optimized + "%\n" + 
+        return  "Frames: " + std::to_string(current.getCounter("frames.presented")) + " (" + std::to_string(current.getCounter("frames.identical")) + " identical)\n" +
+                "Dropped: " + std::to_string(current.getCounter("frames.dropped")) + "\n" +
+                "Frame p50/p99: " + toMilliseconds(frame.p50) + " / " + toMilliseconds(frame.p99) + "\n" +
+                "Render p50/p99: " + toMilliseconds(render.p50) + " / " + toMilliseconds(render.p99) + "\n" +
+                "Bytes p50/p99: " + std::to_string(bytes.p50) + " / " + std::to_string(bytes.p99) + "\n" +
+                "Cells p50/p99: " + std::to_string(cells.p50) + " / " + std::to_string(cells.p99) + "\n" +
+                "Input latency p50/p99: " + toMilliseconds(latency.p50) + " / " + toMilliseconds(latency.p99) + "\n" +
+                "Events p50/p99: " + toMilliseconds(events.p50) + " / " + toMilliseconds(events.p99) + "\n" +
                 "Elements: " + std::to_string(getRoot()->getAllNestedElements().size()) + "\n" +
-                "Render delay: " + std::to_string(INTERNAL::renderDelay) + "ms\n" +
-                "Event delay: " + std::to_string(INTERNAL::eventDelay) + "ms\n" + 
-                "Input delay: " + std::to_string(INTERNAL::Input_Delay) + "ms\n" + 
-                "Resolution: " + std::to_string(INTERNAL::maxWidth) + "x" + std::to_string(INTERNAL::maxHeight) + "\n" +
-                "Task scheduler: " + std::to_string(INTERNAL::CURRENT_UPDATE_SPEED) + "ms\n" + 
-                "Mouse: {" + std::to_string(INTERNAL::mouse.x) + ", " + std::to_string(INTERNAL::mouse.y) + "}";
+                "Resolution: " + std::to_string(INTERNAL::currentContext->maxWidth) + "x" + std::to_string(INTERNAL::currentContext->maxHeight) + "\n" +
+                "Mouse: {" + std::to_string(INTERNAL::currentContext->mouse.x) + ", " + std::to_string(INTERNAL::currentContext->mouse.y) + "}";
     }
     
+    // How many of the costliest elements the inspect tool lists.
+    static constexpr size_t profiledElementCount = 5;
+
+    /**
+     * @brief Lists the costliest elements by their own render and nesting time per frame, from INTERNAL::PROFILER.
+     * @return A formatted string with a heading and one line per element, or a hint on how to enable the profiling.
+     */
+    std::string getProfileText(){
+        if (!INTERNAL::PROFILER::isEnabled())
+            return "Element profiling is off, enable it with --elementProfile";
+
+        std::string result = "Costliest elements (self+nest us, cells, dirty):";
+
+        for (const INTERNAL::PROFILER::elementReport& report : INTERNAL::PROFILER::top(profiledElementCount)){
+            unsigned int dirtyPercentage = report.renders ? (unsigned int)(report.dirtyRenders * 100 / report.renders) : 0;
+
+            result += "\n" + report.name + ": " + std::to_string((unsigned long long)((report.selfNanoseconds + report.nestNanoseconds) / 1000)) +
+                      " us, " + std::to_string((unsigned long long)report.cellsTouched) + " cells, " + std::to_string(dirtyPercentage) + "%";
+        }
+
+        return result;
+    }
+
+    // How many of the heaviest elements the inspect tool lists.
+    static constexpr size_t heaviestElementCount = 3;
+
+    /**
+     * @brief Formats bytes as kilobytes.
+     */
+    static std::string toKilobytes(size_t bytes){
+        return std::to_string((unsigned long long)((bytes + 1023) / 1024)) + "KB";
+    }
+
+    /**
+     * @brief Lists the resident memory, the bytes held by each subsystem and the heaviest elements, from INTERNAL::MEMORY_USAGE.
+     * @return A formatted string with one line per subsystem, followed by one line per element.
+     */
+    std::string getMemoryText(){
+        std::string result = "Memory: " + toKilobytes(INTERNAL::MEMORY_USAGE::residentBytes()) + " resident";
+
+        for (const INTERNAL::MEMORY_USAGE::subsystemUsage& system : INTERNAL::MEMORY_USAGE::subsystems())
+            result += "\n" + system.name + ": " + toKilobytes(system.bytes) + " (" + std::to_string((unsigned long long)system.count) + ")";
+
+        for (const INTERNAL::MEMORY_USAGE::elementUsage& usage : INTERNAL::MEMORY_USAGE::top(heaviestElementCount))
+            result += "\n" + usage.name + ": " + toKilobytes(usage.total());
+
+        return result;
+    }
+
     /**
      * @brief Updates the stats panel with the number of elements, render time, and event time.
      * @param Event The event that triggered the update.
@@ -90,6 +149,20 @@ namespace GGUI{
             Stats->setText(new_stats);
         }
 
+        textField* Profile = (textField*)getRoot()->getElement("PROFILE");
+        std::string new_profile = getProfileText();
+
+        if (Profile && new_profile != Profile->getText()){
+            Profile->setText(new_profile);
+        }
+
+        textField* Memory = (textField*)getRoot()->getElement("MEMORY");
+        std::string new_memory = getMemoryText();
+
+        if (Memory && new_memory != Memory->getText()){
+            Memory->setText(new_memory);
+        }
+
         return true;
     }
 
@@ -132,12 +205,29 @@ namespace GGUI{
             node(new textField(
                 anchor(ANCHOR::LEFT) | 
                 width(1.0f) |
-                height(9) |
+                height(11) |
                 // Set the name of the text field to "STATS"
                 name("STATS")
                 // text(getStatsText().c_str())
             )) | 
 
+            // The costliest elements, when the element profiling is enabled.
+            node(new textField(
+                anchor(ANCHOR::LEFT) | 
+                width(1.0f) |
+                height((unsigned int)profiledElementCount + 1) |
+                name("PROFILE")
+            )) | 
+
+            // The resident memory, the subsystems and the heaviest elements.
+            node(new textField(
+                anchor(ANCHOR::LEFT) | 
+                width(1.0f) |
+                // The resident line, the six subsystems and the elements.
+                height((unsigned int)heaviestElementCount + 7) |
+                name("MEMORY")
+            )) | 
+
             // Hide the inspect tool by default
             display(false) | 
 
@@ -147,7 +237,7 @@ namespace GGUI{
                     GGUI::input* input = (GGUI::input*)e;
 
                     // If the shift key or control key is pressed and the 'i' key is pressed, toggle the inspect tool
-                    if (!INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT].state && !INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL].state && input->data != 'i' && input->data != 'I') 
+                    if (!INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT].state && !INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL].state && input->data != 'i' && input->data != 'I') 
                         return false;
 
                     // Toggle the inspect tool, so if it is hidden, show it and if it is shown, hide it
@@ -158,16 +248,14 @@ namespace GGUI{
                 }, true);
 
                 // Remember the inspect tool, so it will be updated every second
-                INTERNAL::remember([](std::vector<memory>& rememberable){
-                    rememberable.push_back(
-                        GGUI::memory(
-                            TIME::SECOND,
-                            updateStats,
-                            MEMORY_FLAGS::RETRIGGER,
-                            "Update Stats"
-                        )
-                    );
-                });
+                addMemory(
+                    GGUI::memory(
+                        TIME::SECOND,
+                        updateStats,
+                        MEMORY_FLAGS::RETRIGGER,
+                        "Update Stats"
+                    )
+                );
             })
         ));
     }
@@ -7,6 +7,14 @@
 #include "./utils/settings.h"
 #include "./utils/drm.h"
 #include "./utils/conveyorAllocator.h"
+#include "./utils/eventLoop.h"
+#include "./utils/handlerPool.h"
+#include "./utils/frameServer.h"
+#include "./utils/backend.h"
+#include "./utils/session.h"
+#include "./utils/trace.h"
+#include "./utils/metrics.h"
+#include "./utils/profiler.h"
 
 #include <string>
 #include <cassert>
@@ -17,6 +25,7 @@
 #include <csignal>
 #include <atomic>
 #include <iomanip>
+#include <algorithm>
 
 #if _WIN32
     #include <windows.h>
@@ -37,39 +46,35 @@
 
 namespace GGUI{
     namespace INTERNAL{
-        std::vector<UTF>* abstractFrameBuffer = nullptr;                // Terminal Cell buffer
-        std::string* frameBuffer;                                       // ANSI Escape sequenced string, this what gets drawn to console
+        // Every living context, so that a termination request reaches all of their rendering threads.
+        static atomic::guard<std::vector<context*>> contexts;
+
+        context::context(){
+            contexts([this](std::vector<context*>& self){
+                self.push_back(this);
+            });
+        }
+
+        context::~context(){
+            contexts([this](std::vector<context*>& self){
+                self.erase(std::find(self.begin(), self.end(), this));
+            });
+        }
+
+        context defaultContext;
+        thread_local context* currentContext = &defaultContext;
+        std::atomic<context*> terminalContext = &defaultContext;
+
         std::vector<std::function<void()>> userCleanupCallbacks;        // User defined functions to be called on cleanup
         
         // platformState platformState;
 
-        // For threading system
-        namespace atomic{
-            std::mutex mutex;
-            std::condition_variable condition;
-            
-            int LOCKED = 0;
-            status pauseRenderThread = status::NOT_INITIALIZED;
-        }
-
         std::vector<std::thread> Sub_Threads;
 
         std::vector<bufferCapture*> globalBufferCaptures;
 
-        unsigned int maxWidth = 0;
-        unsigned int maxHeight = 0;
-
-        atomic::guard<std::vector<memory>> remember;
-
-        std::vector<element*> eventHandlers;
-        std::vector<input*> inputs;
         std::chrono::system_clock::time_point Last_Input_Clear_Time;
 
-        std::unordered_map<std::string, element*> elementNames;
-
-        element* focusedOn = nullptr;
-        element* hoveredOn = nullptr;
-
         // When true, hover is being controlled by keyboard navigation (TAB/SHIFT+TAB).
         // Mouse-over logic in the event loop should not override the hovered element until the mouse moves.
         bool Hover_Locked_To_Keyboard = false;
@@ -77,13 +82,9 @@ namespace GGUI{
         // Whether STDIN is an interactive terminal (TTY). Used to decide input setup/teardown and whether to spawn the input thread.
         static bool STDIN_IS_TTY = false;
 
-        IVector3 mouse;
         //move 1 by 1, or element by element.
         bool mouseMovementEnabled = true;
 
-        std::unordered_map<std::string_view, buttonState> KEYBOARD_STATES;
-        std::unordered_map<std::string_view, buttonState> PREVIOUS_KEYBOARD_STATES;
-
         // Represents the update speed of each elapsed loop of passive events, which do NOT need user as an input.
         time_t CURRENT_UPDATE_SPEED = MAX_UPDATE_SPEED;
         inline float eventThreadLoad = 0.0f;  // Describes the load of animation and events from 0.0 to 1.0. Will reduce the event thread pause.
@@ -95,19 +96,26 @@ namespace GGUI{
         unsigned long long eventDelay;    // describes how long previous memory tasks took in ms
         unsigned long long Input_Delay;     // describes how long previous input tasks took in ms
 
-        inline atomic::guard<std::unordered_map<int, styling>> classes;
+        void* Stack_Start_Address = 0;
+        void* Heap_Start_Address = 0;
 
-        inline std::unordered_map<std::string, int> classNames;
+        sig_atomic_t requestTermination = false;
 
-        std::unordered_map<GGUI::canvas*, bool> multiFrameCanvas;
+        bool cooperativeMode = false;
 
-        void* Stack_Start_Address = 0;
-        void* Heap_Start_Address = 0;
+        thread_local std::vector<std::pair<const void*, std::function<void()>>>* detachedRegistrations = nullptr;
 
-        element* main = nullptr;
+        thread_local batchState* currentBatch = nullptr;
 
-        atomic::guard<carry> Carry_Flags; 
-        sig_atomic_t requestTermination = false;
+        thread_local inputCause activeCause;
+
+        void stampRawInput(){
+            if (currentContext->rawInput.id)
+                return;
+
+            currentContext->rawInput.id = ++currentContext->lastCauseId;
+            currentContext->rawInput.arrival = std::chrono::high_resolution_clock::now();
+        }
 
         /**
          * @brief Temporary function to return the current date and time in a string.
@@ -136,6 +144,50 @@ namespace GGUI{
 
         extern void Read_Start_Addresses();
 
+        /**
+         * @brief Feeds raw input bytes into the currently open bracketed paste.
+         * @details Appends into pasteBuffer until BRACKETED_PASTE_END is found, then pushes the whole text as one constants::PASTE input.
+         * @param data Raw bytes which belong to the paste, possibly followed by normal input after the end marker.
+         * @param size Amount of bytes in data.
+         * @return Amount of bytes consumed from data, including the end marker.
+         */
+        size_t consumeBracketedPaste(const unsigned char* data, size_t size){
+            const compactString& endMarker = constants::ANSI::BRACKETED_PASTE_END;
+
+            size_t previousSize = currentContext->pasteBuffer.size();
+            currentContext->pasteBuffer.append((const char*)data, size);
+
+            // The end marker may have been split between the previous read and this one, so step back just enough to catch it.
+            size_t searchStart = previousSize >= endMarker.size ? previousSize - (endMarker.size - 1) : 0;
+            size_t endIndex = currentContext->pasteBuffer.find(endMarker.text, searchStart, endMarker.size);
+
+            if (endIndex == std::string::npos)
+                return size;    // The whole read belongs to the paste, wait for more.
+
+            size_t consumed = endIndex + endMarker.size - previousSize;
+            currentContext->pasteBuffer.resize(endIndex);
+
+            // Terminals send pasted line breaks as carriage returns, so fold "\r\n" and lone '\r' into '\n' in-place.
+            size_t writeIndex = 0;
+            for (size_t readIndex = 0; readIndex < currentContext->pasteBuffer.size(); readIndex++){
+                if (currentContext->pasteBuffer[readIndex] == '\r'){
+                    if (readIndex + 1 < currentContext->pasteBuffer.size() && currentContext->pasteBuffer[readIndex + 1] == '\n')
+                        continue;
+                    currentContext->pasteBuffer[writeIndex++] = '\n';
+                }
+                else
+                    currentContext->pasteBuffer[writeIndex++] = currentContext->pasteBuffer[readIndex];
+            }
+            currentContext->pasteBuffer.resize(writeIndex);
+
+            currentContext->inputs.push_back(takeInput(std::move(currentContext->pasteBuffer), constants::PASTE));
+
+            currentContext->pasteBuffer.clear(); // Moved-from string is valid but unspecified.
+            currentContext->pasteInProgress = false;
+
+            return consumed;
+        }
+
         #if _WIN32
 
         HANDLE GLOBAL_STD_OUTPUT_HANDLE;
@@ -147,6 +199,7 @@ namespace GGUI{
         CONSOLE_SCREEN_BUFFER_INFO Get_Console_Info();
 
         // This is here out from the Query_Inputs, so that we can differentiate querying and translation of said input.
+        // Only the terminal context reads the console, so unlike the raw bytes of the contexts this stays process wide.
         const unsigned int Raw_Input_Capacity = UINT8_MAX * 10;
         INPUT_RECORD Raw_Input[Raw_Input_Capacity];
         int Raw_Input_Size = 0;
@@ -305,39 +358,48 @@ namespace GGUI{
          * variable but is not used elsewhere in the function.
          */
         void renderFrame(){
+            GGUI_TRACE_SCOPE("write");
+
             // The number of bytes written to the console, not used anywhere else.
             unsigned long long tmp = 0;
             // Move the cursor to the top left corner of the screen.
             SetConsoleCursorPosition(GLOBAL_STD_OUTPUT_HANDLE, {0, 0});
             // Write the Frame_Buffer data to the console.
-            WriteFile(GLOBAL_STD_OUTPUT_HANDLE, frameBuffer->data(), frameBuffer->size(), reinterpret_cast<LPDWORD>(&tmp), NULL);
+            WriteFile(GLOBAL_STD_OUTPUT_HANDLE, currentContext->frameBuffer->data(), currentContext->frameBuffer->size(), reinterpret_cast<LPDWORD>(&tmp), NULL);
         }
 
         /**
-         * @brief Updates the maximum width and height of the console window.
+         * @brief Gives the size of the console window.
          * 
-         * This function retrieves the current console screen buffer information and updates
-         * the maximum width and height based on the console window dimensions. If the console
-         * information is not retrieved correctly, an error message is reported. Additionally,
-         * if the main window is active, its dimensions are set to the updated maximum width
-         * and height.
+         * This function retrieves the current console screen buffer information. If the console
+         * information is not retrieved correctly, an error message is reported.
+         *
+         * @param width Where the width is stored.
+         * @param height Where the height is stored.
+         * @return Always true, since a failure leaves the size as zero like before.
          */
-        void updateMaxWidthAndHeight(){
+        bool getTerminalSize(unsigned int& width, unsigned int& height){
             // Get the console information.
             CONSOLE_SCREEN_BUFFER_INFO info = Get_Console_Info();
 
-            // Update the maximum width and height.
-            maxWidth = info.dwSize.X;
-            maxHeight = info.dwSize.Y;
+            width = info.dwSize.X;
+            height = info.dwSize.Y;
 
             // Check if we got the console information correctly.
-            if (maxWidth == 0 || maxHeight == 0){
-                reportStack("Failed to get console info!");
+            if (width == 0 || height == 0){
+                // Not reportStack(), since it calls this function while maxWidth is still zero.
+                GGUI::report("Failed to get console info!");
             }
 
-            // Check that the main window is not active and if so, set its dimensions.
-            if (main)
-                main->setDimensions(maxWidth, maxHeight);
+            return true;
+        }
+
+        /**
+         * @brief Console input records cannot be made from raw bytes, so nothing is taken.
+         * @return Always zero.
+         */
+        size_t setRawInput([[maybe_unused]] const char* data, [[maybe_unused]] size_t size){
+            return 0;
         }
 
         /**
@@ -362,7 +424,7 @@ namespace GGUI{
                 // TODO: Add more keybinds to the table
             */
 
-            if (KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL].state && KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT].state){
+            if (currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL].state && currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT].state){
                 if (keybind_value == VK_TAB){
                     return 'i';
                 }
@@ -393,6 +455,9 @@ namespace GGUI{
                 Raw_Input_Capacity,
                 (LPDWORD)&Raw_Input_Size
             );
+
+            if (Raw_Input_Size > 0)
+                stampRawInput();
         }
 
         /**
@@ -411,11 +476,11 @@ namespace GGUI{
          * @note This function assumes that the raw input buffer will be fully translated by the end of its execution.
          * 
          * @param None
-         * @return void
+         * @return Always false, since console input records are translated as a whole.
          */
-        void Translate_Inputs(){
+        bool Translate_Inputs(){
             // Clean the keyboard states.
-            INTERNAL::PREVIOUS_KEYBOARD_STATES = INTERNAL::KEYBOARD_STATES;
+            INTERNAL::currentContext->PREVIOUS_KEYBOARD_STATES = INTERNAL::currentContext->KEYBOARD_STATES;
 
             for (int i = 0; i < Raw_Input_Size; i++){
                 if (Raw_Input[i].EventType == KEY_EVENT){
@@ -423,54 +488,54 @@ namespace GGUI{
                     bool Pressed = Raw_Input[i].Event.KeyEvent.bKeyDown;
 
                     if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_UP){
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::UP));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::UP] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(0, GGUI::constants::UP));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::UP] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_DOWN){
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::DOWN));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::DOWN] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(0, GGUI::constants::DOWN));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::DOWN] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_LEFT){
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::LEFT));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::LEFT] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(0, GGUI::constants::LEFT));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::LEFT] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_RIGHT){
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::RIGHT));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::RIGHT] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(0, GGUI::constants::RIGHT));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::RIGHT] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_RETURN){
-                        INTERNAL::inputs.push_back(new GGUI::input('\n', GGUI::constants::ENTER));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput('\n', GGUI::constants::ENTER));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_SHIFT){
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::SHIFT));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::SHIFT));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_CONTROL){
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::CONTROL));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::CONTROL));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_BACK){
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::BACKSPACE));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::BACKSPACE));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(Pressed);
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_ESCAPE){
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::ESCAPE));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::ESCAPE));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC] = INTERNAL::buttonState(Pressed);
                         handleEscape();
                     }
                     else if (Raw_Input[i].Event.KeyEvent.wVirtualKeyCode == VK_TAB){
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::TAB));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = INTERNAL::buttonState(Pressed);
+                        INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::TAB));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = INTERNAL::buttonState(Pressed);
                         handleTabulator();
                     }
                     else if (Raw_Input[i].Event.KeyEvent.uChar.AsciiChar != 0 && Pressed){
                         char Result = Reverse_Engineer_Keybinds(Raw_Input[i].Event.KeyEvent.uChar.AsciiChar);
-                        INTERNAL::inputs.push_back(new GGUI::input(Result, GGUI::constants::KEY_PRESS));
+                        INTERNAL::currentContext->inputs.push_back(takeInput(Result, GGUI::constants::KEY_PRESS));
                     }
                 }
                 else if (Raw_Input[i].EventType == WINDOW_BUFFER_SIZE_EVENT){
-                    INTERNAL::Carry_Flags([](GGUI::INTERNAL::carry& current_carry){
+                    INTERNAL::currentContext->Carry_Flags([](GGUI::INTERNAL::carry& current_carry){
                         current_carry.resize = true;    // Tell the render thread that an resize is needed to be performed.
                     });
                 }
@@ -479,28 +544,28 @@ namespace GGUI{
                         // Get mouse coordinates
                         COORD mousePos = Raw_Input[i].Event.MouseEvent.dwMousePosition;
                         // Handle cursor movement
-                        INTERNAL::mouse.x = mousePos.X;
-                        INTERNAL::mouse.y = mousePos.Y;
+                        INTERNAL::currentContext->mouse.x = mousePos.X;
+                        INTERNAL::currentContext->mouse.y = mousePos.Y;
                     }
                     // Handle mouse clicks
                     if ((Raw_Input[i].Event.MouseEvent.dwButtonState & FROM_LEFT_1ST_BUTTON_PRESSED) != 0) {
                         //PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].State = KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].State;
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state = true;
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = std::chrono::high_resolution_clock::now();
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state = true;
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = CLOCK::now();
                     }
                     else if ((Raw_Input[i].Event.MouseEvent.dwButtonState & FROM_LEFT_1ST_BUTTON_PRESSED) == 0) {
                         //PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].State = KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].State;
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state = false;
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state = false;
                     }
 
                     if ((Raw_Input[i].Event.MouseEvent.dwButtonState & RIGHTMOST_BUTTON_PRESSED) != 0) {
                         //PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].State = KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].State;
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state = true;
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = std::chrono::high_resolution_clock::now();
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state = true;
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = CLOCK::now();
                     }
                     else if ((Raw_Input[i].Event.MouseEvent.dwButtonState & RIGHTMOST_BUTTON_PRESSED) == 0) {
                         //PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].State = KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].State;
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state = false;
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state = false;
                     }
                 
                     // mouse scroll up
@@ -509,16 +574,16 @@ namespace GGUI{
                         int Scroll_Direction = GET_WHEEL_DELTA_WPARAM(Raw_Input[i].Event.MouseEvent.dwButtonState);
 
                         if (Scroll_Direction > 0){
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].state = true;
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].state = false;
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].state = true;
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].state = false;
 
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].captureTime = std::chrono::high_resolution_clock::now();
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].captureTime = CLOCK::now();
                         }
                         else if (Scroll_Direction < 0){
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].state = true;
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].state = false;
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].state = true;
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].state = false;
 
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].captureTime = std::chrono::high_resolution_clock::now();
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].captureTime = CLOCK::now();
                         }
                     }
                 }
@@ -527,6 +592,8 @@ namespace GGUI{
             // We can assume that the Raw_Input buffer will be fully translated by this point, if not, then something is wrong!!!
             // We can now also restart the Raw_Input_Size.
             Raw_Input_Size = 0;
+
+            return false;
         }
 
         /**
@@ -708,10 +775,17 @@ namespace GGUI{
         int Previous_Flags = 0;
         struct termios Previous_Raw;
 
-        // Stored globally, so that translation and inquiry can be separate proccess.
-        const unsigned int Raw_Input_Capacity = UINT8_MAX * 2;
-        unsigned char Raw_Input[Raw_Input_Capacity];
-        ssize_t Raw_Input_Size = 0;
+        /**
+         * @brief Puts the carried beginning of a paste start marker in front of the newly read bytes.
+         * @param readSize Amount of bytes read into Raw_Input right after the room left for the carry.
+         */
+        static void prependPasteStartCarry(size_t readSize){
+            context& self = *currentContext;
+
+            std::memcpy(self.Raw_Input, self.pasteStartCarry.data(), self.pasteStartCarry.size());
+            self.Raw_Input_Size = self.pasteStartCarry.size() + readSize;
+            self.pasteStartCarry.clear();
+        }
 
         /**
          * @brief Checks whether STDIN is connected to an interactive terminal (TTY).
@@ -738,7 +812,7 @@ namespace GGUI{
             // Unique_ptr map cleanup.
             fileStreamerHandles.clear();
 
-            if (!SETTINGS::enableDRM) {
+            if (currentContext->output && currentContext->output->ownsTerminal()) {
                 deinitTerminalANSICodes();
 
                 if (STDIN_IS_TTY && platformState.rawModeEnabled) {
@@ -763,42 +837,67 @@ namespace GGUI{
          *          If the write operation fails or writes fewer bytes than expected, an error message is reported.
          */
         void renderFrame() {
+            GGUI_TRACE_SCOPE("write");
+
             // Write cursor-home, then the frame buffer. Avoid stdio printf/fflush.
             const char* cursorReset = GGUI::constants::ANSI::SET_CURSOR_TO_START.text;
             size_t cursorResetLength = GGUI::constants::ANSI::SET_CURSOR_TO_START.size;
 
             iovec vec[2] = {
                 { (void*)cursorReset,           cursorResetLength },
-                { (void*)frameBuffer->data(),  frameBuffer->size() }
+                { (void*)currentContext->frameBuffer->data(),  currentContext->frameBuffer->size() }
             };
 
             ssize_t wrote = writev(STDOUT_FILENO, vec, 2);
-            if (wrote != (ssize_t)cursorResetLength + (ssize_t)frameBuffer->size()) {
+            if (wrote != (ssize_t)cursorResetLength + (ssize_t)currentContext->frameBuffer->size()) {
                 LOGGER::log("Failed to write to STDOUT (home): " + std::to_string((int)wrote));
             }
         }
 
         /**
-         * @brief Updates the maximum width and height of the terminal.
-         * @details This function updates the maxWidth and Max_Height variables by calling ioctl to get the current
-         *          width and height of the terminal. If the call fails, a report message is sent.
+         * @brief Gives the size of the terminal.
+         * @details Calls ioctl to get the current width and height of the terminal. If the call fails, a report message is sent.
          * @note The height is reduced by 1 to account for the one line of console space taken by the GGUI status bar.
+         * @param width Where the width is stored.
+         * @param height Where the height is stored.
+         * @return False if the size could not be queried.
          */
-        void updateMaxWidthAndHeight(){
-            if (!SETTINGS::enableDRM){  // window size comes from DRM is DRM is enabled.
-                struct winsize w;
-                if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == -1){
-                    INTERNAL::reportStack("Failed to get console info!");
-                    return;
-                }
+        bool getTerminalSize(unsigned int& width, unsigned int& height){
+            struct winsize w;
+            if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &w) == -1){
+                // Not reportStack(), since it calls this function while maxWidth is still zero.
+                GGUI::report("Failed to get console info!");
+                return false;
+            }
 
-                maxWidth = w.ws_col;
-                maxHeight = w.ws_row - 1;
+            width = w.ws_col;
+            height = w.ws_row - 1;
+
+            return true;
+        }
+
+        /**
+         * @brief Replaces the raw input with the given bytes, as if queryInputs() had read them.
+         * @param data The bytes to translate next.
+         * @param size How many bytes there are.
+         * @return How many of the bytes fit into the raw input, the rest has to be given after they are translated.
+         */
+        size_t setRawInput(const char* data, size_t size){
+            context& self = *currentContext;
 
-                // Convenience sake :)
-                if (main)
-                    main->setDimensions(maxWidth, maxHeight);
+            size_t carried = self.pasteStartCarry.size();
+            size_t taken = Min(size, (size_t)context::Raw_Input_Capacity - carried);
+
+            if (taken == 0){
+                self.Raw_Input_Size = 0;
+                return 0;
             }
+
+            std::memcpy(self.Raw_Input + carried, data, taken);
+            prependPasteStartCarry(taken);
+            stampRawInput();
+
+            return taken;
         }
 
         /**
@@ -814,7 +913,7 @@ namespace GGUI{
             // Setup the function handler with a lambda
             Handler.sa_handler = []([[maybe_unused]] int signum){
                 // When the signal is received, update the carry flags to indicate that a resize is needed
-                Carry_Flags([](carry& current_carry){
+                terminalContext.load()->Carry_Flags([](carry& current_carry){
                     current_carry.resize = true;    // Tell the render thread that an resize is needed to be performed.
                 });
             };
@@ -862,11 +961,13 @@ namespace GGUI{
         }
 
         /**
-         * @brief Waits for user input and stores it in the Raw_Input array.
+         * @brief Waits for user input and stores it in the Raw_Input array of the context.
          * @details This function waits for user input and stores it in the Raw_Input array. It is called from the event loop.
          *          It is also the function that is called as soon as possible and gets stuck awaiting for the user input.
          */
         void queryInputs(){
+            context& self = *currentContext;
+
             // If stdin isn't a TTY (e.g., piped/timeout), read() may return 0 (EOF) repeatedly; avoid spinning.
             if (!STDIN_IS_TTY) {
                 // Use poll to wait briefly for readability; if not readable, sleep a bit to avoid busy-loop.
@@ -883,15 +984,25 @@ namespace GGUI{
                     TIME::SECOND    // Max allowed wait time, could be replaced with -1, to wait as long as needed.
                 ) <= 0) {
                     // No data; avoid spinning
-                    Raw_Input_Size = 0;
+                    self.Raw_Input_Size = 0;
                     return;
                 }
             }
 
-            Raw_Input_Size = read(STDIN_FILENO, Raw_Input, Raw_Input_Capacity);
-            if (Raw_Input_Size <= 0) {
+            size_t carried = self.pasteStartCarry.size();
+            ssize_t readSize = read(STDIN_FILENO, self.Raw_Input + carried, context::Raw_Input_Capacity - carried);
+
+            if (readSize <= 0) {
                 // EOF or error; normalize to 0 to signal no input
-                Raw_Input_Size = 0;
+                self.Raw_Input_Size = 0;
+            }
+            else {
+                stampRawInput();
+
+                if (SESSION::isRecording())
+                    SESSION::recordInput((const char*)self.Raw_Input + carried, readSize);
+
+                prependPasteStartCarry(readSize);
             }
         }
 
@@ -908,30 +1019,45 @@ namespace GGUI{
          * It checks if the event is a key event, and if so, it checks if the key is a special key (up, down, left, right, enter, shift, control, backspace, escape, tab) and if so, it creates an Input object with the corresponding constants:: value. 
          * If the key is not a special key, it creates an Input object with the key's ASCII value and constants::KEY_PRESS. 
          * If the event is not a key event, it checks if the event is a mouse event and if so, it checks if the mouse event is a movement, click or scroll event and if so, it creates an Input object with the corresponding constants:: value. 
+         * Consecutive mouse movements only update the mouse position, so a run of them collapses into the latest one.
+         * Mouse button transitions and scrolls end the batch, since the later stages only see one state per batch; the remaining bytes are moved to the front of Raw_Input.
          * Finally, it resets the Raw_Input_Size to 0.
+         * @return True if a part of Raw_Input was left for the next batch, in which case this should be called again before reading more input.
          */
-        void Translate_Inputs(){
+        bool Translate_Inputs(){
             constexpr char START_OF_CTRL = 1;
             constexpr char END_OF_CTRL = 26;
+
+            // The raw input of this context.
+            unsigned char* Raw_Input = currentContext->Raw_Input;
+            ssize_t& Raw_Input_Size = currentContext->Raw_Input_Size;
             // Clean the keyboard states.
-            PREVIOUS_KEYBOARD_STATES = KEYBOARD_STATES;
+            currentContext->PREVIOUS_KEYBOARD_STATES = currentContext->KEYBOARD_STATES;
 
             // Unlike in Windows we wont be getting an indication per Key information, whether it was pressed in or out.
-            KEYBOARD_STATES.clear();
+            // The states are released in place instead of cleared, so that the keys looked up on every round are not re-allocated.
+            for (auto& [key, current] : currentContext->KEYBOARD_STATES)
+                current = buttonState();
 
             if (Raw_Input_Size <= 0) {
-                return; // nothing to translate
+                return false; // nothing to translate
             }
 
             auto hasIndicies = [&](ssize_t index, ssize_t offset) -> bool {
                 return (index + offset) < Raw_Input_Size;
             };
 
-            for (ssize_t i = 0; i < Raw_Input_Size; i++) {                // Check if SHIFT has been modifying the keys
+            ssize_t start = 0;
+
+            // A paste which did not end within the previous read, continues from the start of this one.
+            if (currentContext->pasteInProgress)
+                start = consumeBracketedPaste(Raw_Input, Raw_Input_Size);
+
+            for (ssize_t i = start; i < Raw_Input_Size; i++) {                // Check if SHIFT has been modifying the keys
                 if ((Raw_Input[i] >= 'A' && Raw_Input[i] <= 'Z') || (Raw_Input[i] >= '!' && Raw_Input[i] <= '/')) {
                     // SHIFT key is pressed
-                    inputs.push_back(new GGUI::input(' ', constants::SHIFT));
-                    KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
+                    currentContext->inputs.push_back(takeInput(' ', constants::SHIFT));
+                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
                 }
 
                 // ACC ASCII character handlers.
@@ -939,34 +1065,34 @@ namespace GGUI{
                     // This is a CTRL key                    // The CTRL domain contains multiple useful keys to check for
                     if (Raw_Input[i] == constants::ANSI::BACKSPACE) {
                         // This is a backspace key
-                        inputs.push_back(new GGUI::input(' ', constants::BACKSPACE));
-                        KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = buttonState(true);
+                        currentContext->inputs.push_back(takeInput(' ', constants::BACKSPACE));
+                        currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = buttonState(true);
                     }
                     else if (Raw_Input[i] == constants::ANSI::HORIZONTAL_TAB) {
                         // This is a tab key
-                        inputs.push_back(new GGUI::input(' ', constants::TAB));
-                        KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = buttonState(true);
+                        currentContext->inputs.push_back(takeInput(' ', constants::TAB));
+                        currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = buttonState(true);
                         handleTabulator();
                     }
                     else if (Raw_Input[i] == constants::ANSI::LINE_FEED) {
                         // This is an enter key
-                        inputs.push_back(new GGUI::input('\n', constants::ENTER));
-                        KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER] = buttonState(true);
+                        currentContext->inputs.push_back(takeInput('\n', constants::ENTER));
+                        currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER] = buttonState(true);
                     }
                     else{
                         // Since we cannot discern between ACC and ctrl+characters, we'll just yolo it for now and assume it works.
                         Raw_Input[i] += 'A'-1;  // Since A is encoded as 1, we need to subtract 1 to get the correct ASCII value.
                         // This is an ctrl key
-                        inputs.push_back(new GGUI::input(' ', constants::CONTROL));
-                        KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
+                        currentContext->inputs.push_back(takeInput(' ', constants::CONTROL));
+                        currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
                     }
                 }                
                 if (Raw_Input[i] == constants::ANSI::CSI_CODE[0]) {
                     // check if there are stuff after this escape code
                     if (!hasIndicies(i, 1)) {
                         // Clearly the escape key was invoked
-                        inputs.push_back(new GGUI::input(' ', constants::ESCAPE));
-                        KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC] = buttonState(true);
+                        currentContext->inputs.push_back(takeInput(' ', constants::ESCAPE));
+                        currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC] = buttonState(true);
                         handleEscape();
                         continue;
                     }
@@ -978,10 +1104,28 @@ namespace GGUI{
                     if (Raw_Input[i] == constants::ANSI::CSI_CODE[1]) {
                         // Escape sequence codes:
 
+                        // The start marker of a paste may be split between two reads like the end marker, so its beginning waits for the next read.
+                        const compactString& startMarker = constants::ANSI::BRACKETED_PASTE_START;
+                        ssize_t pasteRemaining = Raw_Input_Size - (i - 1);
+
+                        if (pasteRemaining < (ssize_t)startMarker.size && std::memcmp(Raw_Input + i - 1, startMarker.text, pasteRemaining) == 0){
+                            currentContext->pasteStartCarry.assign((const char*)Raw_Input + i - 1, pasteRemaining);
+                            break;
+                        }
+
                         if (!hasIndicies(i, 1)) {
                             break; // incomplete escape sequence at end of buffer
                         }
 
+                        // Bracketed paste: [200~ ... ESC[201~, everything in between is text, not key presses.
+                        if (hasIndicies(i, 4) && Raw_Input[i+1] == '2' && Raw_Input[i+2] == '0' && Raw_Input[i+3] == '0' && Raw_Input[i+4] == '~'){
+                            i += 4;
+
+                            currentContext->pasteInProgress = true;
+                            i += consumeBracketedPaste(Raw_Input + i + 1, Raw_Input_Size - (i + 1));
+                            continue;
+                        }
+
                         // Check for modifiers with base [1;
                         if (hasIndicies(i, 2) && Raw_Input[i+1] == '1' && Raw_Input[i+2] == ';'){
                             i += 2;
@@ -994,23 +1138,23 @@ namespace GGUI{
 
                             switch (Modifier) {
                                 case (unsigned char)VTTermModifiers::SHIFT:
-                                    inputs.push_back(new GGUI::input(' ', constants::SHIFT));
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
+                                    currentContext->inputs.push_back(takeInput(' ', constants::SHIFT));
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
                                     break;
 
                                 case (unsigned char)VTTermModifiers::ALT:
-                                    inputs.push_back(new GGUI::input(' ', constants::ALT));
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = buttonState(true);
+                                    currentContext->inputs.push_back(takeInput(' ', constants::ALT));
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = buttonState(true);
                                     break;
 
                                 case (unsigned char)VTTermModifiers::CONTROL:
-                                    inputs.push_back(new GGUI::input(' ', constants::CONTROL));
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
+                                    currentContext->inputs.push_back(takeInput(' ', constants::CONTROL));
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
                                     break;
 
                                 case (unsigned char)VTTermModifiers::SUPER:
-                                    inputs.push_back(new GGUI::input(' ', constants::SUPER));
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::SUPER] = buttonState(true);
+                                    currentContext->inputs.push_back(takeInput(' ', constants::SUPER));
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SUPER] = buttonState(true);
                                     break;
 
                                 default:
@@ -1031,23 +1175,23 @@ namespace GGUI{
                         }
 
                         if (Raw_Input[i + 1] == 'A') {
-                            inputs.push_back(new GGUI::input(0, constants::UP));
-                            KEYBOARD_STATES[KEYBOARD_BUTTONS::UP] = buttonState(true);
+                            currentContext->inputs.push_back(takeInput(0, constants::UP));
+                            currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::UP] = buttonState(true);
                             i++;
                         }
                         else if (Raw_Input[i + 1] == 'B') {
-                            inputs.push_back(new GGUI::input(0, constants::DOWN));
-                            KEYBOARD_STATES[KEYBOARD_BUTTONS::DOWN] = buttonState(true);
+                            currentContext->inputs.push_back(takeInput(0, constants::DOWN));
+                            currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::DOWN] = buttonState(true);
                             i++;
                         }
                         else if (Raw_Input[i + 1] == 'C') {
-                            inputs.push_back(new GGUI::input(0, constants::RIGHT));
-                            KEYBOARD_STATES[KEYBOARD_BUTTONS::RIGHT] = buttonState(true);
+                            currentContext->inputs.push_back(takeInput(0, constants::RIGHT));
+                            currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::RIGHT] = buttonState(true);
                             i++;
                         }
                         else if (Raw_Input[i + 1] == 'D') {
-                            inputs.push_back(new GGUI::input(0, constants::LEFT));
-                            KEYBOARD_STATES[KEYBOARD_BUTTONS::LEFT] = buttonState(true);
+                            currentContext->inputs.push_back(takeInput(0, constants::LEFT));
+                            currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::LEFT] = buttonState(true);
                             i++;
                         }
                         else if (Raw_Input[i + 1] == 'M') {  // Decode X10 Mouse handling
@@ -1059,24 +1203,24 @@ namespace GGUI{
 
                             // Check if the bit 2'rd has been set, is so then the SHIFT has been pressed
                             if (Bit_Mask & 4) {
-                                inputs.push_back(new GGUI::input(' ', constants::SHIFT));
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
+                                currentContext->inputs.push_back(takeInput(' ', constants::SHIFT));
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
                                 // also remove the bit from the bitmask
                                 Bit_Mask &= ~4;
                             }
 
                             // Check if the 3'th bit has been set, is so then the SUPER has been pressed
                             if (Bit_Mask & 8) {
-                                inputs.push_back(new GGUI::input(' ', constants::SUPER));
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::SUPER] = buttonState(true);
+                                currentContext->inputs.push_back(takeInput(' ', constants::SUPER));
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SUPER] = buttonState(true);
                                 // also remove the bit from the bitmask
                                 Bit_Mask &= ~8;
                             }
 
                             // Check if the 4'th bit has been set, is so then the CTRL has been pressed
                             if (Bit_Mask & 16) {
-                                inputs.push_back(new GGUI::input(' ', constants::CONTROL));
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
+                                currentContext->inputs.push_back(takeInput(' ', constants::CONTROL));
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
                                 // also remove the bit from the bitmask
                                 Bit_Mask &= ~16;
                             }
@@ -1090,8 +1234,8 @@ namespace GGUI{
                                 unsigned char Y = Raw_Input[i + 4];
 
                                 // XTERM will normally shift its X and Y coordinates by 32, so that it skips all the control characters in ASCII.
-                                mouse.x = Max(X - 32 - 1, 0);   // The additional -1 is so that the mouse cursor top left point works as the actual focus point of the mouse.
-                                mouse.y = Max(Y - 32 - 1, 0);
+                                currentContext->mouse.x = Max(X - 32 - 1, 0); // The additional -1 is so that the mouse cursor top left point works as the actual focus point of the mouse.
+                                currentContext->mouse.y = Max(Y - 32 - 1, 0);
 
                                 // Mouse moved; release keyboard hover lock.
                                 Hover_Locked_To_Keyboard = false;
@@ -1103,32 +1247,32 @@ namespace GGUI{
                             Bit_Mask &= ~(128);
 
                             if (Bit_Mask == 0) {
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT] = buttonState(true);
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = std::chrono::high_resolution_clock::now();
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT] = buttonState(true);
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = CLOCK::now();
                             }
                             else if (Bit_Mask == 1) {
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = buttonState(true);
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime = std::chrono::high_resolution_clock::now();
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = buttonState(true);
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime = CLOCK::now();
                             }
                             else if (Bit_Mask == 2) {
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT] = buttonState(true);
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = std::chrono::high_resolution_clock::now();
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT] = buttonState(true);
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = CLOCK::now();
                             }
                             else if (Bit_Mask == 3) {
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state = false;
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state = false;
-                                KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state = false;
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state = false;
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state = false;
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state = false;
                             }
 
                             i += 4;
                         }
                         else if (Raw_Input[i + 1] == 'Z') {
                             // SHIFT + TAB => Z
-                            inputs.push_back(new GGUI::input(' ', constants::SHIFT));
-                            inputs.push_back(new GGUI::input(' ', constants::TAB));
+                            currentContext->inputs.push_back(takeInput(' ', constants::SHIFT));
+                            currentContext->inputs.push_back(takeInput(' ', constants::TAB));
 
-                            KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
-                            KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = buttonState(true);
+                            currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
+                            currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = buttonState(true);
 
                             handleTabulator();
 
@@ -1162,56 +1306,87 @@ namespace GGUI{
                             // advance i to the end of this sequence
                             i = k;
 
+                            bool motion = (mask & 32) != 0;     // Movement report, sent for every cell the mouse crosses.
+                            bool wheel  = (mask & 64) != 0;     // Scroll wheel, where button 0 is up and 1 is down.
+
+                            // Button ID: low two bits
+                            int btn = mask & 0x03;
+
                             // Map reported coords directly
-                            INTERNAL::mouse.x = mx;
-                            INTERNAL::mouse.y = my;
+                            INTERNAL::currentContext->mouse.x = mx;
+                            INTERNAL::currentContext->mouse.y = my;
 
                             // Mouse moved; release keyboard hover lock.
                             INTERNAL::Hover_Locked_To_Keyboard = false;
 
+                            // Movements carry nothing else than the position, so a run of them collapses into the latest position above.
+                            if (motion && !wheel) {
+                                // While dragging, the held button is reported with every movement, keep its original press time instead of pressing it again.
+                                if (btn != 3) {
+                                    std::string_view held = btn == 0 ? KEYBOARD_BUTTONS::MOUSE_LEFT : (btn == 1 ? KEYBOARD_BUTTONS::MOUSE_MIDDLE : KEYBOARD_BUTTONS::MOUSE_RIGHT);
+
+                                    if (currentContext->PREVIOUS_KEYBOARD_STATES[held].state)
+                                        currentContext->KEYBOARD_STATES[held] = currentContext->PREVIOUS_KEYBOARD_STATES[held];
+                                    else
+                                        currentContext->KEYBOARD_STATES[held] = buttonState(true);
+                                }
+
+                                continue;
+                            }
+
                             // Extract modifiers
                             bool shift   = (mask & 4) != 0;
                             bool alt     = (mask & 8) != 0;
                             bool control = (mask & 16) != 0;
 
                             if (shift) {
-                                INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
-                                INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::SHIFT));
+                                INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = buttonState(true);
+                                INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::SHIFT));
                             }
                             if (alt) {
-                                INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = buttonState(true);
-                                INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::ALT));
+                                INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = buttonState(true);
+                                INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::ALT));
                             }
                             if (control) {
-                                INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
-                                INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::CONTROL));
+                                INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = buttonState(true);
+                                INTERNAL::currentContext->inputs.push_back(takeInput(' ', GGUI::constants::CONTROL));
                             }
 
-                            // Button ID: low two bits
-                            int btn = mask & 0x03;
                             bool pressed = (action == 'M');
 
-                            switch (btn) {
+                            if (wheel) {
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP] = buttonState(btn == 0);
+                                currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN] = buttonState(btn == 1);
+                            }
+                            else switch (btn) {
                                 case 0: // left
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT] = buttonState(pressed);
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = std::chrono::high_resolution_clock::now();
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT] = buttonState(pressed);
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = CLOCK::now();
                                     break;
                                 case 1: // middle
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = buttonState(pressed);
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime = std::chrono::high_resolution_clock::now();
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = buttonState(pressed);
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime = CLOCK::now();
                                     break;
                                 case 2: // right
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT] = buttonState(pressed);
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = std::chrono::high_resolution_clock::now();
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT] = buttonState(pressed);
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = CLOCK::now();
                                     break;
                                 case 3: // release all buttons
                                     // you may want to clear all three
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT]   = buttonState(false);
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = buttonState(false);
-                                    KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT]  = buttonState(false);
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT]   = buttonState(false);
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = buttonState(false);
+                                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT]  = buttonState(false);
                                     break;
                             }
 
+                            // Keep the rest for the next batch, so that a press and its release or multiple scrolls are not folded into one state.
+                            ssize_t remaining = Raw_Input_Size - (i + 1);
+                            if (remaining > 0) {
+                                memmove(Raw_Input, Raw_Input + i + 1, remaining);
+                                Raw_Input_Size = remaining;
+                                return true;
+                            }
+
                             continue;
                         }
                         
@@ -1220,22 +1395,24 @@ namespace GGUI{
                     }
                     else {
                         // This is an ALT key
-                        inputs.push_back(new GGUI::input(Raw_Input[i], constants::ALT));
-                        KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = buttonState(true);
+                        currentContext->inputs.push_back(takeInput(Raw_Input[i], constants::ALT));
+                        currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = buttonState(true);
                     }
                 }
                 else if (Raw_Input[i] >= ' ' && Raw_Input[i] <= '~') {
                     // Normal character data
-                    inputs.push_back(new GGUI::input(Raw_Input[i], constants::KEY_PRESS));
+                    currentContext->inputs.push_back(takeInput(Raw_Input[i], constants::KEY_PRESS));
                 }
                 else if (Raw_Input[i] == constants::ANSI::DEL){
-                    inputs.push_back(new GGUI::input(' ', constants::BACKSPACE));
-                    KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = buttonState(true);
+                    currentContext->inputs.push_back(takeInput(' ', constants::BACKSPACE));
+                    currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = buttonState(true);
                 }
             }
 
             // We can assume that at the end of user input translation, all buffered inputs are hereby translate and no need to store, so reset offset.
             Raw_Input_Size = 0;
+
+            return false;
         }
 
         
@@ -1270,7 +1447,7 @@ namespace GGUI{
          *          handling specific ANSI features.
          */
         void initPlatformStuff(){
-            if (!SETTINGS::enableDRM) {
+            if (currentContext->output->ownsTerminal()) {
                 // Detect whether STDIN is a TTY. When not a TTY (e.g. piped/timeout), avoid raw mode and polling setup.
                 STDIN_IS_TTY = Is_Stdin_TTY();
 
@@ -1306,6 +1483,7 @@ namespace GGUI{
                     }
 
                     // Add a signal handler to automatically update the terminal size whenever a SIGWINCH signal is received.
+                    terminalContext = currentContext;
                     Add_Automatic_Terminal_Size_Update_Handler();
                 } else {
                     LOGGER::log("STDIN is not a TTY; input thread will be disabled unless DRM is enabled.");
@@ -1335,8 +1513,11 @@ namespace GGUI{
             }
             pthread_sigmask(SIG_BLOCK, &sigSet, nullptr);  // Block in all current/future threads
 
-            std::thread sigThread(onTerminationCleanupThread);
-            sigThread.detach(); // Make it independent.
+            // The event loop receives the termination signals through its own signalfd, and STDIN too when the backend reads the terminal.
+            if (!EVENT_LOOP::init(currentContext->output->ownsTerminal() && STDIN_IS_TTY)){
+                std::thread sigThread(onTerminationCleanupThread);
+                sigThread.detach(); // Make it independent.
+            }
 
             platformState.initialized = true;
         }
@@ -1385,10 +1566,14 @@ namespace GGUI{
             platformState.mouseReportingEnabled = true;
             std::cout << constants::ANSI::enablePrivateDECFeature(constants::ANSI::EXTEND_TO_SGR_MODE).toString();
             platformState.extendedIntoSGRMode = true;
+            std::cout << constants::ANSI::enablePrivateDECFeature(constants::ANSI::BRACKETED_PASTE).toString();
+            platformState.bracketedPasteEnabled = true;
             std::cout << std::flush;
         }
 
         void deinitTerminalANSICodes() {
+            if (platformState.bracketedPasteEnabled)
+                std::cout << constants::ANSI::enablePrivateDECFeature(constants::ANSI::BRACKETED_PASTE, false).toString();
             if (platformState.extendedIntoSGRMode)
                 std::cout << constants::ANSI::enablePrivateDECFeature(constants::ANSI::EXTEND_TO_SGR_MODE, false).toString();
             if (platformState.mouseReportingEnabled)
@@ -1407,9 +1592,57 @@ namespace GGUI{
             std::cout << std::flush;
         }
 
+        /**
+         * @brief Updates the maximum width and height from the backend of the current context.
+         * @details Keeps the previous size if the backend does not know it, like the DRM backend before it is connected.
+         *          If the main element exists, its dimensions are set to the new size.
+         */
+        void updateMaxWidthAndHeight(){
+            unsigned int width = 0;
+            unsigned int height = 0;
+
+            // Reports may ask for the size before initGGUI() has chosen the backend.
+            if (!currentContext->output)
+                currentContext->output = selectBackend();
+
+            if (!currentContext->output->getSize(width, height))
+                return;
+
+            if (SESSION::isRecording() && (width != currentContext->maxWidth || height != currentContext->maxHeight))
+                SESSION::recordResize(width, height);
+
+            currentContext->maxWidth = width;
+            currentContext->maxHeight = height;
+
+            // Convenience sake :)
+            if (currentContext->main)
+                currentContext->main->setDimensions(currentContext->maxWidth, currentContext->maxHeight);
+        }
+
         void Cleanup(){
             SignalThreadTermination();
 
+            // Give the rendering thread a moment to stop, otherwise it may still log after the statics are destructed at exit.
+            if (currentContext->ticket.getStatus() != atomic::status::NOT_INITIALIZED && !cooperativeMode){
+                currentContext->ticket.waitUntil([](){
+                    return currentContext->ticket.getStatus() == atomic::status::TERMINATED;
+                }, std::chrono::seconds(1));
+            }
+
+            // Disconnect the subscribers and remove the socket.
+            FRAME_SERVER::stop();
+
+            SESSION::stopRecording();
+
+            if (!SETTINGS::trace.empty())
+                TRACE::dump(SETTINGS::trace);
+
+            if (!SETTINGS::metrics.empty())
+                METRICS::dump(SETTINGS::metrics);
+
+            if (!SETTINGS::elementProfile.empty())
+                PROFILER::dump(SETTINGS::elementProfile);
+
             LOGGER::log("Reverting to normal console mode...");
 
             // Clean up platform-specific resources and settings (idempotent)
@@ -1424,7 +1657,7 @@ namespace GGUI{
          *          for keys that are held down and not already present in the inputs list. It skips mouse button keys.
          */
         void Populate_Inputs_For_Held_Down_Keys() {
-            for (auto Key : INTERNAL::KEYBOARD_STATES) {
+            for (auto Key : INTERNAL::currentContext->KEYBOARD_STATES) {
 
                 // Check if the key is activated
                 if (Key.second.state) {
@@ -1438,7 +1671,7 @@ namespace GGUI{
 
                     // Check if the input already exists
                     bool Found = false;
-                    for (auto input : INTERNAL::inputs) {
+                    for (auto input : INTERNAL::currentContext->inputs) {
                         if (input->criteria == Constant_Key) {
                             Found = true;
                             break;
@@ -1447,7 +1680,7 @@ namespace GGUI{
 
                     // If not found, create a new input
                     if (!Found)
-                        INTERNAL::inputs.push_back(new input((char)0, Constant_Key));
+                        INTERNAL::currentContext->inputs.push_back(takeInput((char)0, Constant_Key));
                 }
             }
         }
@@ -1462,40 +1695,43 @@ namespace GGUI{
          * @note This function related on click events when the current keyboard state for that specific key is NOT on!
          */
         void mouseAPI() {
+            // On the same clock as the captured presses, which a replayed session runs virtually.
+            CLOCK::timePoint Pressed_At = CLOCK::now();
+
             // Get the duration the left mouse button has been pressed
-            unsigned long long Mouse_Left_Pressed_For = (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(abs(Current_Time - INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime)).count();
+            unsigned long long Mouse_Left_Pressed_For = (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(abs(Pressed_At - INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime)).count();
 
             // Check if the left mouse button is pressed and for how long
-            if (INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state && Mouse_Left_Pressed_For >= SETTINGS::mousePressDownCooldown) {
-                INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_PRESSED));
+            if (INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state && Mouse_Left_Pressed_For >= SETTINGS::mousePressDownCooldown) {
+                INTERNAL::currentContext->inputs.push_back(takeInput(0, constants::MOUSE_LEFT_PRESSED));
             } 
             // Check if the left mouse button was previously pressed and now released
-            else if (!INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state && INTERNAL::PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state != INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state) {
-                INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
+            else if (!INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state && INTERNAL::currentContext->PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state != INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].state) {
+                INTERNAL::currentContext->inputs.push_back(takeInput(0, constants::MOUSE_LEFT_CLICKED));
             }
 
             // Get the duration the right mouse button has been pressed
-            unsigned long long Mouse_Right_Pressed_For = (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(abs(Current_Time - INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime)).count();
+            unsigned long long Mouse_Right_Pressed_For = (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(abs(Pressed_At - INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime)).count();
 
             // Check if the right mouse button is pressed and for how long
-            if (INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state && Mouse_Right_Pressed_For >= SETTINGS::mousePressDownCooldown) {
-                INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_RIGHT_PRESSED));
+            if (INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state && Mouse_Right_Pressed_For >= SETTINGS::mousePressDownCooldown) {
+                INTERNAL::currentContext->inputs.push_back(takeInput(0, constants::MOUSE_RIGHT_PRESSED));
             }
             // Check if the right mouse button was previously pressed and now released
-            else if (!INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state && INTERNAL::PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state != INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state) {
-                INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_RIGHT_CLICKED));
+            else if (!INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state && INTERNAL::currentContext->PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state != INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].state) {
+                INTERNAL::currentContext->inputs.push_back(takeInput(0, constants::MOUSE_RIGHT_CLICKED));
             }
 
             // Get the duration the middle mouse button has been pressed
-            unsigned long long Mouse_Middle_Pressed_For = (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(abs(Current_Time - INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime)).count();
+            unsigned long long Mouse_Middle_Pressed_For = (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(abs(Pressed_At - INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime)).count();
 
             // Check if the middle mouse button is pressed and for how long
-            if (INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state && Mouse_Middle_Pressed_For >= SETTINGS::mousePressDownCooldown) {
-                INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_MIDDLE_PRESSED));
+            if (INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state && Mouse_Middle_Pressed_For >= SETTINGS::mousePressDownCooldown) {
+                INTERNAL::currentContext->inputs.push_back(takeInput(0, constants::MOUSE_MIDDLE_PRESSED));
             }
             // Check if the middle mouse button was previously pressed and now released
-            else if (!INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state && INTERNAL::PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state != INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state) {
-                INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_MIDDLE_CLICKED));
+            else if (!INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state && INTERNAL::currentContext->PREVIOUS_KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state != INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].state) {
+                INTERNAL::currentContext->inputs.push_back(takeInput(0, constants::MOUSE_MIDDLE_CLICKED));
             }
         }
 
@@ -1506,18 +1742,18 @@ namespace GGUI{
          */
         void scrollAPI(){
             // Check if the mouse scroll up button has been pressed
-            if (KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].state){
+            if (currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].state){
 
                 // If the focused element is not null, call the scroll up function
-                if (focusedOn)
-                    focusedOn->scrollUp();
+                if (currentContext->focusedOn)
+                    currentContext->focusedOn->scrollUp();
             }
             // Check if the mouse scroll down button has been pressed
-            else if (KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].state){
+            else if (currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].state){
 
                 // If the focused element is not null, call the scroll down function
-                if (focusedOn)
-                    focusedOn->scrollDown();
+                if (currentContext->focusedOn)
+                    currentContext->focusedOn->scrollDown();
             }
         }
 
@@ -1530,15 +1766,15 @@ namespace GGUI{
          */
         void handleEscape(){
             // Check if the escape key has been pressed
-            if (!KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC].state)
+            if (!currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC].state)
                 return;
                     
             // If the focused element is not null, remove the focus
-            if (focusedOn){
-                updateHoveredElement(focusedOn); // Update the hovered element to be the focused element before un-focusing it.
+            if (currentContext->focusedOn){
+                updateHoveredElement(currentContext->focusedOn); // Update the hovered element to be the focused element before un-focusing it.
                 unFocusElement();
             }
-            else if (hoveredOn){
+            else if (currentContext->hoveredOn){
                 // If nothing is focused, ESC clears hover.
                 unHoverElement();
             }
@@ -1551,18 +1787,18 @@ namespace GGUI{
          */
         void handleTabulator(){
             // Check if the tab key has been pressed
-            if (!KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB].state)
+            if (!currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB].state)
                 return;
 
-            if (focusedOn) return;   // Tabulator is disabled from switching if an element is focused on, this gives us the ability to insert tabs into textFields.
+            if (currentContext->focusedOn) return;   // Tabulator is disabled from switching if an element is focused on, this gives us the ability to insert tabs into textFields.
 
-            if (eventHandlers.empty())
+            if (currentContext->eventHandlers.empty())
                 return;
             
             // return if there are only INTERNAL::main handlers
             bool Only_Main_Handlers = true;
-            for (const auto* Handler : eventHandlers){  // yes this is kinda dumb way of doing this but it works well...
-                if (Handler != INTERNAL::main){
+            for (const auto* Handler : currentContext->eventHandlers){  // yes this is kinda dumb way of doing this but it works well...
+                if (Handler != INTERNAL::currentContext->main){
                     Only_Main_Handlers = false;
                     break;
                 }
@@ -1572,18 +1808,18 @@ namespace GGUI{
                 return;
 
             // Check if the shift key is pressed
-            bool Shift_Is_Pressed = KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT].state;
+            bool Shift_Is_Pressed = currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT].state;
 
             // Get the current element from the selected element
-            element* Current = hoveredOn;
+            element* Current = currentContext->hoveredOn;
             
             int Current_Index = 0;
 
             // Find the index of the current element in the list of event handlers
             if (Current){
                 // Find the first occurrence of the event handlers with this Current being their Host.
-                for (;(size_t)Current_Index < eventHandlers.size(); Current_Index++){
-                    if (eventHandlers[(size_t)Current_Index] == Current)
+                for (;(size_t)Current_Index < currentContext->eventHandlers.size(); Current_Index++){
+                    if (currentContext->eventHandlers[(size_t)Current_Index] == Current)
                         break;
                 }
             }
@@ -1595,16 +1831,16 @@ namespace GGUI{
 
                 // If the index is out of bounds, wrap it around to the other side of the list
                 if (Current_Index < 0){
-                    Current_Index = eventHandlers.size() - 1;
+                    Current_Index = currentContext->eventHandlers.size() - 1;
                 }
-                else if ((size_t)Current_Index >= eventHandlers.size()){
+                else if ((size_t)Current_Index >= currentContext->eventHandlers.size()){
                     Current_Index = 0;
                 }
-            } while ((size_t)Current_Index < eventHandlers.size() && eventHandlers[(size_t)Current_Index] == INTERNAL::main);
+            } while ((size_t)Current_Index < currentContext->eventHandlers.size() && currentContext->eventHandlers[(size_t)Current_Index] == INTERNAL::currentContext->main);
 
             // Now update the hovered element with the new index
             Hover_Locked_To_Keyboard = true;
-            updateHoveredElement(eventHandlers[(size_t)Current_Index]);
+            updateHoveredElement(currentContext->eventHandlers[(size_t)Current_Index]);
         }
 
         /**
@@ -1614,13 +1850,13 @@ namespace GGUI{
          * @return The current maximum width of the terminal.
          */
         int getMaxWidth(){
-            if (maxWidth == 0 && maxHeight == 0){
-                Carry_Flags([](carry& current_carry){
+            if (currentContext->maxWidth == 0 && currentContext->maxHeight == 0){
+                currentContext->Carry_Flags([](carry& current_carry){
                     current_carry.resize = true;    // Tell the render thread that an resize is needed to be performed.
                 });
             }
             
-            return maxWidth;
+            return currentContext->maxWidth;
         }
 
         /**
@@ -1630,31 +1866,33 @@ namespace GGUI{
          * @return The current maximum height of the terminal.
          */
         int getMaxHeight(){
-            if (maxWidth == 0 && maxHeight == 0){
-                Carry_Flags([](carry& current_carry){
+            if (currentContext->maxWidth == 0 && currentContext->maxHeight == 0){
+                currentContext->Carry_Flags([](carry& current_carry){
                     current_carry.resize = true;    // Tell the render thread that an resize is needed to be performed.
                 });
             }
 
-            return maxHeight;
+            return currentContext->maxHeight;
         }
 
         
         /**
          * @brief Converts a vector of UTFs into a Super_String.
-         * @details This function takes a vector of UTFs, and converts it into a Super_String. The resulting Super_String is stored in a cache, and the cache is resized if the window size has changed.
+         * @details This function takes a vector of UTFs, and converts it into a Super_String. The resulting Super_String is stored in a cache of the current context, and the cache is resized if the window size has changed.
          * @param Text The vector of UTFs to convert.
          * @param Width The width of the window.
          * @param Height The height of the window.
          * @return A pointer to the resulting Super_String.
          */
         conveyorAllocator<compactString> liquifyUTFText(const std::vector<GGUI::UTF>* Text, unsigned int& Liquefied_Size, int Width, int Height){
-            static conveyorAllocator<compactString> LIQUIFY_UTF_TEXT_RESULT_CACHE(1000*1000);
-            static superString<GGUI::constants::ANSI::maximumNeededPreAllocationForEncodedSuperString> LIQUIFY_UTF_TEXT_TMP_CONTAINER;
+            GGUI_TRACE_SCOPE("liquifyUTFText");
+
+            conveyorAllocator<compactString>& LIQUIFY_UTF_TEXT_RESULT_CACHE = currentContext->liquifiedText;
+            superString<GGUI::constants::ANSI::maximumNeededPreAllocationForEncodedSuperString>& LIQUIFY_UTF_TEXT_TMP_CONTAINER = currentContext->liquifyContainer;
 
             const unsigned int Maximum_Needed_Pre_Allocation_For_Whole_Cache_Buffer = (Width * Height * constants::ANSI::maximumNeededPreAllocationForEncodedSuperString + !SETTINGS::wordWrapping * (Height - 1));
 
-            // Since they are located as globals we need to remember to restart the starting offset.
+            // Since they are kept from frame to frame we need to remember to restart the starting offset.
             Liquefied_Size = 0;
 
             // Ensure previous frame contents are not read again
@@ -1695,70 +1933,91 @@ namespace GGUI{
             // Gracefully shutdown event and rendering threads.
             requestTermination = true;
 
-            atomic::condition.notify_all();
+            // The rendering thread of each context waits on its own ticket.
+            contexts.read([](const std::vector<context*>& self){
+                for (context* each : self)
+                    each->ticket.notify();
+            });
+            EVENT_LOOP::wake();
         }
 
         /**
-         * @brief This function is a helper for the smart memory system to recall which tasks should be prolonged, and which should be deleted.
-         * @details This function is a lambda function that is used by the Atomic::Guard class to prolong or delete memories in the smart memory system.
-         *          It takes a pointer to a vector of Memory objects and prolongs or deletes the memories in the vector based on the time difference between the current time and the memory's start time.
+         * @brief Runs the due memories of the smart memory system.
+         * @details The due memories are taken out of the scheduler, so their jobs run without holding the remember guard and can add new memories.
+         *          Afterwards retriggering memories are scheduled again from now, successful ones are removed and failed ones are retried after MIN_UPDATE_SPEED.
+         *          Also updates the event thread load from the time left to the next deadline.
          */
         void recallMemories(){
-            INTERNAL::remember([](std::vector<memory>& rememberable){
-                std::chrono::high_resolution_clock::time_point currentTime = std::chrono::high_resolution_clock::now();
-
-                // For smart memory system to shorten the next sleep time to arrive at the perfect time for the nearest memory.
-                size_t Shortest_Time = INTERNAL::MAX_UPDATE_SPEED;
-                // Prolong prolongable memories.
-                for (unsigned int i = 0; i < rememberable.size(); i++){
-                    for (unsigned int j = i + 1; j < rememberable.size(); j++){
-                        if (rememberable.at(i).is(MEMORY_FLAGS::PROLONG_MEMORY) && rememberable.at(j).is(MEMORY_FLAGS::PROLONG_MEMORY) && i != j)
-                            // Check if the Job at I is same as the one at J.
-                            if (rememberable.at(i).Job.target<bool(*)(GGUI::event*)>() == rememberable.at(j).Job.target<bool(*)(GGUI::event*)>()){
-                                // Since J will always be one later than I, J will contain the prolonging memory if there is one. 
-                                rememberable.at(i).startTime = rememberable.at(j).startTime;
-
-                                rememberable.erase(rememberable.begin() + j--);
-                                break;
-                            }
-                    }
-                }
+            GGUI_TRACE_SCOPE("recallMemories");
 
-                for (unsigned int i = 0; i < rememberable.size(); i++){
-                    //first calculate the time difference between the start if the task and the end task
-                    size_t Time_Difference = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - rememberable.at(i).startTime).count();
+            CLOCK::timePoint currentTime = CLOCK::now();
 
-                    size_t Time_Left = rememberable.at(i).endTime - Time_Difference;
+            std::vector<std::pair<memoryHandle, memory>> due;
+            INTERNAL::currentContext->remember([&currentTime, &due](memoryScheduler& self){
+                self.takeDue(currentTime, due);
+            });
 
-                    if (Time_Left < Shortest_Time)
-                        Shortest_Time = Time_Left;
+            // Whether each of the due memories should be scheduled again.
+            std::vector<bool> keep(due.size(), true);
 
-                    //if the time difference is greater than the time limit, then delete the memory
-                    if (Time_Difference > rememberable.at(i).endTime){
-                        try{
-                            bool Success = rememberable.at(i).Job((event*)&rememberable.at(i));
+            for (size_t i = 0; i < due.size(); i++){
+                memory& current = due[i].second;
 
-                            // If job is a re-trigger it will ignore whether the job was successful or not.
-                            if (rememberable.at(i).is(MEMORY_FLAGS::RETRIGGER)){
+                try{
+                    bool Success = current.Job((event*)&current);
 
-                                // May need to change this into more accurate version of time capturing.
-                                rememberable.at(i).startTime = currentTime;
+                    // If job is a re-trigger it will ignore whether the job was successful or not.
+                    keep[i] = current.is(MEMORY_FLAGS::RETRIGGER) || !Success;
+                }
+                catch (std::exception& e){
+                    INTERNAL::reportStack("In memory: '" + current.ID + "' Problem: " + std::string(e.what()));
+                }
+            }
 
-                            }
-                            else if (Success){
-                                rememberable.erase(rememberable.begin() + i);
+            // For smart memory system to shorten the next sleep time to arrive at the perfect time for the nearest memory.
+            size_t Shortest_Time = INTERNAL::MAX_UPDATE_SPEED;
 
-                                i--;
-                            }
-                        }
-                        catch (std::exception& e){
-                            INTERNAL::reportStack("In memory: '" + rememberable.at(i).ID + "' Problem: " + std::string(e.what()));
-                        }
+            INTERNAL::currentContext->remember([&currentTime, &due, &keep, &Shortest_Time](memoryScheduler& self){
+                for (size_t i = 0; i < due.size(); i++){
+                    memory& current = due[i].second;
+
+                    if (!keep[i]){
+                        self.release(due[i].first);
+                    }
+                    else if (current.is(MEMORY_FLAGS::RETRIGGER)){
+                        // May need to change this into more accurate version of time capturing.
+                        current.startTime = currentTime;
+                        self.reschedule(due[i].first, std::move(current), currentTime + std::chrono::milliseconds(current.endTime));
+                    }
+                    else{
+                        // Failed jobs are retried, but not on every wake-up.
+                        self.reschedule(due[i].first, std::move(current), currentTime + std::chrono::milliseconds(INTERNAL::MIN_UPDATE_SPEED));
                     }
+                }
 
+                std::chrono::high_resolution_clock::time_point deadline;
+                if (self.nextDeadline(deadline) && deadline < currentTime + std::chrono::milliseconds(Shortest_Time)){
+                    Shortest_Time = deadline > currentTime ? std::chrono::duration_cast<std::chrono::milliseconds>(deadline - currentTime).count() : 0;
                 }
+            });
 
-                INTERNAL::eventThreadLoad = lerp(INTERNAL::MIN_UPDATE_SPEED, INTERNAL::MAX_UPDATE_SPEED, Shortest_Time);
+            INTERNAL::eventThreadLoad = lerp(INTERNAL::MIN_UPDATE_SPEED, INTERNAL::MAX_UPDATE_SPEED, Shortest_Time);
+        }
+
+        /**
+         * @brief Runs the commands posted with GGUI::post() in the order they were posted.
+         * @details Called by the rendering thread at the start of each frame, while no other thread is allowed to touch the elements.
+         *          Exceptions thrown by a command are reported and don't stop the following commands.
+         * @return The number of commands applied.
+         */
+        size_t applyCommands(){
+            return currentContext->commands.drain([](std::function<void()>& command){
+                try{
+                    command();
+                }
+                catch(std::exception& e){
+                    INTERNAL::reportStack("In posted command arose problem: \n" + std::string(e.what()));
+                }
             });
         }
 
@@ -1816,15 +2075,15 @@ namespace GGUI{
          *          Focus is only removed if the element's current focus state differs from the desired state.
          */
         void unFocusElement(){
-            if (!INTERNAL::focusedOn)
+            if (!INTERNAL::currentContext->focusedOn)
                 return;
 
-            INTERNAL::focusedOn->setFocus(false);
+            INTERNAL::currentContext->focusedOn->setFocus(false);
 
             // Recursively remove focus from all child elements
-            Recursively_Apply_Focus(INTERNAL::focusedOn, false);
+            Recursively_Apply_Focus(INTERNAL::currentContext->focusedOn, false);
 
-            INTERNAL::focusedOn = nullptr;
+            INTERNAL::currentContext->focusedOn = nullptr;
         }
 
         /**
@@ -1834,17 +2093,17 @@ namespace GGUI{
          *          Hover is only removed if the element's current hover state differs from the desired state.
          */
         void unHoverElement(){
-            if (!INTERNAL::hoveredOn)
+            if (!INTERNAL::currentContext->hoveredOn)
                 return;
 
             // Set the hover state to false on the currently hovered element
-            INTERNAL::hoveredOn->setHoverState(false);
+            INTERNAL::currentContext->hoveredOn->setHoverState(false);
 
             // Recursively remove the hover state from all child elements
-            Recursively_Apply_Hover(INTERNAL::hoveredOn, false);
+            Recursively_Apply_Hover(INTERNAL::currentContext->hoveredOn, false);
 
             // Set the hovered element to nullptr to indicate there is no currently hovered element
-            INTERNAL::hoveredOn = nullptr;
+            INTERNAL::currentContext->hoveredOn = nullptr;
         }
 
         /**
@@ -1855,27 +2114,27 @@ namespace GGUI{
          * @param new_candidate The new element to focus on.
          */
         void updateFocusedElement(GGUI::element* new_candidate){
-            if (INTERNAL::focusedOn == new_candidate || new_candidate == INTERNAL::main)
+            if (INTERNAL::currentContext->focusedOn == new_candidate || new_candidate == INTERNAL::currentContext->main)
                 return;
 
             if (!new_candidate) return; // For total unselection, use unFocusElement()
 
             // Unfocus the previous focused element and its children
-            if (INTERNAL::focusedOn){
+            if (INTERNAL::currentContext->focusedOn){
                 unFocusElement();
             }
 
             // Set the focus on the new element and all its children
-            INTERNAL::focusedOn = new_candidate;
+            INTERNAL::currentContext->focusedOn = new_candidate;
 
             // Update mouse location to match with keyboard given states.
-            mouse = INTERNAL::focusedOn->getAbsolutePosition();
+            INTERNAL::currentContext->mouse = INTERNAL::currentContext->focusedOn->getAbsolutePosition();
 
             // Set the focus state on the new element to true
-            INTERNAL::focusedOn->setFocus(true);
+            INTERNAL::currentContext->focusedOn->setFocus(true);
             
             // Recursively set the focus state on all child elements to true
-            Recursively_Apply_Focus(INTERNAL::focusedOn, true);
+            Recursively_Apply_Focus(INTERNAL::currentContext->focusedOn, true);
         }
 
         /**
@@ -1886,27 +2145,27 @@ namespace GGUI{
          * @param new_candidate The new element to hover on.
          */
         void updateHoveredElement(GGUI::element* new_candidate){
-            if (INTERNAL::hoveredOn == new_candidate || new_candidate == INTERNAL::main)
+            if (INTERNAL::currentContext->hoveredOn == new_candidate || new_candidate == INTERNAL::currentContext->main)
                 return;
 
             if (!new_candidate) return; // For total unselection, use unHoverElement()
 
             // Remove the hover state from the previous hovered element and its children
-            if (INTERNAL::hoveredOn){
+            if (INTERNAL::currentContext->hoveredOn){
                 unHoverElement();
             }
 
             // Set the hover state on the new element and all its children
-            INTERNAL::hoveredOn = new_candidate;
+            INTERNAL::currentContext->hoveredOn = new_candidate;
 
             // Update mouse location to match with keyboard given states.
-            mouse = INTERNAL::hoveredOn->getAbsolutePosition();
+            INTERNAL::currentContext->mouse = INTERNAL::currentContext->hoveredOn->getAbsolutePosition();
 
             // Set the hover state on the new element to true
-            INTERNAL::hoveredOn->setHoverState(true);
+            INTERNAL::currentContext->hoveredOn->setHoverState(true);
 
             // Recursively set the hover state on all child elements to true
-            Recursively_Apply_Hover(INTERNAL::hoveredOn, true);
+            Recursively_Apply_Hover(INTERNAL::currentContext->hoveredOn, true);
         }
 
         /**
@@ -1926,8 +2185,12 @@ namespace GGUI{
             // Since some key events are piped to us at a different speed than others, we need to keep the older (un-used) inputs "alive" until their turn arrives.
             Populate_Inputs_For_Held_Down_Keys();
 
-            for (unsigned int i = 0; i < INTERNAL::eventHandlers.size(); i++){
-                element* currentElement = INTERNAL::eventHandlers[i];
+            // Hover is decided once after all handlers have been checked, instead of re-staining subtrees for every overlapping element on the way.
+            element* hoverCandidate = nullptr;
+            bool hoveredElementLeft = false;
+
+            for (unsigned int i = 0; i < INTERNAL::currentContext->eventHandlers.size(); i++){
+                element* currentElement = INTERNAL::currentContext->eventHandlers[i];
 
                 const std::vector<action*>& currentEventhandlers = currentElement->getEventHandlers();
 
@@ -1944,14 +2207,14 @@ namespace GGUI{
                         if (!currentElement->isDisplayed())
                             continue;   // Skip eventhandlers where their host is not active
 
-                        bool overlapsWithMouse = INTERNAL::collides(currentElement, INTERNAL::mouse);
+                        bool overlapsWithMouse = INTERNAL::collides(currentElement, INTERNAL::currentContext->mouse);
 
                         // First let's go through all inputs and see if any selector inputs are present.
-                        for (size_t k = 0; k < INTERNAL::inputs.size();){
-                            input* currentInput = INTERNAL::inputs[k];      
+                        for (size_t k = 0; k < INTERNAL::currentContext->inputs.size();){
+                            input* currentInput = INTERNAL::currentContext->inputs[k];      
         
                             Has_Mouse_Left_Click_Event = has(currentInput->criteria, constants::MOUSE_LEFT_CLICKED) && overlapsWithMouse;
-                            Has_Enter_Press_Event = has(currentInput->criteria, constants::ENTER) && INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER].state == true;
+                            Has_Enter_Press_Event = has(currentInput->criteria, constants::ENTER) && INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER].state == true;
         
                             // Check if the host is prime to be focused on
                             if ((Has_Mouse_Left_Click_Event || Has_Enter_Press_Event) && currentElement->isHovered()){
@@ -1959,17 +2222,28 @@ namespace GGUI{
                                 unHoverElement();
 
                                 // Remove the input, since it's job is used here:
-                                INTERNAL::inputs.erase(INTERNAL::inputs.begin() + k);
+                                releaseInput(currentInput);
+                                INTERNAL::currentContext->inputs.erase(INTERNAL::currentContext->inputs.begin() + k);
                                 continue;
                             }
 
                             // Criteria must be identical for more accurate criteria listing.
                             if (currentEventHandler->criteria == currentInput->criteria && currentElement->isFocused()){
                                 try{
+                                    GGUI_TRACE_SCOPE_DETAIL("eventHandler", currentEventHandler->ID);
+
+                                    auto start = std::chrono::high_resolution_clock::now();
+                                    bool success = currentEventHandler->Job(currentInput);
+
+                                    // Async handlers are accounted by the pool, here they only hand their work over.
+                                    if (!currentEventHandler->async)
+                                        HANDLER_POOL::record(currentEventHandler->ID, std::chrono::high_resolution_clock::now() - start, false);
+
                                     // Check if this job could be run successfully.
-                                    if (currentEventHandler->Job(currentInput)){
+                                    if (success){
                                         //dont let anyone else react to this event.
-                                        INTERNAL::inputs.erase(INTERNAL::inputs.begin() + k);
+                                        releaseInput(currentInput);
+                                        INTERNAL::currentContext->inputs.erase(INTERNAL::currentContext->inputs.begin() + k);
                                         continue;
                                     }
                                     else{
@@ -1989,11 +2263,12 @@ namespace GGUI{
                         if (!currentElement->isFocused()) {
                             if (!INTERNAL::Hover_Locked_To_Keyboard) {
                                 if (overlapsWithMouse){
-                                    updateHoveredElement(currentElement);
+                                    // Later elements are on top of earlier ones, so the last overlapping one wins.
+                                    hoverCandidate = currentElement;
                                 }
                                 else {
-                                    if (INTERNAL::hoveredOn == currentElement)
-                                        unHoverElement();
+                                    if (INTERNAL::currentContext->hoveredOn == currentElement)
+                                        hoveredElementLeft = true;
                                 }
                             }
                         }
@@ -2044,8 +2319,30 @@ namespace GGUI{
 
             }
             
+            if (hoverCandidate)
+                updateHoveredElement(hoverCandidate);
+            else if (hoveredElementLeft)
+                unHoverElement();
+
             // If no event handler recognized these inputs, there is no need to keep them lingering for next time.
-            INTERNAL::inputs.clear();
+            // Inputs are owned by this list, so release them too, otherwise every unclaimed paste would leak its whole text.
+            for (input* unclaimed : INTERNAL::currentContext->inputs)
+                releaseInput(unclaimed);
+            INTERNAL::currentContext->inputs.clear();
+        }
+
+        void releaseInput(input* used){
+            std::vector<std::unique_ptr<input>>& spare = currentContext->spareInputs;
+
+            if (spare.size() >= maxSpareInputs){
+                delete used;
+                return;
+            }
+
+            // A paste may have brought a large text, which is not worth keeping around.
+            used->text = std::string();
+
+            spare.emplace_back(used);
         }
 
         /**
@@ -2055,20 +2352,73 @@ namespace GGUI{
          * @return The ID of the class.
          */
         int getFreeClassID(std::string n){
+            // Subtrees can be built on other threads, so the class names can be asked concurrently.
+            static std::mutex classNamesMutex;
+            std::lock_guard lock(classNamesMutex);
+
             // Check if the class name is already in the map
-            if (INTERNAL::classNames.find(n) != INTERNAL::classNames.end()){
+            if (INTERNAL::currentContext->classNames.find(n) != INTERNAL::currentContext->classNames.end()){
                 // Return the existing class ID
-                return INTERNAL::classNames[n];
+                return INTERNAL::currentContext->classNames[n];
             }
             else{
                 // Assign a new class ID as the current size of the map
-                INTERNAL::classNames[n] = INTERNAL::classNames.size();
+                INTERNAL::currentContext->classNames[n] = INTERNAL::currentContext->classNames.size();
 
                 // Return the newly assigned class ID
-                return INTERNAL::classNames[n];
+                return INTERNAL::currentContext->classNames[n];
             }
         }
 
+        /**
+         * @brief Runs the job right away, or at the end of the current GGUI::batch() if there is one.
+         * @details Within a batch only the last job given for the same key is run, at the position where the key was first deferred.
+         * @param key Identifies what the job re-builds, like the element it belongs to.
+         * @param job The work to do.
+         */
+        void deferToBatchEnd(const void* key, std::function<void()> job){
+            if (!currentBatch){
+                job();
+                return;
+            }
+
+            auto existing = currentBatch->jobIndices.find(key);
+
+            if (existing != currentBatch->jobIndices.end()){
+                currentBatch->jobs[existing->second].second = std::move(job);
+                return;
+            }
+
+            currentBatch->jobIndices[key] = currentBatch->jobs.size();
+            currentBatch->jobs.emplace_back(key, std::move(job));
+        }
+
+        /**
+         * @brief Drops the job deferred for the key, used by elements destroyed within a batch.
+         * @param key The key given to deferToBatchEnd().
+         */
+        void forgetBatched(const void* key){
+            if (!currentBatch)
+                return;
+
+            auto existing = currentBatch->jobIndices.find(key);
+
+            if (existing != currentBatch->jobIndices.end())
+                currentBatch->jobs[existing->second].second = nullptr;
+        }
+
+        void forgetRegistrations(const void* owner){
+            if (!detachedRegistrations)
+                return;
+
+            detachedRegistrations->erase(
+                std::remove_if(detachedRegistrations->begin(), detachedRegistrations->end(), [owner](const std::pair<const void*, std::function<void()>>& registration){
+                    return registration.first == owner;
+                }),
+                detachedRegistrations->end()
+            );
+        }
+
         /**
          * @brief Initializes the GGUI system and returns the main window.
          * 
@@ -2081,66 +2431,119 @@ namespace GGUI{
             INTERNAL::LOGGER::registerCurrentThread();
             INTERNAL::LOGGER::log("Starting GGUI Core initialization...");
 
+            // Unless the application already chose one with setBackend().
+            if (!INTERNAL::currentContext->output)
+                INTERNAL::currentContext->output = INTERNAL::selectBackend();
+
+            INTERNAL::LOGGER::log("Using the " + std::string(INTERNAL::currentContext->output->getName()) + " backend.");
+
             INTERNAL::updateMaxWidthAndHeight();
             
-            if (!SETTINGS::enableDRM){
-                if (INTERNAL::maxHeight == 0 || INTERNAL::maxWidth == 0){
+            // A remote output tells its size once connected.
+            if (!INTERNAL::currentContext->output->isRemote()){
+                if (INTERNAL::currentContext->maxHeight == 0 || INTERNAL::currentContext->maxWidth == 0){
                     INTERNAL::LOGGER::log("Width/Height is zero!");
                     return nullptr;
                 }
             }
 
             // Save the state before the init
-            INTERNAL::Current_Time = std::chrono::high_resolution_clock::now();
+            INTERNAL::Current_Time = INTERNAL::CLOCK::now();
             INTERNAL::Previous_Time = INTERNAL::Current_Time;
 
             INTERNAL::initPlatformStuff();
 
-            INTERNAL::main = new element(
-                width(INTERNAL::maxWidth) |
-                height(INTERNAL::maxHeight) | 
+            INTERNAL::currentContext->main = new element(
+                width(INTERNAL::currentContext->maxWidth) |
+                height(INTERNAL::currentContext->maxHeight) | 
                 name("Main")
             , true);
 
-            std::thread renderingThread([](){
-                INTERNAL::LOGGER::registerCurrentThread();
-                INTERNAL::renderer();
-            });
-            renderingThread.detach();  // Let the rendering thread able to std::exit.
+            if (!SETTINGS::frameServer.empty())
+                INTERNAL::FRAME_SERVER::start(SETTINGS::frameServer);
+
+            if (!SETTINGS::record.empty())
+                INTERNAL::SESSION::startRecording(SETTINGS::record);
+
+            if (!SETTINGS::trace.empty())
+                INTERNAL::TRACE::enable(true);
+
+            if (!SETTINGS::elementProfile.empty())
+                INTERNAL::PROFILER::enable(true);
+
+            if (!SETTINGS::metrics.empty()){
+                addMemory(memory(
+                    TIME::SECOND,
+                    []([[maybe_unused]] event* Event){
+                        INTERNAL::METRICS::dump(SETTINGS::metrics);
+                        return true;
+                    },
+                    MEMORY_FLAGS::RETRIGGER,
+                    "Metrics snapshot"
+                ));
+            }
+
+            // The application drives everything through tick() from its own thread, so none of the internal threads are needed.
+            INTERNAL::cooperativeMode = SETTINGS::cooperative && INTERNAL::EVENT_LOOP::isActive() && !INTERNAL::currentContext->output->needsInputThread();
+
+            if (SETTINGS::cooperative && !INTERNAL::cooperativeMode)
+                INTERNAL::LOGGER::log("Cooperative mode needs the event loop and is not available with the " + std::string(INTERNAL::currentContext->output->getName()) + " backend, falling back to internal threads.");
+
+            if (!INTERNAL::cooperativeMode){
+                // The threads work on the context of the thread initializing them.
+                context* owner = currentContext;
+
+                std::thread renderingThread([owner](){
+                    currentContext = owner;
+                    INTERNAL::LOGGER::registerCurrentThread();
+                    INTERNAL::renderer();
+                });
+                renderingThread.detach();  // Let the rendering thread able to std::exit.
             
-            std::thread eventThread([](){
-                INTERNAL::LOGGER::registerCurrentThread();
-                INTERNAL::eventThread();
-            });
-            eventThread.detach();  // Let the rendering thread able to std::exit.
+                if (INTERNAL::EVENT_LOOP::isActive()){
+                    // Handles the passive tasks, signals and STDIN input in one thread, which only wakes up when something happens.
+                    std::thread eventLoop([owner](){
+                        currentContext = owner;
+                        INTERNAL::LOGGER::registerCurrentThread();
+                        INTERNAL::EVENT_LOOP::run();
+                    });
+                    eventLoop.detach();
+                }
+                else{
+                    std::thread eventThread([owner](){
+                        currentContext = owner;
+                        INTERNAL::LOGGER::registerCurrentThread();
+                        INTERNAL::eventThread();
+                    });
+                    eventThread.detach();  // Let the rendering thread able to std::exit.
+                }
             
-            // Start input thread only if DRM is enabled or STDIN is a TTY (interactive).
-            std::unique_ptr<std::thread> Inquire_Scheduler_ptr;
-            if (SETTINGS::enableDRM || STDIN_IS_TTY){
-                Inquire_Scheduler_ptr = std::make_unique<std::thread>([](){
+                // Start input thread only if the backend needs one, like DRM or an interactive STDIN which the event loop is not reading.
+                std::unique_ptr<std::thread> Inquire_Scheduler_ptr;
+                if (INTERNAL::currentContext->output->needsInputThread()){
+                    Inquire_Scheduler_ptr = std::make_unique<std::thread>([owner](){
+                        currentContext = owner;
+                        INTERNAL::LOGGER::registerCurrentThread();
+                        INTERNAL::inputThread();
+                    });
+                }
+
+                std::thread Logging_Scheduler([owner](){
+                    currentContext = owner;
                     INTERNAL::LOGGER::registerCurrentThread();
-                    INTERNAL::inputThread();
+                    INTERNAL::loggerThread();
                 });
-            }
-
-            std::thread Logging_Scheduler([](){
-                INTERNAL::LOGGER::registerCurrentThread();
-                INTERNAL::loggerThread();
-            });
             
-            if (Inquire_Scheduler_ptr) Inquire_Scheduler_ptr->detach();
-            Logging_Scheduler.detach();
+                if (Inquire_Scheduler_ptr) Inquire_Scheduler_ptr->detach();
+                Logging_Scheduler.detach();
+            }
 
             INTERNAL::LOGGER::log("GGUI Core initialization complete.");
 
-            {
-                std::unique_lock lock(INTERNAL::atomic::mutex);
+            // Remove NOT_INITALIZED from the render thread flag.
+            INTERNAL::currentContext->ticket.initialize();
 
-                // Remove NOT_INITALIZED from the render thread flag.
-                INTERNAL::atomic::pauseRenderThread = INTERNAL::atomic::status::PAUSED;
-            }
-
-            return INTERNAL::main;
+            return INTERNAL::currentContext->main;
         }
 
         /**
@@ -2200,6 +2603,8 @@ namespace GGUI{
          *          to determine where encoding strips start and end.
          */
         void encodeBuffer(std::vector<GGUI::UTF>* Buffer) {
+            GGUI_TRACE_SCOPE("encodeBuffer");
+
             const size_t Count = Buffer->size();
             if (Count == 0) return;
 
@@ -2220,8 +2625,8 @@ namespace GGUI{
             }
 
             // Calculate the relative size difference between the non-encoded and the encoded buffers.
-            INTERNAL::BEFORE_ENCODE_BUFFER_SIZE = Buffer->size() *  constants::ANSI::maximumNeededPreAllocationForEncodedSuperString;
-            INTERNAL::AFTER_ENCODE_BUFFER_SIZE = 0;
+            INTERNAL::currentContext->BEFORE_ENCODE_BUFFER_SIZE = Buffer->size() *  constants::ANSI::maximumNeededPreAllocationForEncodedSuperString;
+            INTERNAL::currentContext->AFTER_ENCODE_BUFFER_SIZE = 0;
 
             // Cache previous colors (start with the very first element)
             auto PrevFg = Buffer->front().foreground;
@@ -2241,20 +2646,20 @@ namespace GGUI{
                 if (!SameAsPrev) {
                     Curr->setFlag(ENCODING_FLAG::START);
                     // for logging:
-                    INTERNAL::AFTER_ENCODE_BUFFER_SIZE += constants::ANSI::maximumNeededPreAllocationForOverhead;
+                    INTERNAL::currentContext->AFTER_ENCODE_BUFFER_SIZE += constants::ANSI::maximumNeededPreAllocationForOverhead;
                 }
 
                 if (!SameAsNext) {
                     Curr->setFlag(ENCODING_FLAG::END);
                     // for logging:
-                    INTERNAL::AFTER_ENCODE_BUFFER_SIZE += constants::ANSI::maximumNeededPreAllocationForReset;
+                    INTERNAL::currentContext->AFTER_ENCODE_BUFFER_SIZE += constants::ANSI::maximumNeededPreAllocationForReset;
                 }
 
                 PrevFg = Curr->foreground;
                 PrevBg = Curr->background;
 
                 // for logging:
-                INTERNAL::AFTER_ENCODE_BUFFER_SIZE++;
+                INTERNAL::currentContext->AFTER_ENCODE_BUFFER_SIZE++;
 
                 Curr++;
                 Next++;
@@ -2264,14 +2669,14 @@ namespace GGUI{
             auto& Last = Buffer->back();
             Last.setFlag(ENCODING_FLAG::END);
             // for logging:
-            INTERNAL::AFTER_ENCODE_BUFFER_SIZE++;
+            INTERNAL::currentContext->AFTER_ENCODE_BUFFER_SIZE++;
 
             // Compare last with second-last for possible START flag
             const auto& SecondLast = Buffer->at(Count - 2);
             if (!(Last.foreground == SecondLast.foreground) || !(Last.background == SecondLast.background)) {
                 Last.setFlag(ENCODING_FLAG::START);
                 // for logging:
-                INTERNAL::AFTER_ENCODE_BUFFER_SIZE += constants::ANSI::maximumNeededPreAllocationForOverhead;
+                INTERNAL::currentContext->AFTER_ENCODE_BUFFER_SIZE += constants::ANSI::maximumNeededPreAllocationForOverhead;
             }
         }
 
@@ -2378,6 +2783,8 @@ namespace GGUI{
          * @param Child_Buffer The child element's buffer.
          */
         void nestElement(GGUI::element* parent, GGUI::element* child, std::vector<GGUI::UTF>& Parent_Buffer, std::vector<GGUI::UTF>& Child_Buffer){
+            GGUI_TRACE_SCOPE("nestElement");
+
             INTERNAL::fittingArea Limits = getFittingArea(parent, child);
 
             for (int y = Limits.start.y; y < Limits.end.y; y++){
@@ -2411,12 +2818,25 @@ namespace GGUI{
      * requested to terminate (e.g., via signal or internal shutdown logic).
      */
     void waitForTermination() {
-        std::unique_lock lock(INTERNAL::atomic::mutex);
-        INTERNAL::atomic::condition.wait(lock, [&](){ return INTERNAL::requestTermination; });
+        // There is no other thread to signal us, so drive everything from here.
+        if (INTERNAL::cooperativeMode){
+            while (tick(-1));
+            return;
+        }
+
+        INTERNAL::currentContext->ticket.waitUntil([](){ return INTERNAL::requestTermination; });
     }
 
     element* getRoot() {
-        return INTERNAL::main;
+        return INTERNAL::currentContext->main;
+    }
+
+    void setBackend(INTERNAL::backend* output) {
+        INTERNAL::currentContext->output = output;
+    }
+
+    INTERNAL::backend* getBackend() {
+        return INTERNAL::currentContext->output;
     }
     
     /**
@@ -2429,20 +2849,36 @@ namespace GGUI{
     /**
      * @brief Updates the frame.
      * @details This function updates the frame. It's the main entry point for the rendering thread.
+     *          Only bumps the scene generation without waiting, a frame which is already ongoing renders again once it sees the new generation.
      * @note This function will return immediately if the rendering thread is paused.
      */
-    void updateFrame(){
-        std::unique_lock lock(INTERNAL::atomic::mutex);
+    /**
+     * @brief Requests a frame like updateFrame(), for the callers which are allowed to from the workers of the async handlers.
+     */
+    static void requestFrame(){
+        // A subtree being built is not visible yet, it gets its frame when attached.
+        if (INTERNAL::detachedRegistrations)
+            return;
 
-        // The rendering thread is either locked, already rendering or already requested to render.
-        if (INTERNAL::atomic::LOCKED > 0 || INTERNAL::atomic::pauseRenderThread == INTERNAL::atomic::status::NOT_INITIALIZED)
+        // The frame showing the changes of an input is measured until it is written. Async handlers get theirs into the posted commands instead.
+        if (INTERNAL::activeCause.id && !INTERNAL::currentContext->frameCause.id && !INTERNAL::HANDLER_POOL::isWorker())
+            INTERNAL::currentContext->frameCause = INTERNAL::activeCause;
+
+        // The batch makes one request for all of its changes once it ends.
+        if (INTERNAL::currentBatch){
+            INTERNAL::currentBatch->frameRequested = true;
             return;
+        }
 
-        // Give the rendering thread one ticket.
-        INTERNAL::atomic::pauseRenderThread = INTERNAL::atomic::status::REQUESTING_RENDERING;
+        INTERNAL::currentContext->ticket.request();
+    }
+
+    void updateFrame(){
+        // Async handlers may only change the elements through the posted commands, a direct change is made while the rendering thread runs.
+        if (INTERNAL::HANDLER_POOL::isWorker() && !INTERNAL::detachedRegistrations)
+            INTERNAL::HANDLER_POOL::reportDirectChange();
 
-        // Notify all waiting threads that the frame has been updated.
-        INTERNAL::atomic::condition.notify_all();
+        requestFrame();
     }
 
     /**
@@ -2450,15 +2886,21 @@ namespace GGUI{
      * @details This function pauses the rendering thread. The thread will wait until the rendering thread is resumed.
      */
     void pauseGGUI(){
-        std::unique_lock lock(INTERNAL::atomic::mutex);
-        
-        // Already paused via upper scope or if the rendering system hasn't been initialized yet, just no-op.
-        if (INTERNAL::atomic::LOCKED++ > 0 || INTERNAL::atomic::pauseRenderThread == INTERNAL::atomic::status::NOT_INITIALIZED)
+        // A subtree being built is not reachable from the other threads, so there is nothing to pause for.
+        if (INTERNAL::detachedRegistrations)
+            return;
+
+        // Already paused via upper scope, nothing being rendered or the rendering system hasn't been initialized yet, just no-op.
+        if (!INTERNAL::currentContext->ticket.hold())
+            return;
+
+        // Everything runs in this same thread, so nothing can be rendering right now.
+        if (INTERNAL::cooperativeMode)
             return;
 
         // await until the rendering thread has used it's rendering ticket.
-        INTERNAL::atomic::condition.wait(lock, []{
-            return INTERNAL::atomic::pauseRenderThread == INTERNAL::atomic::status::PAUSED;
+        INTERNAL::currentContext->ticket.waitUntil([]{
+            return INTERNAL::currentContext->ticket.getStatus() != INTERNAL::atomic::status::RENDERING;
         });
     }
 
@@ -2468,23 +2910,12 @@ namespace GGUI{
      * @param restore_render_to The status to restore the rendering thread to.
      */
     void resumeGGUI(){
-        // If not initialized, simply reset LOCKED counter (if needed) and no-op.
-        if (INTERNAL::atomic::pauseRenderThread == INTERNAL::atomic::status::NOT_INITIALIZED){
-            INTERNAL::atomic::LOCKED = 0; // Safety: ensure clean state for unit tests.
+        if (INTERNAL::detachedRegistrations)
             return;
-        }
-
-        {
-            std::unique_lock lock(INTERNAL::atomic::mutex);
 
-            if (--INTERNAL::atomic::LOCKED > 0)
-                return;
-
-            INTERNAL::atomic::condition.wait(lock, []{
-                // If the rendering thread is not locked, then the wait is over.
-                return INTERNAL::atomic::pauseRenderThread == INTERNAL::atomic::status::PAUSED;
-            });
-        }
+        // Still held via upper scope, or not initialized yet.
+        if (!INTERNAL::currentContext->ticket.release())
+            return;
 
         updateFrame();
     }
@@ -2495,8 +2926,14 @@ namespace GGUI{
      * @param f The function to call.
      */
     void pauseGGUI(std::function<void()> f){
+        // Async handlers must not wait for the rendering thread, their mutations are applied at the start of the next frame instead.
+        if (INTERNAL::HANDLER_POOL::isWorker()){
+            post(std::move(f));
+            return;
+        }
+
         // Fast path: if rendering thread not initialized (e.g. unit tests constructing elements only), just execute.
-        if (INTERNAL::atomic::pauseRenderThread == INTERNAL::atomic::status::NOT_INITIALIZED){
+        if (INTERNAL::currentContext->ticket.getStatus() == INTERNAL::atomic::status::NOT_INITIALIZED){
             f();
             return;
         }
@@ -2519,6 +2956,219 @@ namespace GGUI{
         resumeGGUI();
     }
 
+    /**
+     * @brief Queues a mutation to be applied by the rendering thread at the start of the next frame.
+     * @details Unlike pauseGGUI(), never waits for the rendering thread or for other threads, so it suits threads producing data at a high rate.
+     *          Only the producer which finds the queue empty requests the frame, the rest ride along with it.
+     * @param command The mutation to apply.
+     */
+    void post(std::function<void()> command){
+        // The frame requests of the command are attributed to the input which the posting handler reacts to.
+        if (INTERNAL::activeCause.id){
+            command = [cause = INTERNAL::activeCause, job = std::move(command)](){
+                INTERNAL::inputCause previous = std::exchange(INTERNAL::activeCause, cause);
+
+                // applyCommands() carries on after a throwing command, which must not leave its cause to the frames of the rest.
+                try{
+                    job();
+                }
+                catch(...){
+                    INTERNAL::activeCause = previous;
+                    throw;
+                }
+
+                INTERNAL::activeCause = previous;
+            };
+        }
+
+        if (INTERNAL::currentContext->commands.push(std::move(command)))
+            requestFrame();
+    }
+
+    /**
+     * @brief Applies many changes as one transaction, which costs one pause and one frame.
+     * @details The changes run under a single pauseGGUI(), with the frame requests and the deferred re-builds collected into the batch state
+     *          of this thread. At the end of the outermost batch the deferred jobs are run in order, and one frame is requested if any change asked for it.
+     * @param changes The changes to apply.
+     */
+    void batch(std::function<void()> changes){
+        // Nested batches just become a part of the outer one.
+        if (INTERNAL::currentBatch){
+            changes();
+            return;
+        }
+
+        // Posted commands are already applied together before one frame, so an async handler's batch is one command.
+        if (INTERNAL::HANDLER_POOL::isWorker()){
+            post(std::move(changes));
+            return;
+        }
+
+        INTERNAL::batchState state;
+        INTERNAL::currentBatch = &state;
+
+        pauseGGUI();
+
+        try{
+            changes();
+        }
+        catch(std::exception& e){
+            INTERNAL::reportStack("In given function to batch: arose problem: \n" + std::string(e.what()));
+        }
+
+        // The jobs may defer more work, which is appended and run within this same loop.
+        for (size_t i = 0; i < state.jobs.size(); i++){
+            std::function<void()> job = std::move(state.jobs[i].second);
+
+            state.jobIndices.erase(state.jobs[i].first);
+
+            if (job)
+                job();
+        }
+
+        // The frame request of resuming is merged into the batch too.
+        resumeGGUI();
+
+        INTERNAL::currentBatch = nullptr;
+
+        if (state.frameRequested)
+            updateFrame();
+    }
+
+    /**
+     * @brief Starts the countdown of the memory on the scheduling clock, so that a virtual clock also drives the memories.
+     */
+    memory::memory(size_t end, std::function<bool(GGUI::event*)>job, unsigned char Flags, std::string id){
+        startTime = INTERNAL::CLOCK::now();
+        endTime = end;
+        Job = job;
+        flags = Flags;
+        ID = id;
+    }
+
+    /**
+     * @brief Schedules a memory to run its job once its endTime has passed.
+     * @details A PROLONG_MEMORY memory with the same ID as an already scheduled one only restarts the countdown of the existing one.
+     *          Wakes the event loop, since the new deadline might be closer than the one it is sleeping towards.
+     * @param m The memory to schedule.
+     * @return Handle for prolonging, retriggering or forgetting the memory later.
+     */
+    memoryHandle addMemory(memory m){
+        memoryHandle handle = 0;
+
+        INTERNAL::currentContext->remember([&m, &handle](INTERNAL::memoryScheduler& self){
+            handle = self.add(std::move(m));
+        });
+
+        // The event loop might be sleeping past the new deadline.
+        INTERNAL::EVENT_LOOP::wake();
+
+        return handle;
+    }
+
+    /**
+     * @brief Restarts the countdown of the memory from now.
+     * @param handle Handle given by addMemory().
+     * @return False if the memory is no longer scheduled, or is currently running.
+     */
+    bool prolongMemory(memoryHandle handle){
+        bool result = false;
+
+        INTERNAL::currentContext->remember([handle, &result](INTERNAL::memoryScheduler& self){
+            result = self.prolong(handle, INTERNAL::CLOCK::now());
+        });
+
+        INTERNAL::EVENT_LOOP::wake();
+
+        return result;
+    }
+
+    /**
+     * @brief Runs the memory on the next event tick, regardless of its countdown.
+     * @param handle Handle given by addMemory().
+     * @return False if the memory is no longer scheduled, or is currently running.
+     */
+    bool retriggerMemory(memoryHandle handle){
+        bool result = false;
+
+        INTERNAL::currentContext->remember([handle, &result](INTERNAL::memoryScheduler& self){
+            result = self.retrigger(handle);
+        });
+
+        INTERNAL::EVENT_LOOP::wake();
+
+        return result;
+    }
+
+    /**
+     * @brief Removes the memory without running its job.
+     * @param handle Handle given by addMemory().
+     * @return False if the memory was already forgotten.
+     */
+    bool forgetMemory(memoryHandle handle){
+        bool result = false;
+
+        INTERNAL::currentContext->remember([handle, &result](INTERNAL::memoryScheduler& self){
+            result = self.forget(handle);
+        });
+
+        return result;
+    }
+
+    /**
+     * @brief Runs one iteration of GGUI in cooperative mode.
+     * @details Waits for input, signals and timed work at most the given timeout, or not at all if a frame is already due.
+     *          Then dispatches them, renders a frame if one was requested and writes out the queued reports.
+     *          Outside of cooperative mode the internal threads do all of this, so only waits for termination at most the given timeout.
+     * @param timeout Milliseconds to wait at most, 0 for not waiting and -1 for waiting until something happens.
+     * @return False once termination has been requested, after which tick() must not be called anymore.
+     */
+    bool tick(long long timeout){
+        if (!INTERNAL::cooperativeMode){
+            if (timeout < 0)
+                waitForTermination();
+            else
+                INTERNAL::currentContext->ticket.waitUntil([](){ return INTERNAL::requestTermination; }, std::chrono::milliseconds(timeout));
+
+            return !INTERNAL::requestTermination;
+        }
+
+        bool frameDue = INTERNAL::currentContext->ticket.getStatus() == INTERNAL::atomic::status::REQUESTING_RENDERING;
+
+        if (!INTERNAL::EVENT_LOOP::dispatch(frameDue ? 0 : (int)INTERNAL::Min(timeout, (long long)INT32_MAX))){
+            INTERNAL::currentContext->ticket.terminate();
+            return false;
+        }
+
+        if (INTERNAL::currentContext->ticket.take()){
+            INTERNAL::renderCycle();
+            INTERNAL::finishRenderCycle();
+        }
+
+        INTERNAL::flushReports();
+
+        return !INTERNAL::requestTermination;
+    }
+
+    /**
+     * @brief Gives the descriptor which the application can poll in its own loop before calling tick().
+     * @return The epoll descriptor of the event loop, or -1 if it is not active.
+     */
+    int getEventHandle(){
+        return INTERNAL::EVENT_LOOP::getHandle();
+    }
+
+    /**
+     * @brief Calculates how long the application can wait before calling tick() again.
+     * @return Milliseconds until the next deadline, 0 if a frame is already due and -1 if nothing is scheduled.
+     */
+    long long getNextDeadline(){
+        if (INTERNAL::currentContext->ticket.getStatus() == INTERNAL::atomic::status::REQUESTING_RENDERING)
+            return 0;
+
+        return INTERNAL::EVENT_LOOP::nextDeadline();
+    }
+
     /**
      * @brief Use GGUI in a simple way.
      * @details This is a simple way to use GGUI. It will pause all other GGUI internal threads, initialize GGUI, add all the elements to the root window, sleep for the given amount of milliseconds, and then exit GGUI.
@@ -2537,16 +3187,14 @@ namespace GGUI{
             // Now we can safely insert addons while taking into notion user configured borders and other factors which may impact the usable width.
             initAddons();
 
-            if (SETTINGS::enableDRM) {
-                INTERNAL::DRM::retryDRMConnect();
-            }
+            INTERNAL::currentContext->output->connect();
         });
         
         // We need to call the Mains own on_init manually, since it was already called once in the initGGUI();
         getRoot()->check(INTERNAL::STATE::INIT);
 
         // Sleep for the given amount of milliseconds.
-        std::this_thread::sleep_for(std::chrono::milliseconds(Sleep_For));
+        INTERNAL::CLOCK::sleepFor(std::chrono::milliseconds(Sleep_For));
     }
 
     /**
@@ -2572,9 +3220,9 @@ namespace GGUI{
         element* Result = nullptr;
 
         // Check if the element is in the global Element_Names map.
-        if (INTERNAL::elementNames.find(name) != INTERNAL::elementNames.end()){
+        if (INTERNAL::currentContext->elementNames.find(name) != INTERNAL::currentContext->elementNames.end()){
             // If the element exists, assign it to the result.
-            Result = INTERNAL::elementNames[name];
+            Result = INTERNAL::currentContext->elementNames[name];
         }
 
         // Return the result.
@@ -9,6 +9,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <memory>
 
 #include "../elements/textField.h"
 #include "../elements/listView.h"
@@ -21,6 +22,7 @@
 #include "../core/utils/style.h"
 #include "../core/utils/conveyorAllocator.h"
 #include "./utils/utils.h"
+#include "./utils/clock.h"
 
 //GGUI uses the ANSI escape code
 //https://en.wikipedia.org/wiki/ANSI_escape_code
@@ -29,6 +31,7 @@ namespace GGUI{
     // autoGen: Ignore start
     namespace INTERNAL{
         class bufferCapture;
+        class backend;
 
         static struct {
             bool screenCaptureEnabled = false;
@@ -36,6 +39,7 @@ namespace GGUI{
             bool cursorHidden = false;
             bool initialized = false;
             bool extendedIntoSGRMode = false;
+            bool bracketedPasteEnabled = false;
             bool mousePositionSaved = false;
         #if _WIN32
             unsigned long previousWindowsCodepage = 0;
@@ -44,53 +48,212 @@ namespace GGUI{
             bool deInitialized = false;
         } platformState;
 
-        namespace atomic{
-            enum class status{
-                PAUSED,
-                REQUESTING_RENDERING,
-                RENDERING,
-                NOT_INITIALIZED
-            };
+        // Inits with 'NOW()' when created
+        class buttonState {
+        public:
+            bool state;
+            CLOCK::timePoint captureTime;
 
-            extern int LOCKED;
+            buttonState(bool State = false) : state(State), captureTime(CLOCK::now()) {}
+        };
 
-            extern std::mutex mutex;
-            extern std::condition_variable condition;
+        // How long the phases of the last presented frame took in nanoseconds, on the real clock.
+        struct frameTimings{
+            long long render = 0;       // main->render()
+            long long encode = 0;       // Encoding the cells for the output, zero if the backend sends them as they are.
+            long long output = 0;       // Writing or sending the frame.
+        };
 
-            extern status pauseRenderThread;
-        }
+        // The raw input which a change was caused by, carried from its read into the frame which shows the change.
+        struct inputCause{
+            unsigned long long id = 0;                                  // Zero when there is no cause.
+            std::chrono::high_resolution_clock::time_point arrival;     // When queryInputs() or DRM::pollInputs() returned the input, on the real clock.
+        };
 
-        // Inits with 'NOW()' when created
-        class buttonState {
+        /**
+         * @brief The state of one GGUI instance: its element tree, frame buffers, input and event handling, scheduled memories and style classes.
+         * @details Each thread works on the context pointed by currentContext, which by default is the one shared by the whole process.
+         *          The threads started by initGGUI() and the async handler workers inherit the context of the thread which started them,
+         *          so separate contexts can be driven concurrently from their own threads. Each has its own render ticket, so pausing one
+         *          does not stall the others, and its own translation of input. The immutable resources, like the glyph, border and colour
+         *          tables, are shared by all contexts. The terminal is process wide, its resizes go to terminalContext.
+         */
+        class context{
         public:
-            bool state;
-            std::chrono::high_resolution_clock::time_point captureTime;
+            element* main = nullptr;
+
+            std::vector<UTF>* abstractFrameBuffer = nullptr;            //2D clean vector without bold nor color
+            std::string* frameBuffer = nullptr;                         //string with bold and color, this what gets drawn to console.
+            std::string encodedFrame;                                   // Where frameBuffer points to, reused from frame to frame.
+
+            // Cleared by the main element when it renders changes, so that an unchanged frame is not sent again.
+            bool identicalFrame = true;
+
+            // Sizes of the last frame before and after encodeBuffer(), for the statistics.
+            int BEFORE_ENCODE_BUFFER_SIZE = 0;
+            int AFTER_ENCODE_BUFFER_SIZE = 0;
+
+            frameTimings lastFrame;
+
+            // Fingerprints of the cells of the last presented frame, for counting the changed cells into the metrics.
+            std::vector<uint64_t> cellFingerprints;
+
+            // The input latency: the raw input not yet translated, the oldest input whose changes wait for a frame, and the one the frame being written shows.
+            inputCause rawInput;
+            inputCause frameCause;
+            inputCause presentingCause;
+            unsigned long long lastCauseId = 0;
+
+            unsigned int maxWidth = 0;
+            unsigned int maxHeight = 0;
+
+            // Where the frames go and the inputs come from, chosen by initGGUI() unless set with GGUI::setBackend().
+            backend* output = nullptr;
+
+            // Hands the elements between the rendering thread of this context and the rest, see pauseGGUI(), resumeGGUI() and updateFrame().
+            atomic::renderTicket ticket;
+
+            // Work which the rendering thread has to do before its next frame, like a resize.
+            atomic::guard<carry> Carry_Flags;
+
+            atomic::guard<memoryScheduler> remember;
+
+            // The canvases with animated sprites, advanced by the event tasks.
+            std::unordered_map<GGUI::canvas*, bool> multiFrameCanvas;
+
+            // Mutations posted by other threads with GGUI::post(), applied by the rendering thread at the start of each frame.
+            atomic::mpscQueue<std::function<void()>> commands;
+
+            std::vector<element*> eventHandlers;
+            std::vector<input*> inputs;
+
+            // Inputs released by the event handler, given out again by takeInput() so that typing does not allocate.
+            std::vector<std::unique_ptr<input>> spareInputs;
+
+            std::unordered_map<std::string, element*> elementNames;
+
+            element* focusedOn = nullptr;
+            element* hoveredOn = nullptr;
+
+            // The translation of the raw input, which carries over from one read to the next.
+            IVector3 mouse;
+            std::unordered_map<std::string_view, buttonState> KEYBOARD_STATES;
+            std::unordered_map<std::string_view, buttonState> PREVIOUS_KEYBOARD_STATES;
 
-            buttonState(bool State = false) : state(State), captureTime(std::chrono::high_resolution_clock::now()) {}
+            bool pasteInProgress = false;       // True between BRACKETED_PASTE_START and BRACKETED_PASTE_END, even across multiple reads.
+            std::string pasteBuffer;            // Accumulates the pasted text until BRACKETED_PASTE_END arrives.
+        #if !_WIN32
+            static constexpr unsigned int Raw_Input_Capacity = UINT8_MAX * 2;
+            unsigned char Raw_Input[Raw_Input_Capacity];    // Read by queryInputs() or given to setRawInput(), waiting for translateInputs().
+            ssize_t Raw_Input_Size = 0;
+            std::string pasteStartCarry;        // The beginning of a BRACKETED_PASTE_START which ended a read, put in front of the next read.
+        #endif
+
+            atomic::guard<std::unordered_map<int, styling>> classes;
+            std::unordered_map<std::string, int> classNames;
+
+            // Reused by liquifyUTFText() from frame to frame, grown to the size of the frame on first use.
+            conveyorAllocator<compactString> liquifiedText;
+            superString<GGUI::constants::ANSI::maximumNeededPreAllocationForEncodedSuperString> liquifyContainer;
+
+            context();
+            ~context();
+            context(const context&) = delete;
+            context& operator=(const context&) = delete;
         };
 
-        extern std::vector<UTF>* abstractFrameBuffer;                 //2D clean vector without bold nor color
-        extern std::string* frameBuffer;                                //string with bold and color, this what gets drawn to console.
+        // The context used by the threads which have not been given one.
+        extern context defaultContext;
+
+        // The context of this thread, see context.
+        extern thread_local context* currentContext;
+
+        // The context which the terminal belongs to, its resize signals are carried into it.
+        extern std::atomic<context*> terminalContext;
 
         extern std::vector<INTERNAL::bufferCapture*> globalBufferCaptures;
 
-        extern unsigned int maxWidth;
-        extern unsigned int maxHeight;
+        // Set on the thread which is building a GGUI::subtree, collects the registrations which have to wait until the subtree is attached, each with the element it belongs to.
+        extern thread_local std::vector<std::pair<const void*, std::function<void()>>>* detachedRegistrations;
 
-        extern atomic::guard<std::vector<memory>> remember;
+        // How many released inputs a context keeps for reuse, the rest are deleted.
+        constexpr size_t maxSpareInputs = 64;
 
-        extern std::vector<element*> eventHandlers;
-        extern std::vector<input*> inputs;
-        
-        extern std::unordered_map<std::string, element*> elementNames;
+        /**
+         * @brief Gives a new input for currentContext->inputs, reusing a released one when there is.
+         * @param args The arguments of the input constructor.
+         */
+        template<typename... Args>
+        input* takeInput(Args&&... args){
+            std::vector<std::unique_ptr<input>>& spare = currentContext->spareInputs;
 
-        extern element* focusedOn;
-        extern element* hoveredOn;
+            if (spare.empty())
+                return new input(std::forward<Args>(args)...);
 
-        extern IVector3 mouse;    
-        extern bool mouseMovementEnabled;
+            input* reused = spare.back().release();
+            spare.pop_back();
+
+            *reused = input(std::forward<Args>(args)...);
+            return reused;
+        }
+
+        /**
+         * @brief Gives back an input taken out of currentContext->inputs, instead of deleting it.
+         */
+        extern void releaseInput(input* used);
+
+        /**
+         * @brief Runs the job which registers into the registries of the context shared with its other threads, like elementNames, eventHandlers and multiFrameCanvas.
+         * @details While a GGUI::subtree is being built on this thread, the job is deferred until the subtree is attached,
+         *          since the other threads may be reading the registries meanwhile.
+         * @param owner The element the job registers, its deferred jobs are dropped if it is destroyed before the attach.
+         * @param job The registration.
+         */
+        template<typename F>
+        void registerShared(const void* owner, F&& job){
+            if (detachedRegistrations)
+                detachedRegistrations->emplace_back(owner, std::forward<F>(job));
+            else
+                job();
+        }
+
+        /**
+         * @brief Drops the registrations deferred for the element, used by elements destroyed while their subtree is being built.
+         * @param owner The owner given to registerShared().
+         */
+        extern void forgetRegistrations(const void* owner);
+
+        // State of a GGUI::batch() running on this thread.
+        struct batchState{
+            // Work which only needs to be done once per element at the end of the batch, in the order it was first deferred.
+            std::vector<std::pair<const void*, std::function<void()>>> jobs;
+            std::unordered_map<const void*, size_t> jobIndices;
+
+            // Whether any of the changes asked for a frame.
+            bool frameRequested = false;
+        };
+
+        // Set on the thread running the outermost GGUI::batch().
+        extern thread_local batchState* currentBatch;
+
+        // The input whose handlers run on this thread, the frames they request are attributed to it. Carried into the async handlers and posted commands.
+        extern thread_local inputCause activeCause;
+
+        /**
+         * @brief Runs the job right away, or at the end of the current GGUI::batch() if there is one.
+         * @details Within a batch only the last job given for the same key is run, so re-building something after each change is done only once.
+         * @param key Identifies what the job re-builds, like the element it belongs to.
+         * @param job The work to do.
+         */
+        extern void deferToBatchEnd(const void* key, std::function<void()> job);
 
-        extern std::unordered_map<std::string_view, buttonState> KEYBOARD_STATES;
+        /**
+         * @brief Drops the job deferred for the key, used by elements destroyed within a batch.
+         * @param key The key given to deferToBatchEnd().
+         */
+        extern void forgetBatched(const void* key);
+
+        extern bool mouseMovementEnabled;
 
         // Maximum allowed delay between passive event loop iterations.
         inline constexpr time_t MAX_UPDATE_SPEED = TIME::SECOND;
@@ -104,12 +267,7 @@ namespace GGUI{
         extern unsigned long long renderDelay;    // describes how long previous render cycle took in ms
         extern unsigned long long eventDelay;     // describes how long previous memory tasks took in ms
 
-        extern atomic::guard<std::unordered_map<int, styling>> classes;
-        extern std::unordered_map<std::string, int> classNames;
-
-        extern element* main;  
-
-        extern std::unordered_map<GGUI::canvas*, bool> multiFrameCanvas;
+        extern bool cooperativeMode;    // Set when the application drives GGUI with tick() instead of the internal threads.
 
         extern float eventThreadLoad;  // Describes the load of animation and events from 0.0 to 1.0. Will reduce the event thread pause.
 
@@ -147,15 +305,40 @@ namespace GGUI{
         extern void renderFrame();
 
         /**
-         * @brief Updates the maximum width and height of the console window.
-         * 
-         * This function retrieves the current console screen buffer information and updates
-         * the maximum width and height based on the console window dimensions. If the console
-         * information is not retrieved correctly, an error message is reported. Additionally,
-         * if the main window is active, its dimensions are set to the updated maximum width
-         * and height.
+         * @brief Updates the maximum width and height from the backend of the current context.
+         * @details Keeps the previous size if the backend does not know it, like the DRM backend before it is connected.
+         *          If the main element exists, its dimensions are set to the new size.
          */
         extern void updateMaxWidthAndHeight();
+
+        /**
+         * @brief Gives the size of the terminal or console window, used by the terminal backend.
+         * @return False if the size could not be queried.
+         */
+        extern bool getTerminalSize(unsigned int& width, unsigned int& height);
+
+        /**
+         * @brief Checks whether STDIN is connected to an interactive terminal (TTY).
+         */
+        extern bool Is_Stdin_TTY();
+
+        /**
+         * @brief Translates the raw input read by queryInputs() or given with setRawInput().
+         * @return True if there are mouse button transitions or scrolls left for a next batch.
+         */
+        extern bool Translate_Inputs();
+
+        /**
+         * @brief Replaces the raw input with the given bytes, as if queryInputs() had read them.
+         * @details The beginning of a paste start marker which ended the previous input is kept in front of them, as with queryInputs().
+         * @return How many of the bytes fit into the raw input.
+         */
+        extern size_t setRawInput(const char* data, size_t size);
+
+        /**
+         * @brief Marks the raw input as arrived now, unless older raw input is still waiting to be translated.
+         */
+        extern void stampRawInput();
             
         /**
          * @brief Queries and appends new input records to the existing buffered input.
@@ -172,6 +355,17 @@ namespace GGUI{
          */
         extern void queryInputs();
 
+        /**
+         * @brief Feeds raw input bytes into the currently open bracketed paste.
+         * @details Bytes are appended into the pasteBuffer of the context until BRACKETED_PASTE_END is found, which may also straddle two separate reads.
+         *          When the end marker is found, the whole paste is pushed as a single constants::PASTE input with the text in input::text,
+         *          where carriage returns are normalized into newlines, since terminals send pasted line breaks as '\r'.
+         * @param data Raw bytes following BRACKETED_PASTE_START, or the start of a new read while pasteInProgress is set.
+         * @param size Amount of bytes in data.
+         * @return Amount of bytes consumed from data, including the end marker. Anything past it is normal input again.
+         */
+        extern size_t consumeBracketedPaste(const unsigned char* data, size_t size);
+
         extern void SignalThreadTermination();
 
         /**
@@ -237,12 +431,21 @@ namespace GGUI{
         extern conveyorAllocator<compactString> liquifyUTFText(const std::vector<GGUI::UTF>* Text, unsigned int& Liquefied_Size, int Width, int Height);
         
         /**
-         * @brief This function is a helper for the smart memory system to recall which tasks should be prolonged, and which should be deleted.
-         * @details This function is a lambda function that is used by the Atomic::Guard class to prolong or delete memories in the smart memory system.
-         *          It takes a pointer to a vector of Memory objects and prolongs or deletes the memories in the vector based on the time difference between the current time and the memory's start time.
+         * @brief Runs the due memories of the smart memory system.
+         * @details The due memories are taken out of the scheduler, so their jobs run without holding the remember guard.
+         *          Afterwards retriggering memories are scheduled again from now, successful ones are removed and failed ones are retried later.
+         *          Also updates the event thread load from the time left to the next deadline.
          */
         extern void recallMemories();
 
+        /**
+         * @brief Runs the commands posted with GGUI::post() in the order they were posted.
+         * @details Called by the rendering thread at the start of each frame, while no other thread is allowed to touch the elements.
+         *          Exceptions thrown by a command are reported and don't stop the following commands.
+         * @return The number of commands applied.
+         */
+        extern size_t applyCommands();
+
         /**
          * @brief Removes focus from the currently focused element and its children.
          * @details This function checks if there is a currently focused element.
@@ -421,6 +624,19 @@ namespace GGUI{
      * @return A pointer to the main element of the GGUI system.
      */
     extern element* getRoot();
+
+    /**
+     * @brief Sets where the frames are output to and the inputs read from, call it before GGUI().
+     * @details Without it the backend is chosen by the settings, see INTERNAL::selectBackend().
+     *          A headless backend lets the application render without a terminal and read the frames from it.
+     * @param output The backend, which has to outlive GGUI.
+     */
+    extern void setBackend(INTERNAL::backend* output);
+
+    /**
+     * @brief Gives the backend in use, or nullptr before GGUI() has chosen one.
+     */
+    extern INTERNAL::backend* getBackend();
     
     /**
      * @brief Register cleanup functions to be called on SIGINT, SIGTERM, std::exit(), std::quick_exit(), std::termination
@@ -450,10 +666,84 @@ namespace GGUI{
     /**
      * @brief Pauses all other GGUI internal threads and calls the given function.
      * @details This function will pause all other GGUI internal threads and call the given function.
+     *          Called from an async event handler, the function is given to post() instead, so the worker never waits for the rendering thread.
      * @param f The function to call.
      */
     extern void pauseGGUI(std::function<void()> f);
 
+    /**
+     * @brief Queues a mutation to be applied by the rendering thread at the start of the next frame.
+     * @details Unlike pauseGGUI(), never waits for the rendering thread or for other threads, so it suits threads producing data at a high rate.
+     *          Commands are applied in the order they were posted and a frame is requested for them automatically.
+     *          The command must not wait for the rendering thread itself, so no pauseGGUI() inside of it.
+     * @param command The mutation to apply.
+     */
+    extern void post(std::function<void()> command);
+
+    /**
+     * @brief Applies many changes as one transaction, which costs one pause and one frame.
+     * @details The changes run under a single pauseGGUI(). Meanwhile the setters only stain the elements and the frame requests they make
+     *          are merged into one, which is made when the outermost batch ends. Re-building the text cache of a textField is done once
+     *          at the end no matter how many times its text was changed, and the dynamic styles are evaluated once by the frame.
+     *          Batches can be nested, only the outermost one commits. Called from an async event handler, the changes are posted as one command.
+     * @param changes The changes to apply.
+     */
+    extern void batch(std::function<void()> changes);
+
+    /**
+     * @brief Schedules a memory to run its job once its endTime has passed.
+     * @details A PROLONG_MEMORY memory with the same ID as an already scheduled one only restarts the countdown of the existing one.
+     *          A RETRIGGER memory is scheduled again after each run, other memories are forgotten once their job returns true.
+     * @param m The memory to schedule.
+     * @return Handle for prolonging, retriggering or forgetting the memory later.
+     */
+    extern memoryHandle addMemory(memory m);
+
+    /**
+     * @brief Restarts the countdown of the memory from now.
+     * @param handle Handle given by addMemory().
+     * @return False if the memory is no longer scheduled, or is currently running.
+     */
+    extern bool prolongMemory(memoryHandle handle);
+
+    /**
+     * @brief Runs the memory on the next event tick, regardless of its countdown.
+     * @param handle Handle given by addMemory().
+     * @return False if the memory is no longer scheduled, or is currently running.
+     */
+    extern bool retriggerMemory(memoryHandle handle);
+
+    /**
+     * @brief Removes the memory without running its job.
+     * @param handle Handle given by addMemory().
+     * @return False if the memory was already forgotten.
+     */
+    extern bool forgetMemory(memoryHandle handle);
+
+    /**
+     * @brief Runs one iteration of GGUI when it was started with the cooperative setting (--cooperative).
+     * @details In cooperative mode GGUI starts no threads of its own, instead the application calls tick() from its own loop.
+     *          Each call dispatches the pending input, signals and timed work, renders a frame if one was requested and writes out the reports.
+     *          Without an own loop, waitForTermination() calls tick() until termination.
+     *          Cooperative mode needs the Linux event loop and is not available with DRM, in which case GGUI falls back into its threads.
+     * @param timeout Milliseconds to wait at most for something to happen, 0 for not waiting and -1 for waiting until something happens.
+     * @return False once termination has been requested, after which tick() must not be called anymore.
+     */
+    extern bool tick(long long timeout = 0);
+
+    /**
+     * @brief Gives a descriptor which becomes readable whenever tick() has something to do, for polling it among the application's own descriptors.
+     * @details The descriptor also covers the timed work, but not the frames requested from the application's own thread, see getNextDeadline().
+     * @return The descriptor, or -1 if there is none.
+     */
+    extern int getEventHandle();
+
+    /**
+     * @brief Calculates how long the application can wait before calling tick() again.
+     * @return Milliseconds until the next deadline, 0 if a frame is already due and -1 if there is nothing scheduled.
+     */
+    extern long long getNextDeadline();
+
     /**
      * @brief Use GGUI in a simple way.
      * @details This is a simple way to use GGUI. It will pause all other GGUI internal threads, initialize GGUI, add all the elements to the root window, sleep for the given amount of milliseconds, and then exit GGUI.
@@ -3,7 +3,12 @@
 #include "./utils/fileStreamer.h"
 #include "./utils/settings.h"
 
-#include "./utils/drm.h"
+#include "./utils/eventLoop.h"
+#include "./utils/backend.h"
+#include "./utils/trace.h"
+#include "./utils/metrics.h"
+#include "./utils/profiler.h"
+#include "./utils/allocations.h"
 
 #include <thread>
 #include <memory>
@@ -14,29 +19,160 @@ namespace GGUI{
     class element;
     namespace INTERNAL{
 
-        extern element* main;
+        extern std::chrono::high_resolution_clock::time_point Previous_Time;
+        extern std::chrono::high_resolution_clock::time_point Current_Time;
+
+        extern sig_atomic_t requestTermination;
 
-        namespace atomic{
-            enum class status;
+        /**
+         * @brief Records the presented frame into the frame metrics.
+         * @param nanoseconds How long the whole renderCycle() took.
+         */
+        static void recordFrameMetrics(uint64_t nanoseconds){
+            static METRICS::counter& presented = METRICS::getCounter("frames.presented");
+            static METRICS::counter& dropped = METRICS::getCounter("frames.dropped");
+            static METRICS::histogram& frameTime = METRICS::getHistogram("frame.time");
+            static METRICS::histogram& renderTime = METRICS::getHistogram("frame.render");
+            static METRICS::histogram& encodeTime = METRICS::getHistogram("frame.encode");
+            static METRICS::histogram& outputTime = METRICS::getHistogram("frame.output");
+
+            presented.add();
+            frameTime.record(nanoseconds);
+            renderTime.record(currentContext->lastFrame.render);
+            encodeTime.record(currentContext->lastFrame.encode);
+            outputTime.record(currentContext->lastFrame.output);
+
+            if (nanoseconds > METRICS::frameBudgetNanoseconds)
+                dropped.add();
+        }
 
-            extern std::mutex mutex;
-            extern std::condition_variable condition;
+        /**
+         * @brief Counts the cells which differ from the previous frame of the context, and remembers the frame for the next count.
+         * @details Each cell is remembered as a fingerprint of its colours and a hash of its text, so a changed glyph may rarely go uncounted.
+         */
+        static size_t countChangedCells(const std::vector<UTF>& cells){
+            std::vector<uint64_t>& previous = currentContext->cellFingerprints;
+            bool resized = previous.size() != cells.size();
+
+            if (resized)
+                previous.assign(cells.size(), 0);
+
+            size_t changed = 0;
+            for (size_t i = 0; i < cells.size(); i++){
+                const UTF& cell = cells[i];
+
+                uint64_t textHash = 0;
+                for (size_t j = 0; j < cell.size; j++)
+                    textHash = textHash * 31 + (unsigned char)cell.text[j];
+
+                uint64_t fingerprint =
+                    ((uint64_t)cell.foreground.red << 40) | ((uint64_t)cell.foreground.green << 32) | ((uint64_t)cell.foreground.blue << 24) |
+                    ((uint64_t)cell.background.red << 16) | ((uint64_t)cell.background.green << 8) | (uint64_t)cell.background.blue |
+                    ((textHash & 0xFFFF) << 48);
+
+                changed += resized || previous[i] != fingerprint;
+                previous[i] = fingerprint;
+            }
 
-            extern status pauseRenderThread;
+            return changed;
         }
 
-        extern std::chrono::high_resolution_clock::time_point Previous_Time;
-        extern std::chrono::high_resolution_clock::time_point Current_Time;
+        /**
+         * @brief Renders one frame.
+         * @details Applies the commands posted with GGUI::post(), processes a pending resize, renders the main element and
+         *          presents the changes with the backend of the context. Measures the time taken into renderDelay.
+         *          Expects the caller to hold the rendering ticket, so that no other thread touches the elements meanwhile.
+         */
+        void renderCycle(){
+            GGUI_TRACE_SCOPE("renderCycle");
 
-        extern atomic::guard<carry> Carry_Flags;
-        extern sig_atomic_t requestTermination;
+            uint64_t allocationsBefore = ALLOCATIONS::onThisThread();
+
+            // Save current time, we have the right to overwrite unto the other thread, since they always run after each other and not at same time.
+            Previous_Time = CLOCK::now();
+
+            // Apply the mutations posted from other threads before they are rendered.
+            applyCommands();
+
+            if (currentContext->main){
+
+                // Process the previous carry flags
+                currentContext->Carry_Flags([](carry& previous_carry){
+                    if (previous_carry.resize){
+                        // Clear the previous carry flag
+                        previous_carry.resize = false;
+
+                        updateMaxWidthAndHeight();
+                    }
+                });
+
+                currentContext->identicalFrame = true; // Assume that the incoming frame will be identical.
+
+                // Main is zero size, before a remote backend sends us the correct window size.
+                bool waitingForSize = currentContext->main->getWidth() == 0 && currentContext->main->getHeight() == 0;
 
-        extern void Translate_Inputs();
+                // Skip rendering until the backend tells us the window size.
+                if (!waitingForSize) {
+                    static METRICS::counter& identicalFrames = METRICS::getCounter("frames.identical");
+                    static METRICS::histogram& cellsChanged = METRICS::getHistogram("frame.cellsChanged", "cells");
 
-        bool identicalFrame = true;
+                    auto renderStart = std::chrono::high_resolution_clock::now();
 
-        int BEFORE_ENCODE_BUFFER_SIZE = 0;
-        int AFTER_ENCODE_BUFFER_SIZE = 0;
+                    {
+                        GGUI_TRACE_SCOPE("render");
+                        PROFILER::renderScope cost(nullptr, currentContext->main);
+                        currentContext->abstractFrameBuffer = &currentContext->main->render();
+                    }
+
+                    currentContext->lastFrame.render = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - renderStart).count();
+
+                    if (!currentContext->identicalFrame){
+                        cellsChanged.record(countChangedCells(*currentContext->abstractFrameBuffer));
+
+                        // The backend records the input latency once it has written this frame.
+                        currentContext->presentingCause = std::exchange(currentContext->frameCause, inputCause());
+
+                        withBackend(currentContext->output, [](auto& output){
+                            output.present(*currentContext->abstractFrameBuffer, currentContext->main->getWidth(), currentContext->main->getHeight());
+                        });
+                    }
+                    else{
+                        identicalFrames.add();
+
+                        // The input changed nothing visible, so there is no latency to measure.
+                        currentContext->frameCause = inputCause();
+
+                        withBackend(currentContext->output, [](auto& output){
+                            output.presentIdentical();
+                        });
+                    }
+                }
+            }
+
+            // Check the difference of the time captured before render and now after render
+            Current_Time = CLOCK::now();
+
+            renderDelay = std::chrono::duration_cast<std::chrono::milliseconds>(Current_Time - Previous_Time).count();
+
+            if (currentContext->main && !currentContext->identicalFrame)
+                recordFrameMetrics(std::chrono::duration_cast<std::chrono::nanoseconds>(Current_Time - Previous_Time).count());
+
+            if (ALLOCATIONS::isCounting()){
+                // Read before the first use creates the histogram, so that it is not counted into the first frame.
+                uint64_t allocated = ALLOCATIONS::onThisThread() - allocationsBefore;
+
+                static METRICS::histogram& frameAllocations = METRICS::getHistogram("frame.allocations", "allocations");
+                frameAllocations.record(allocated);
+            }
+        }
+
+        /**
+         * @brief Gives the rendering ticket back after renderCycle().
+         * @details Pauses the rendering and notifies all waiting threads, or requests another frame if the scene generation moved meanwhile.
+         */
+        void finishRenderCycle(){
+            currentContext->ticket.finish();
+        }
 
         /**
          * @brief The Renderer function is responsible for managing the rendering loop.
@@ -45,96 +181,32 @@ namespace GGUI{
          * 
          * The function performs the following steps:
          * 1. Waits for the render thread to be resumed.
-         * 2. Saves the current time.
-         * 3. Checks if the rendering scheduler needs to be terminated.
-         * 4. Processes carry flags and updates the maximum width and height if needed.
-         * 5. Renders the main frame buffer.
-         * 6. Encodes the buffer for optimization.
-         * 7. Converts the abstract frame buffer to a string and renders the frame.
-         * 8. Calculates the render delay.
-         * 9. Pauses the render thread and notifies all waiting threads.
+         * 2. Checks if the rendering scheduler needs to be terminated.
+         * 3. Renders the frame with renderCycle().
+         * 4. Gives the ticket back with finishRenderCycle().
          */
         void renderer(){
             while (true){
-                {
-                    std::unique_lock lock(atomic::mutex);
-                    atomic::condition.wait(lock, [&](){ return atomic::pauseRenderThread == atomic::status::REQUESTING_RENDERING || requestTermination; });
-
-                    atomic::pauseRenderThread = atomic::status::RENDERING;
-                }
-
-                // Save current time, we have the right to overwrite unto the other thread, since they always run after each other and not at same time.
-                Previous_Time = std::chrono::high_resolution_clock::now();
+                currentContext->ticket.waitUntil([](){ return currentContext->ticket.getStatus() == atomic::status::REQUESTING_RENDERING || requestTermination; });
 
                 // Check for carry signals if the rendering scheduler needs to be terminated.
                 if (requestTermination){
                     break;  // Break out of the loop if the terminate flag is set
                 }
 
-                if (main){
-
-                    // Process the previous carry flags
-                    Carry_Flags([](carry& previous_carry){
-                        if (previous_carry.resize){
-                            // Clear the previous carry flag
-                            previous_carry.resize = false;
-
-                            updateMaxWidthAndHeight();
-                        }
-                    });
-
-                    identicalFrame = true; // Assume that the incoming frame will be identical.
-
-                    // Main is zero size, before the DRM sends us the correct window size.
-                    bool FirstDRMRender = GGUI::SETTINGS::enableDRM && (main->getWidth() == 0 && main->getHeight() == 0);
-
-                    // Skip rendering until DRM sends us the window size.
-                    if (!FirstDRMRender) {
-                        abstractFrameBuffer = &main->render();
-
-                        if (!identicalFrame){
-                            if (SETTINGS::enableDRM) {
-                                DRM::sendBuffer(*abstractFrameBuffer);
-                            }
-                            else {
-                                // ENCODE for optimize
-                                encodeBuffer(abstractFrameBuffer);
-
-                                unsigned int Liquefied_Size = 0;
-                                conveyorAllocator<compactString> CS_Buffer = liquifyUTFText(abstractFrameBuffer, Liquefied_Size, main->getWidth(), main->getHeight());
-                                
-                                frameBuffer = toString(CS_Buffer, Liquefied_Size);
-                                
-                                renderFrame();
-                            }
-                        }
-                        else{
-                        #ifdef GGUI_DEBUG
-                            LOGGER::log("Saved frame");
-                        #endif
-
-                            if (SETTINGS::enableDRM) {
-                                std::vector<UTF> empty;
-                                DRM::sendBuffer(empty);
-                            }
-                        }
-                    }
-                }
-
-                // Check the difference of the time captured before render and now after render
-                Current_Time = std::chrono::high_resolution_clock::now();
+                // A pauseGGUI() deferred the request in between, resumeGGUI() will request it again.
+                if (!currentContext->ticket.take())
+                    continue;
 
-                renderDelay = std::chrono::duration_cast<std::chrono::milliseconds>(Current_Time - Previous_Time).count();
+                renderCycle();
 
-                {
-                    std::unique_lock lock(atomic::mutex);
-                    // Now for itself set it to sleep.
-                    atomic::pauseRenderThread = atomic::status::PAUSED;
-                    atomic::condition.notify_all();
-                }
+                finishRenderCycle();
             }
 
             LOGGER::log("Render thread terminated!");
+
+            // Let Cleanup() know that this thread won't touch anything anymore.
+            currentContext->ticket.terminate();
         }
 
         /**
@@ -142,11 +214,14 @@ namespace GGUI{
          * @details This function goes through each file stream handle in the `fileStreamerHandles` map.
          *          It checks if the handle is not a standard output stream, and if so, calls the `Changed` method
          *          on the file stream to trigger any associated change events.
+         *          Files watched by the event loop are skipped, since the event loop calls `Changed` when the file is actually modified.
          */
         void Go_Through_File_Streams(){
+            GGUI_TRACE_SCOPE("fileStreams");
+
             for (auto& pair : fileStreamerHandles){
                 auto& handle = pair.second;
-                if (handle && handle->getType() == FILE_STREAM_TYPE::READ){
+                if (handle && handle->getType() == FILE_STREAM_TYPE::READ && !EVENT_LOOP::isWatched(pair.first)){
                     handle->changed();
                 }
             }
@@ -160,7 +235,7 @@ namespace GGUI{
          */
         void Refresh_Multi_Frame_Canvas() {
             // Iterate over each multi-frame canvas
-            for (auto i : multiFrameCanvas) {
+            for (auto i : currentContext->multiFrameCanvas) {
                 // Advance the animation to the next frame
                 i.first->setNextAnimationFrame();
 
@@ -169,65 +244,74 @@ namespace GGUI{
             }
 
             // Adjust the event thread load if there are canvases to update
-            if (multiFrameCanvas.size() > 0) {
+            if (currentContext->multiFrameCanvas.size() > 0) {
                 eventThreadLoad = lerp(MIN_UPDATE_SPEED, MAX_UPDATE_SPEED, 0);
             }
         }
 
+        /**
+         * @brief Runs one round of the passive tasks, which do not need user input.
+         * @details Recalls the due memories, checks file streams which are not watched by the event loop and advances multi-frame canvases.
+         *          Afterwards the event delay and the next update speed are calculated from the load of this round.
+         *          Expects the rendering thread to be paused, since the tasks may modify elements.
+         */
+        void runEventTasks(){
+            static METRICS::histogram& eventTime = METRICS::getHistogram("event.time");
+
+            // Reset the thread load counter
+            eventThreadLoad = 0;
+            Previous_Time = CLOCK::now();
+
+            // Order independent --------------
+            recallMemories();
+            Go_Through_File_Streams();
+            Refresh_Multi_Frame_Canvas();
+
+            /* 
+                Notice: Since the Rendering thread will use its own access to render as tickets, so every time it is "REQUESTING_PAUSE" it will after its own run set itself to PAUSED.
+                This is what Tickets are.
+                So in other words, if there is MUST use of rendering pipeline, use Update_Frame().
+            */  
+            // Resume_GGUI();
+
+            Current_Time = CLOCK::now();
+
+            // Calculate the delta time.
+            eventDelay = std::chrono::duration_cast<std::chrono::milliseconds>(Current_Time - Previous_Time).count();
+
+            eventTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Current_Time - Previous_Time).count());
+
+            CURRENT_UPDATE_SPEED = MIN_UPDATE_SPEED + (MAX_UPDATE_SPEED - MIN_UPDATE_SPEED) * (1 - eventThreadLoad);
+        }
+
         /**
          * @brief Event_Thread is a function that runs an infinite loop to handle various events and tasks.
          * 
          * This function performs the following tasks in each iteration of the loop:
-         * - Resets the thread load counter and updates the previous time.
-         * - Calls functions to recall memories, go through file streams, and refresh the multi-frame canvas.
+         * - Waits for the rendering thread to be paused.
          * - Checks for termination signals and breaks out of the loop if the terminate flag is set.
-         * - Updates the current time and calculates the delta time.
-         * - Adjusts the current update speed based on the event thread load.
+         * - Runs the passive tasks with runEventTasks().
          * - Sleeps for a calculated duration to control the update speed.
          * 
          * The function is designed to be used in a multi-threaded environment where it can be paused and resumed as needed.
+         * Only used when the event loop is not available, since the event loop wakes up exactly when these tasks are due.
          * 
          * @note If uncapped FPS is desired, the sleep code can be disabled.
          */
         void eventThread(){
             while (true){
-                {
-                    std::unique_lock lock(atomic::mutex);
-
-                    atomic::condition.wait(lock, [&](){ 
-                        return atomic::pauseRenderThread == atomic::status::PAUSED || INTERNAL::requestTermination; 
-                    });
+                currentContext->ticket.waitUntil([](){ 
+                    return currentContext->ticket.getStatus() == atomic::status::PAUSED || INTERNAL::requestTermination; 
+                });
 
-                    if (INTERNAL::requestTermination){
-                        break;
-                    }
+                if (INTERNAL::requestTermination){
+                    break;
                 }
 
-                // Reset the thread load counter
-                eventThreadLoad = 0;
-                Previous_Time = std::chrono::high_resolution_clock::now();
-
-                // Order independent --------------
-                recallMemories();
-                Go_Through_File_Streams();
-                Refresh_Multi_Frame_Canvas();
+                runEventTasks();
 
-                /* 
-                    Notice: Since the Rendering thread will use its own access to render as tickets, so every time it is "REQUESTING_PAUSE" it will after its own run set itself to PAUSED.
-                    This is what Tickets are.
-                    So in other words, if there is MUST use of rendering pipeline, use Update_Frame().
-                */  
-                // Resume_GGUI();
-
-                Current_Time = std::chrono::high_resolution_clock::now();
-
-                // Calculate the delta time.
-                eventDelay = std::chrono::duration_cast<std::chrono::milliseconds>(Current_Time - Previous_Time).count();
-
-                CURRENT_UPDATE_SPEED = MIN_UPDATE_SPEED + (MAX_UPDATE_SPEED - MIN_UPDATE_SPEED) * (1 - eventThreadLoad);
-
-                // If ya want uncapped FPS, disable this sleep code:
-                std::this_thread::sleep_for(std::chrono::milliseconds(
+                // If ya want uncapped FPS, disable this sleep code, when fast forwarding the clock moves on instead:
+                CLOCK::sleepFor(std::chrono::milliseconds(
                     Max(
                         CURRENT_UPDATE_SPEED - eventDelay, 
                         MIN_UPDATE_SPEED
@@ -237,40 +321,43 @@ namespace GGUI{
         
             LOGGER::log("Event thread terminated!");
         }
-    
+
         /**
-         * @brief Function that continuously handles user input in a separate thread.
-         *
-         * This function runs an infinite loop where it performs the following steps:
-         * 1. Waits for user input by calling Query_Inputs().
-         * 2. Pauses the GGUI system and performs the following actions:
+         * @brief Translates the queried input and lets the event handlers react to it.
+         * @details Pauses the GGUI system and performs the following actions:
          *    - Records the current time as Previous_Time.
          *    - Translates the queried inputs using Translate_Inputs().
          *    - Processes scroll and mouse inputs using SCROLL_API() and MOUSE_API().
          *    - Calls the event handlers to react to the parsed input using Event_Handler().
          *    - Records the current time as Current_Time.
          *    - Calculates the delta time (input delay) and stores it in Input_Delay.
+         * This is repeated while Translate_Inputs() has left mouse button transitions or scrolls for a next batch.
          */
-        void inputThread(){
-            while (true){
-                if (SETTINGS::enableDRM) {
-                    DRM::pollInputs();
-                }
-                else {
-                    // Wait for user input.
-                    queryInputs();
-                }
+        void processQueriedInputs(){
+            static METRICS::histogram& inputTime = METRICS::getHistogram("input.time");
+
+            // Set when mouse button transitions or scrolls split the read into multiple batches, so that they are processed in order.
+            bool batchesLeft = false;
 
+            // The read which the batches came from.
+            inputCause cause;
+
+            do {
                 pauseGGUI([&](){
-                    Previous_Time = std::chrono::high_resolution_clock::now();
+                    GGUI_TRACE_SCOPE("inputs");
 
-                    if (SETTINGS::enableDRM) {
-                        DRM::translateInputs();
-                    }
-                    else {
-                        // Translate the Queried inputs.
-                        Translate_Inputs();
-                    }
+                    Previous_Time = CLOCK::now();
+
+                    // Translate the Queried inputs.
+                    batchesLeft = withBackend(currentContext->output, [](auto& output){
+                        return output.translateInputs();
+                    });
+
+                    if (currentContext->rawInput.id)
+                        cause = std::exchange(currentContext->rawInput, inputCause());
+
+                    // The frames requested while handling the input are attributed to it.
+                    activeCause = cause;
 
                     // Translate the movements thingies to better usable for user.
                     scrollAPI();
@@ -279,11 +366,33 @@ namespace GGUI{
                     // Now call upon event handlers which may react to the parsed input.
                     eventHandler();
 
-                    Current_Time = std::chrono::high_resolution_clock::now();
+                    activeCause = inputCause();
+
+                    Current_Time = CLOCK::now();
 
                     // Calculate the delta time.
                     Input_Delay = std::chrono::duration_cast<std::chrono::milliseconds>(Current_Time - Previous_Time).count();
+
+                    inputTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Current_Time - Previous_Time).count());
                 });
+            } while (batchesLeft);
+        }
+    
+        /**
+         * @brief Function that continuously handles user input in a separate thread.
+         *
+         * This function runs an infinite loop where it performs the following steps:
+         * 1. Waits for user input by calling Query_Inputs().
+         * 2. Processes it with processQueriedInputs().
+         * 
+         * Used for backends which need it, like DRM, and for the terminal whenever the event loop is not available.
+         */
+        void inputThread(){
+            while (true){
+                // Wait for user input.
+                currentContext->output->waitForInputs();
+
+                processQueriedInputs();
             }
         
             LOGGER::log("Input thread terminated!");
@@ -0,0 +1,113 @@
+#include "allocations.h"
+
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#endif
+
+// The allocations are counted in the profile builds, and in any other build with GGUI_COUNT_ALLOCATIONS defined.
+#if defined(GGUI_PROFILE) || defined(GGUI_COUNT_ALLOCATIONS)
+    #define GGUI_COUNTING_ALLOCATIONS 1
+#else
+    #define GGUI_COUNTING_ALLOCATIONS 0
+#endif
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace ALLOCATIONS{
+            // A plain thread local, so that touching it from operator new never allocates itself.
+            static thread_local uint64_t allocations = 0;
+
+            bool isCounting(){
+                return GGUI_COUNTING_ALLOCATIONS;
+            }
+
+            uint64_t onThisThread(){
+                return allocations;
+            }
+
+        #if GGUI_COUNTING_ALLOCATIONS
+            static void* allocate(std::size_t size){
+                allocations++;
+
+                // Zero sized allocations still have to give unique pointers.
+                while (true){
+                    if (void* result = std::malloc(size ? size : 1))
+                        return result;
+
+                    std::new_handler handler = std::get_new_handler();
+                    if (!handler)
+                        throw std::bad_alloc();
+
+                    handler();
+                }
+            }
+
+            static void* allocateAligned(std::size_t size, std::align_val_t alignment){
+                allocations++;
+
+                std::size_t bytes = size ? size : 1;
+                std::size_t align = std::max((std::size_t)alignment, sizeof(void*));
+
+                while (true){
+                #if defined(_WIN32)
+                    void* result = _aligned_malloc(bytes, align);
+                #else
+                    void* result = nullptr;
+                    if (posix_memalign(&result, align, bytes) != 0)
+                        result = nullptr;
+                #endif
+
+                    if (result)
+                        return result;
+
+                    std::new_handler handler = std::get_new_handler();
+                    if (!handler)
+                        throw std::bad_alloc();
+
+                    handler();
+                }
+            }
+
+            static void releaseAligned(void* pointer){
+            #if defined(_WIN32)
+                _aligned_free(pointer);
+            #else
+                std::free(pointer);
+            #endif
+            }
+        #endif
+        }
+    }
+}
+
+#if GGUI_COUNTING_ALLOCATIONS
+// The standard library forwards its array and nothrow forms into these, so they are counted too.
+void* operator new(std::size_t size){
+    return GGUI::INTERNAL::ALLOCATIONS::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment){
+    return GGUI::INTERNAL::ALLOCATIONS::allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept{
+    GGUI::INTERNAL::ALLOCATIONS::releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept{
+    GGUI::INTERNAL::ALLOCATIONS::releaseAligned(pointer);
+}
+#endif
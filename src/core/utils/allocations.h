@@ -0,0 +1,31 @@
+#ifndef _ALLOCATIONS_H_
+#define _ALLOCATIONS_H_
+
+#include <cstdint>
+
+namespace GGUI {
+    namespace INTERNAL {
+        /**
+         * @brief Counts the heap allocations of each thread, for finding the ones made by a steady-state frame.
+         * @details The profile builds, and any build with GGUI_COUNT_ALLOCATIONS defined, replace the global operator new
+         *          with one that counts into the calling thread before allocating with malloc. The rendering thread then
+         *          records frame.allocations (allocations) into INTERNAL::METRICS for every frame.
+         *          In the other builds nothing is replaced and the counts stay zero.
+         *          A program which replaces operator new itself has to link against a build without the counting.
+         */
+        namespace ALLOCATIONS {
+            /**
+             * @brief Tells whether this build of GGUI counts the allocations.
+             */
+            extern bool isCounting();
+
+            /**
+             * @brief Gives the count of operator new calls made by the calling thread since it started.
+             * @details Compare two readings around the code of interest, the aligned and the array forms are counted as well.
+             */
+            extern uint64_t onThisThread();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,199 @@
+#include "backend.h"
+#include "settings.h"
+#include "drm.h"
+#include "eventLoop.h"
+#include "frameServer.h"
+#include "trace.h"
+#include "metrics.h"
+#include "../renderer.h"
+
+namespace GGUI{
+    namespace INTERNAL{
+        terminalBackend terminalOutput;
+        drmBackend drmOutput;
+        headlessBackend headlessOutput;
+
+        backend* selectBackend(){
+            if (SETTINGS::enableDRM)
+                return &drmOutput;
+
+            if (SETTINGS::headless)
+                return &headlessOutput;
+
+            return &terminalOutput;
+        }
+
+        /**
+         * @brief Nanoseconds passed since the given time, for the frameTimings.
+         */
+        static long long nanosecondsSince(std::chrono::high_resolution_clock::time_point start){
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        /**
+         * @brief Encodes the frame into the frame buffer of the current context, like it is written into the terminal.
+         */
+        static void encodeFrame(std::vector<UTF>& cells, unsigned int width, unsigned int height){
+            auto start = std::chrono::high_resolution_clock::now();
+
+            // ENCODE for optimize
+            encodeBuffer(&cells);
+
+            unsigned int Liquefied_Size = 0;
+            conveyorAllocator<compactString> CS_Buffer = liquifyUTFText(&cells, Liquefied_Size, width, height);
+
+            {
+                GGUI_TRACE_SCOPE("toString");
+                currentContext->frameBuffer = toString(CS_Buffer, Liquefied_Size, currentContext->encodedFrame);
+            }
+
+            currentContext->lastFrame.encode = nanosecondsSince(start);
+
+            static METRICS::histogram& frameBytes = METRICS::getHistogram("frame.bytes", "bytes");
+            static METRICS::counter& bytesWritten = METRICS::getCounter("bytes.written");
+
+            frameBytes.record(currentContext->frameBuffer->size());
+            bytesWritten.add(currentContext->frameBuffer->size());
+        }
+
+        /**
+         * @brief Records how long ago the input arrived whose changes the frame just written shows.
+         * @details Called by the backends once the write has completed, so the latency covers the handlers, the render, the encoding and the write.
+         */
+        static void recordInputLatency(){
+            inputCause& cause = currentContext->presentingCause;
+
+            if (!cause.id)
+                return;
+
+            static METRICS::histogram& latency = METRICS::getHistogram("input.latency");
+            latency.record(nanosecondsSince(cause.arrival));
+
+            cause = inputCause();
+        }
+
+        // --- Terminal ---
+
+        bool terminalBackend::getSize(unsigned int& width, unsigned int& height){
+            return getTerminalSize(width, height);
+        }
+
+        bool terminalBackend::needsInputThread() const{
+            // The event loop reads STDIN itself when it is available.
+            return Is_Stdin_TTY() && !EVENT_LOOP::isActive();
+        }
+
+        void terminalBackend::waitForInputs(){
+            queryInputs();
+        }
+
+        bool terminalBackend::translateInputs(){
+            return Translate_Inputs();
+        }
+
+        void terminalBackend::present(std::vector<UTF>& cells, unsigned int width, unsigned int height){
+            encodeFrame(cells, width, height);
+
+            auto start = std::chrono::high_resolution_clock::now();
+
+            renderFrame();
+
+            currentContext->lastFrame.output = nanosecondsSince(start);
+            recordInputLatency();
+
+            // The subscribers get the same frame, encoded once for all of them.
+            if (FRAME_SERVER::isRunning())
+                FRAME_SERVER::publish(cells, width, height, *currentContext->frameBuffer);
+        }
+
+        // --- DRM ---
+
+        void drmBackend::connect(){
+            DRM::retryDRMConnect();
+        }
+
+        bool drmBackend::getSize([[maybe_unused]] unsigned int& width, [[maybe_unused]] unsigned int& height){
+            // The DRM client sends its size in a resize packet, which sets the size directly.
+            return false;
+        }
+
+        void drmBackend::waitForInputs(){
+            DRM::pollInputs();
+        }
+
+        bool drmBackend::translateInputs(){
+            DRM::translateInputs();
+            return false;
+        }
+
+        void drmBackend::present(std::vector<UTF>& cells, [[maybe_unused]] unsigned int width, [[maybe_unused]] unsigned int height){
+            auto start = std::chrono::high_resolution_clock::now();
+
+            DRM::sendBuffer(cells);
+
+            currentContext->lastFrame.encode = 0;
+            currentContext->lastFrame.output = nanosecondsSince(start);
+            recordInputLatency();
+        }
+
+        void drmBackend::presentIdentical(){
+            // Lets the client know that we are still alive.
+            std::vector<UTF> empty;
+            DRM::sendBuffer(empty);
+        }
+
+        // --- Headless ---
+
+        bool headlessBackend::getSize(unsigned int& Width, unsigned int& Height){
+            Width = width;
+            Height = height;
+            return true;
+        }
+
+        bool headlessBackend::translateInputs(){
+            // A chunk with batches left is translated further before the next one replaces it.
+            if (!translating && !pendingInput.empty())
+                pendingInput.erase(0, setRawInput(pendingInput.data(), pendingInput.size()));
+
+            translating = Translate_Inputs();
+
+            return translating || !pendingInput.empty();
+        }
+
+        void headlessBackend::present(std::vector<UTF>& Cells, unsigned int Width, unsigned int Height){
+            encodeFrame(Cells, Width, Height);
+
+            auto start = std::chrono::high_resolution_clock::now();
+
+            // The same bytes as renderFrame() writes.
+            frame.assign(constants::ANSI::SET_CURSOR_TO_START.text, constants::ANSI::SET_CURSOR_TO_START.size);
+            frame.append(*currentContext->frameBuffer);
+
+            cells = Cells;
+            frames++;
+
+            currentContext->lastFrame.output = nanosecondsSince(start);
+            recordInputLatency();
+
+            if (FRAME_SERVER::isRunning())
+                FRAME_SERVER::publish(Cells, Width, Height, *currentContext->frameBuffer);
+        }
+
+        void headlessBackend::resize(unsigned int Width, unsigned int Height){
+            width = Width;
+            height = Height;
+
+            currentContext->Carry_Flags([](carry& current_carry){
+                current_carry.resize = true;    // Tell the render thread that an resize is needed to be performed.
+            });
+
+            updateFrame();
+        }
+
+        void headlessBackend::feed(const std::string& bytes){
+            pendingInput += bytes;
+
+            processQueriedInputs();
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#ifndef _BACKEND_H_
+#define _BACKEND_H_
+
+#include <vector>
+#include <string>
+
+#include "utf.h"
+
+namespace GGUI {
+    namespace INTERNAL {
+        /**
+         * @brief Where the frames are output to and the inputs read from.
+         * @details One is selected for each context at init, see selectBackend(). The terminal backend is the default and
+         *          is called without the virtual dispatch, see withBackend().
+         */
+        class backend {
+        public:
+            virtual ~backend() = default;
+
+            /**
+             * @brief Name of the backend for the logs.
+             */
+            virtual const char* getName() const = 0;
+
+            /**
+             * @brief Whether the backend drives the terminal of the process: its raw mode, ANSI features, resize signals and STDIN.
+             */
+            virtual bool ownsTerminal() const { return false; }
+
+            /**
+             * @brief Whether the output is at the other end of a connection, which tells its size only once connected.
+             */
+            virtual bool isRemote() const { return false; }
+
+            /**
+             * @brief Connects to the output, called by GGUI() once the main element exists.
+             */
+            virtual void connect() {}
+
+            /**
+             * @brief Gives the size of the output in cells.
+             * @return False if the size could not be determined, then the previous size is kept.
+             */
+            virtual bool getSize(unsigned int& width, unsigned int& height) = 0;
+
+            /**
+             * @brief Whether waitForInputs() has to be called from an input thread of its own.
+             */
+            virtual bool needsInputThread() const { return false; }
+
+            /**
+             * @brief Blocks until there is input for translateInputs().
+             */
+            virtual void waitForInputs() {}
+
+            /**
+             * @brief Translates the waiting input into the inputs of the current context.
+             * @return True if there is input left for another batch, see processQueriedInputs().
+             */
+            virtual bool translateInputs() { return false; }
+
+            /**
+             * @brief Outputs a changed frame.
+             * @param cells The rendered frame row by row, which the backend may encode in place.
+             * @param width Width of the frame in cells.
+             * @param height Height of the frame in cells.
+             */
+            virtual void present(std::vector<UTF>& cells, unsigned int width, unsigned int height) = 0;
+
+            /**
+             * @brief Called instead of present() when the frame did not change.
+             */
+            virtual void presentIdentical() {}
+        };
+
+        /**
+         * @brief Writes the frames as ANSI encoded text into STDOUT and reads the input from STDIN.
+         */
+        class terminalBackend final : public backend {
+        public:
+            const char* getName() const override { return "terminal"; }
+            bool ownsTerminal() const override { return true; }
+            bool getSize(unsigned int& width, unsigned int& height) override;
+            bool needsInputThread() const override;
+            void waitForInputs() override;
+            bool translateInputs() override;
+            void present(std::vector<UTF>& cells, unsigned int width, unsigned int height) override;
+        };
+
+        /**
+         * @brief Sends the cells to a DRM client, which sends back its size and input, given as --enableDRM.
+         */
+        class drmBackend final : public backend {
+        public:
+            const char* getName() const override { return "DRM"; }
+            bool isRemote() const override { return true; }
+            void connect() override;
+            bool getSize(unsigned int& width, unsigned int& height) override;
+            bool needsInputThread() const override { return true; }
+            void waitForInputs() override;
+            bool translateInputs() override;
+            void present(std::vector<UTF>& cells, unsigned int width, unsigned int height) override;
+            void presentIdentical() override;
+        };
+
+        /**
+         * @brief Keeps the last frame in memory instead of outputting it, for benchmarks and golden frame tests, given as --headless.
+         * @details Input is given with feed(). The frame is encoded exactly like for the terminal, so the byte counts match.
+         *          Read the frame while the rendering is paused, for example from within pauseGGUI().
+         */
+        class headlessBackend final : public backend {
+        public:
+            headlessBackend(unsigned int Width = 80, unsigned int Height = 24) : width(Width), height(Height) {}
+
+            const char* getName() const override { return "headless"; }
+            bool getSize(unsigned int& Width, unsigned int& Height) override;
+            bool translateInputs() override;
+            void present(std::vector<UTF>& cells, unsigned int width, unsigned int height) override;
+
+            /**
+             * @brief Changes the size of the output and requests the resize like a terminal resize would.
+             */
+            void resize(unsigned int Width, unsigned int Height);
+
+            /**
+             * @brief Processes the raw input bytes as if they were read from the terminal.
+             * @param bytes Key presses, escape sequences and mouse reports like the terminal would send them.
+             */
+            void feed(const std::string& bytes);
+
+            /**
+             * @brief Gives the cells of the last frame row by row.
+             * @note The texts of the cells point into the elements, so they are valid only until the scene changes.
+             */
+            const std::vector<UTF>& getCells() const { return cells; }
+
+            /**
+             * @brief Gives the bytes of the last frame, as they would have been written into the terminal.
+             */
+            const std::string& getFrame() const { return frame; }
+
+            /**
+             * @brief Gives how many changed frames have been presented.
+             */
+            size_t getFrameCount() const { return frames; }
+
+        private:
+            unsigned int width;
+            unsigned int height;
+
+            std::vector<UTF> cells;
+            std::string frame;
+            size_t frames = 0;
+
+            std::string pendingInput;       // Fed bytes which have not been translated yet.
+            bool translating = false;       // The previous chunk still has batches left.
+        };
+
+        extern terminalBackend terminalOutput;
+        extern drmBackend drmOutput;
+        extern headlessBackend headlessOutput;     // The one selected with --headless.
+
+        /**
+         * @brief Gives the backend chosen by the settings: DRM with --enableDRM, headless with --headless and the terminal otherwise.
+         */
+        extern backend* selectBackend();
+
+        /**
+         * @brief Calls the function with the backend, as the terminal backend itself when it is the terminal one.
+         * @details Since terminalBackend is final, the calls into it are direct, so the default path costs no virtual dispatch.
+         * @param output The backend, usually the one of the current context.
+         * @param job Generic function taking the backend by reference.
+         */
+        template<typename Job>
+        inline auto withBackend(backend* output, Job&& job) {
+            if (output == &terminalOutput)
+                return job(terminalOutput);
+
+            return job(*output);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "clock.h"
+
+#include <atomic>
+#include <thread>
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace CLOCK{
+            static std::atomic<MODE> mode = MODE::REAL;
+            static std::atomic<timePoint::rep> virtualTime = 0;
+
+            timePoint now(){
+                if (mode.load(std::memory_order_relaxed) == MODE::REAL)
+                    return std::chrono::high_resolution_clock::now();
+
+                return timePoint(timePoint::duration(virtualTime.load(std::memory_order_relaxed)));
+            }
+
+            void setVirtual(timePoint time){
+                virtualTime = time.time_since_epoch().count();
+                mode = MODE::VIRTUAL;
+            }
+
+            void fastForward(timePoint time){
+                virtualTime = time.time_since_epoch().count();
+                mode = MODE::FAST_FORWARD;
+            }
+
+            void advance(std::chrono::nanoseconds time){
+                if (mode.load(std::memory_order_relaxed) == MODE::REAL)
+                    return;
+
+                virtualTime += std::chrono::duration_cast<timePoint::duration>(time).count();
+            }
+
+            void sleepFor(std::chrono::milliseconds time){
+                if (mode.load(std::memory_order_relaxed) != MODE::FAST_FORWARD){
+                    std::this_thread::sleep_for(time);
+                    return;
+                }
+
+                advance(time);
+
+                // Let the other threads see the new time before the next round.
+                std::this_thread::yield();
+            }
+
+            void useReal(){
+                mode = MODE::REAL;
+            }
+
+            bool isVirtual(){
+                return mode != MODE::REAL;
+            }
+
+            MODE getMode(){
+                return mode;
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef _CLOCK_H_
+#define _CLOCK_H_
+
+#include <chrono>
+
+namespace GGUI {
+    // autoGen: Ignore start
+    namespace INTERNAL {
+        /**
+         * @brief The time source which everything that schedules by time reads, the memories, the event thread, the held keys and the mouse press cooldowns.
+         * @details Measurements of how long work took, like the trace spans, the element profiler and the backend write times, stay on the real clock.
+         *          The durations measured between two reads of this clock, like the frame and event times, are zero under a virtual clock.
+         */
+        namespace CLOCK {
+            using timePoint = std::chrono::high_resolution_clock::time_point;
+
+            enum class MODE {
+                REAL,           // The time of the system.
+                VIRTUAL,        // Stands still until moved with setVirtual() or advance(), sleepFor() still waits for real.
+                FAST_FORWARD    // Like VIRTUAL, but sleepFor() and the event loop timer move the clock instead of waiting.
+            };
+
+            /**
+             * @brief Gives the time which the scheduling runs on.
+             * @details The real time, unless a virtual time has been set with setVirtual() or fastForward(), like the session replay does,
+             *          so that the held keys and mouse press cooldowns see the same time as when the session was recorded.
+             */
+            extern timePoint now();
+
+            /**
+             * @brief Stops the clock at the given time, until it is moved again or useReal() is called.
+             */
+            extern void setVirtual(timePoint time);
+
+            /**
+             * @brief Stops the clock at the given time, after which the waits move the clock forward instead of waiting.
+             * @details A minute of animations then runs as fast as the frames can be rendered, with exactly the same steps every run.
+             */
+            extern void fastForward(timePoint time);
+
+            /**
+             * @brief Moves a virtual clock forward by the given time, does nothing for the real clock.
+             */
+            extern void advance(std::chrono::nanoseconds time);
+
+            /**
+             * @brief Waits for the given time, or moves the clock forward by it when fast forwarding.
+             */
+            extern void sleepFor(std::chrono::milliseconds time);
+
+            /**
+             * @brief Returns to the real time.
+             */
+            extern void useReal();
+
+            /**
+             * @brief Tells whether a virtual time is in use, also when fast forwarding.
+             */
+            extern bool isVirtual();
+
+            /**
+             * @brief Gives the mode the clock is in.
+             */
+            extern MODE getMode();
+        }
+    }
+    // autoGen: Ignore end
+}
+
+#endif
@@ -75,6 +75,10 @@ namespace GGUI{
             // CSI (Control Sequence Introducer) sequences.
             constexpr INTERNAL::compactString ESC_CODE = "\x1B";       // Also known as \e or \o33
             constexpr INTERNAL::compactString CSI_CODE = "\x1B[";       // Also known as \e[ or \o33[
+
+            // Markers which the terminal wraps pasted text with, when BRACKETED_PASTE is enabled.
+            constexpr INTERNAL::compactString BRACKETED_PASTE_START = "\x1B[200~";
+            constexpr INTERNAL::compactString BRACKETED_PASTE_END = "\x1B[201~";
             constexpr INTERNAL::compactString SEPARATE = ';';
             constexpr INTERNAL::compactString USE_RGB = '2';
             constexpr INTERNAL::compactString END_COMMAND = 'm';
@@ -189,6 +193,7 @@ namespace GGUI{
             constexpr INTERNAL::compactString REPORT_MOUSE_BUTTON_WHILE_MOVING = "1002";
             constexpr INTERNAL::compactString REPORT_MOUSE_ALL_EVENTS = "1003";
             constexpr INTERNAL::compactString EXTEND_TO_SGR_MODE = "1006";
+            constexpr INTERNAL::compactString BRACKETED_PASTE = "2004";  // 2004h = pasted text is wrapped between BRACKETED_PASTE_START and BRACKETED_PASTE_END
 
             constexpr INTERNAL::compactString MOUSE_CURSOR = "25";
             constexpr INTERNAL::compactString SCREEN_CAPTURE = "47"; // 47l = restores screen, 47h = saves screen
@@ -320,6 +325,9 @@ namespace GGUI{
 
         constexpr unsigned long long MOUSE_MIDDLE_SCROLL_UP = (unsigned long long)1 << 45;
         constexpr unsigned long long MOUSE_MIDDLE_SCROLL_DOWN = (unsigned long long)1 << 46;
+
+        // The whole pasted text is delivered at once in input::text.
+        constexpr unsigned long long PASTE = (unsigned long long)1 << 47;
     
     }
 
@@ -71,7 +71,7 @@ namespace GGUI {
              * @warning No bounds checking is performed. Caller must ensure capacity.
              */
             void append(T unit) {
-                std::memcpy(rawBuffer + size * sizeof(T), &unit, sizeof(T));
+                std::memcpy(rawBuffer + size, &unit, sizeof(T));
                 size++;
             }
 
@@ -113,6 +113,11 @@ namespace GGUI {
              */
             std::size_t getSize() { return size; }
 
+            /**
+             * @brief Get the number of elements the raw buffer has room for.
+             */
+            std::size_t getCapacity() const { return capacity; }
+
             /**
              * @brief Obtain a mutable pointer to the contiguous element data.
              * @return Pointer to first element (reinterpret_cast from raw bytes).
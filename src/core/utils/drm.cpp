@@ -11,10 +11,6 @@ namespace GGUI {
         // Forward declarations for functions used from renderer.cpp
         extern void handleEscape();
         extern void handleTabulator();
-        extern std::unordered_map<std::string_view, buttonState> PREVIOUS_KEYBOARD_STATES;
-        extern std::unordered_map<std::string_view, buttonState> KEYBOARD_STATES;
-        extern std::vector<input*> inputs;
-        extern IVector3 mouse;
         
         namespace DRM {
             const char* handshakePortLocation = "/tmp/GGDirect.gateway";
@@ -43,160 +39,160 @@ namespace GGUI {
                 }
 
                 // Clean the keyboard states - save previous state
-                INTERNAL::PREVIOUS_KEYBOARD_STATES = INTERNAL::KEYBOARD_STATES;
+                INTERNAL::currentContext->PREVIOUS_KEYBOARD_STATES = INTERNAL::currentContext->KEYBOARD_STATES;
 
                 // Update mouse position from packet
                 if (packetInput->mouse.x >= 0 && packetInput->mouse.y >= 0) {
-                    INTERNAL::mouse.x = packetInput->mouse.x;
-                    INTERNAL::mouse.y = packetInput->mouse.y;
+                    INTERNAL::currentContext->mouse.x = packetInput->mouse.x;
+                    INTERNAL::currentContext->mouse.y = packetInput->mouse.y;
                 }
 
                 // Handle control key modifiers
                 bool isPressed = (packetInput->modifiers & controlKey::PRESSED_DOWN) != controlKey::UNKNOWN;
                 
                 if ((packetInput->modifiers & controlKey::SHIFT) != controlKey::UNKNOWN) {
-                    INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::SHIFT));
-                    INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = INTERNAL::buttonState(isPressed);
+                    INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::SHIFT));
+                    INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SHIFT] = INTERNAL::buttonState(isPressed);
                 }
                 
                 if ((packetInput->modifiers & controlKey::CTRL) != controlKey::UNKNOWN) {
-                    INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::CONTROL));
-                    INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = INTERNAL::buttonState(isPressed);
+                    INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::CONTROL));
+                    INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = INTERNAL::buttonState(isPressed);
                 }
                 
                 if ((packetInput->modifiers & controlKey::ALT) != controlKey::UNKNOWN) {
-                    INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::ALT));
-                    INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = INTERNAL::buttonState(isPressed);
+                    INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::ALT));
+                    INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = INTERNAL::buttonState(isPressed);
                 }
                 
                 if ((packetInput->modifiers & controlKey::SUPER) != controlKey::UNKNOWN) {
-                    INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::SUPER));
-                    INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::SUPER] = INTERNAL::buttonState(isPressed);
+                    INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::SUPER));
+                    INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SUPER] = INTERNAL::buttonState(isPressed);
                 }
                 
                 if ((packetInput->modifiers & controlKey::ALTGR) != controlKey::UNKNOWN) {
                     // Note: ALTGR is handled as ALT in GGUI
-                    INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::ALT));
-                    INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = INTERNAL::buttonState(isPressed);
+                    INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::ALT));
+                    INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ALT] = INTERNAL::buttonState(isPressed);
                 }
 
                 // Handle additional special keys
                 switch (packetInput->additional) {
                     case additionalKey::F1:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F1));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F1] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F1));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F1] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F2:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F2));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F2] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F2));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F2] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F3:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F3));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F3] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F3));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F3] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F4:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F4));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F4] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F4));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F4] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F5:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F5));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F5] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F5));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F5] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F6:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F6));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F6] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F6));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F6] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F7:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F7));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F7] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F7));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F7] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F8:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F8));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F8] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F8));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F8] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F9:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F9));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F9] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F9));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F9] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F10:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F10));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F10] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F10));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F10] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F11:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F11));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F11] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F11));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F11] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::F12:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::F12));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::F12] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::F12));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::F12] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::ARROW_UP:
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::UP));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::UP] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(0, GGUI::constants::UP));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::UP] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::ARROW_DOWN:
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::DOWN));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::DOWN] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(0, GGUI::constants::DOWN));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::DOWN] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::ARROW_LEFT:
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::LEFT));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::LEFT] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(0, GGUI::constants::LEFT));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::LEFT] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::ARROW_RIGHT:
-                        INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::RIGHT));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::RIGHT] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(0, GGUI::constants::RIGHT));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::RIGHT] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::HOME:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::HOME));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::HOME] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::HOME));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::HOME] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::END:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::END));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::END] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::END));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::END] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::PAGE_UP:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::PAGE_UP));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::PAGE_UP] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::PAGE_UP));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::PAGE_UP] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::PAGE_DOWN:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::PAGE_DOWN));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::PAGE_DOWN] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::PAGE_DOWN));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::PAGE_DOWN] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::INSERT:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::INSERT));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::INSERT] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::INSERT));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::INSERT] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::DEL:
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::DEL));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::DEL] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::DEL));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::DEL] = INTERNAL::buttonState(isPressed);
                         break;
                     case additionalKey::LEFT_CLICK:
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT] = INTERNAL::buttonState(isPressed);
                         if (isPressed) {
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = std::chrono::high_resolution_clock::now();
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_LEFT].captureTime = CLOCK::now();
                         }
                         break;
                     case additionalKey::MIDDLE_CLICK:
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE] = INTERNAL::buttonState(isPressed);
                         if (isPressed) {
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime = std::chrono::high_resolution_clock::now();
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_MIDDLE].captureTime = CLOCK::now();
                         }
                         break;
                     case additionalKey::RIGHT_CLICK:
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT] = INTERNAL::buttonState(isPressed);
                         if (isPressed) {
-                            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = std::chrono::high_resolution_clock::now();
+                            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_RIGHT].captureTime = CLOCK::now();
                         }
                         break;
                     case additionalKey::SCROLL_UP:
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP] = INTERNAL::buttonState(true);
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN] = INTERNAL::buttonState(false);
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].captureTime = std::chrono::high_resolution_clock::now();
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP] = INTERNAL::buttonState(true);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN] = INTERNAL::buttonState(false);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP].captureTime = CLOCK::now();
                         break;
                     case additionalKey::SCROLL_DOWN:
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN] = INTERNAL::buttonState(true);
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP] = INTERNAL::buttonState(false);
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].captureTime = std::chrono::high_resolution_clock::now();
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN] = INTERNAL::buttonState(true);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_UP] = INTERNAL::buttonState(false);
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::MOUSE_SCROLL_DOWN].captureTime = CLOCK::now();
                         break;
                     case additionalKey::UNKNOWN:
                     default:
@@ -208,42 +204,42 @@ namespace GGUI {
                 if (packetInput->key != 0) {
                     // Check for special characters
                     if (packetInput->key == '\n' || packetInput->key == '\r') {
-                        INTERNAL::inputs.push_back(new GGUI::input('\n', GGUI::constants::ENTER));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput('\n', GGUI::constants::ENTER));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER] = INTERNAL::buttonState(isPressed);
                     }
                     else if (packetInput->key == '\t') {
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::TAB));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::TAB));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::TAB] = INTERNAL::buttonState(isPressed);
                         handleTabulator();
                     }
                     else if (packetInput->key == '\b' || packetInput->key == 127) { // Backspace or DEL
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::BACKSPACE));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::BACKSPACE));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(isPressed);
                     }
                     else if (packetInput->key == 27) { // ESC
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::ESCAPE));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::ESCAPE));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ESC] = INTERNAL::buttonState(isPressed);
                         handleEscape();
                     }
                     else if (packetInput->key == ' ') { // Space
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::SPACE));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::SPACE] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::SPACE));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::SPACE] = INTERNAL::buttonState(isPressed);
                     }
                     else if (packetInput->key >= 32 && packetInput->key <= 126) { // Printable ASCII characters
                         // Only process key press events for regular characters
                         if (isPressed) {
-                            INTERNAL::inputs.push_back(new GGUI::input(packetInput->key, GGUI::constants::KEY_PRESS));
+                            INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(packetInput->key, GGUI::constants::KEY_PRESS));
                         }
                     }
                     else if (packetInput->key >= 1 && packetInput->key <= 26) { // Ctrl+A to Ctrl+Z
                         // Convert back to the corresponding letter
                         char ctrlChar = packetInput->key + 'A' - 1;
-                        INTERNAL::inputs.push_back(new GGUI::input(' ', GGUI::constants::CONTROL));
-                        INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = INTERNAL::buttonState(isPressed);
+                        INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(' ', GGUI::constants::CONTROL));
+                        INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::CONTROL] = INTERNAL::buttonState(isPressed);
                         
                         // Also add the character if it's a key press
                         if (isPressed) {
-                            INTERNAL::inputs.push_back(new GGUI::input(ctrlChar, GGUI::constants::KEY_PRESS));
+                            INTERNAL::currentContext->inputs.push_back(INTERNAL::takeInput(ctrlChar, GGUI::constants::KEY_PRESS));
                         }
                     }
                 }
@@ -332,7 +328,7 @@ namespace GGUI {
 
                     packet::resize::base* resizePacket = reinterpret_cast<packet::resize::base*>(packetBuffer);
 
-                    main->setDimensions(resizePacket->size.x, resizePacket->size.y);
+                    currentContext->main->setDimensions(resizePacket->size.x, resizePacket->size.y);
 
                 } catch (const std::exception& e) {
                     GGUI::INTERNAL::LOGGER::log("DRM connection failed: " + std::string(e.what()));
@@ -430,6 +426,10 @@ namespace GGUI {
                     GGUI::INTERNAL::LOGGER::log("Failed to receive packet from DRM backend");
                     return; // Exit if we can't receive data
                 }
+
+                // The input latency is measured from here to the sendBuffer() which shows its changes.
+                if (reinterpret_cast<packet::base*>(rawPacketBuffer)->packetType == packet::type::INPUT)
+                    stampRawInput();
             }
 
             void translateInputs() {
@@ -443,7 +443,7 @@ namespace GGUI {
                         // Now we can simply cast to the resize packet and read the new size and assign it to Main element
                         packet::resize::base* resizePacket = reinterpret_cast<packet::resize::base*>(rawPacketBuffer);
     
-                        main->setDimensions(resizePacket->size.x, resizePacket->size.y);
+                        currentContext->main->setDimensions(resizePacket->size.x, resizePacket->size.y);
                         break;
                     }
                 case packet::type::NOTIFY:
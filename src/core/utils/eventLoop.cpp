@@ -0,0 +1,387 @@
+#include "eventLoop.h"
+#include "fileStreamer.h"
+#include "../renderer.h"
+
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <sys/signalfd.h>
+    #include <sys/timerfd.h>
+    #include <sys/inotify.h>
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+    #include <csignal>
+    #include <cerrno>
+    #include <cstdint>
+    #include <cstring>
+#endif
+
+namespace GGUI{
+    namespace INTERNAL{
+        extern sig_atomic_t requestTermination;
+
+        namespace EVENT_LOOP{
+            // inotify watch descriptors mapped to the file stream names they belong to.
+            static atomic::guard<std::unordered_map<int, std::string>> watches;
+
+            static bool active = false;
+
+        #if defined(__linux__)
+            static int epollHandle = -1;
+            static int signalHandle = -1;
+            static int timerHandle = -1;
+            static int inotifyHandle = -1;
+            static int wakeHandle = -1;
+
+            // Signals which the loop takes over from the default handlers and the termination thread.
+            static const int loopSignals[] = { SIGWINCH, SIGINT, SIGTERM, SIGQUIT };
+
+            /**
+             * @brief Closes all descriptors which init() managed to create, so that a failed init leaves nothing behind.
+             */
+            static void closeHandles(){
+                for (int* handle : { &epollHandle, &signalHandle, &timerHandle, &inotifyHandle, &wakeHandle }){
+                    if (*handle >= 0)
+                        close(*handle);
+                    *handle = -1;
+                }
+            }
+
+            /**
+             * @brief Registers the descriptor into the epoll instance for readability.
+             * @return True on success.
+             */
+            static bool addToEpoll(int handle){
+                epoll_event event{};
+                event.events = EPOLLIN;
+                event.data.fd = handle;
+                return epoll_ctl(epollHandle, EPOLL_CTL_ADD, handle, &event) == 0;
+            }
+
+            /**
+             * @brief Arms the timer to the next deadline, or disarms it if there is no timed work.
+             */
+            static void armTimer(){
+                long long deadline = nextDeadline();
+
+                itimerspec spec{};  // All zeroes disarms the timer.
+                if (deadline > 0 && CLOCK::getMode() == CLOCK::MODE::FAST_FORWARD){
+                    // Arrive at the deadline at once, the smallest time still arms the timer.
+                    CLOCK::advance(std::chrono::milliseconds(deadline));
+                    spec.it_value.tv_nsec = 1;
+                }
+                else if (deadline > 0){
+                    spec.it_value.tv_sec = deadline / TIME::SECOND;
+                    spec.it_value.tv_nsec = (deadline % TIME::SECOND) * 1'000'000;
+                }
+
+                timerfd_settime(timerHandle, 0, &spec, nullptr);
+            }
+
+            /**
+             * @brief Reads the pending signals and reacts to them.
+             * @return True if a termination signal was received, the caller must then stop the loop before signaling the termination.
+             */
+            static bool handleSignals(){
+                signalfd_siginfo info;
+                bool terminate = false;
+
+                while (read(signalHandle, &info, sizeof(info)) == sizeof(info)){
+                    if (info.ssi_signo == SIGWINCH){
+                        currentContext->Carry_Flags([](carry& current_carry){
+                            current_carry.resize = true;    // Tell the render thread that an resize is needed to be performed.
+                        });
+
+                        updateFrame();
+                    }
+                    else{
+                        terminate = true;
+                    }
+                }
+
+                return terminate;
+            }
+
+            /**
+             * @brief Reads the inotify events and collects the names of the modified files without duplicates.
+             * @param modified Where the modified file names are appended into.
+             */
+            static void handleFileEvents(std::vector<std::string>& modified){
+                alignas(inotify_event) char buffer[4096];
+
+                ssize_t length;
+                while ((length = read(inotifyHandle, buffer, sizeof(buffer))) > 0){
+                    for (ssize_t offset = 0; offset < length;){
+                        const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                        offset += sizeof(inotify_event) + event->len;
+
+                        std::string name;
+                        watches([event, &name](std::unordered_map<int, std::string>& self){
+                            auto it = self.find(event->wd);
+                            if (it == self.end())
+                                return;
+
+                            name = it->second;
+
+                            // The watch is gone when the file is deleted or replaced, Go_Through_File_Streams() will poll it from now on.
+                            if (event->mask & IN_IGNORED)
+                                self.erase(it);
+                        });
+
+                        if (name.empty())
+                            continue;
+
+                        // Editors often replace the file instead of writing into it, so try to follow the new one.
+                        if (event->mask & IN_IGNORED)
+                            watchFile(name);
+
+                        bool known = false;
+                        for (const std::string& previous : modified)
+                            known |= previous == name;
+
+                        if (!known)
+                            modified.push_back(name);
+                    }
+                }
+            }
+
+            /**
+             * @brief Waits until the rendering thread is paused, like the event thread does before its tasks.
+             * @details Returns immediately in cooperative mode, since there is no rendering thread to wait for.
+             * @return False if termination was requested meanwhile.
+             */
+            static bool waitForRenderPause(){
+                // Nothing renders behind our back when GGUI::tick() is driving everything.
+                if (cooperativeMode)
+                    return !requestTermination;
+
+                currentContext->ticket.waitUntil([](){
+                    return currentContext->ticket.getStatus() == atomic::status::PAUSED || requestTermination;
+                });
+
+                return !requestTermination;
+            }
+        #endif
+
+            bool init([[maybe_unused]] bool watchStdin){
+            #if defined(__linux__)
+                if (active)
+                    return true;
+
+                sigset_t signals;
+                sigemptyset(&signals);
+                for (int signal : loopSignals)
+                    sigaddset(&signals, signal);
+
+                epollHandle = epoll_create1(EPOLL_CLOEXEC);
+                signalHandle = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+                timerHandle = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+                inotifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                wakeHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+                bool success = epollHandle >= 0 && signalHandle >= 0 && timerHandle >= 0 && inotifyHandle >= 0 && wakeHandle >= 0;
+
+                success = success &&
+                    addToEpoll(signalHandle) &&
+                    addToEpoll(timerHandle) &&
+                    addToEpoll(inotifyHandle) &&
+                    addToEpoll(wakeHandle) &&
+                    (!watchStdin || addToEpoll(STDIN_FILENO));
+
+                if (!success){
+                    LOGGER::log("Failed to set up the event loop: " + std::string(strerror(errno)) + ", falling back to separate threads.");
+                    closeHandles();
+                    return false;
+                }
+
+                // The signals are only delivered into the signalfd if no thread has them unblocked, threads created after this inherit the mask.
+                pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+                active = true;
+
+                // Watch the file streams which were opened before the loop existed.
+                for (auto& pair : fileStreamerHandles){
+                    if (pair.second && pair.second->getType() == FILE_STREAM_TYPE::READ)
+                        watchFile(pair.first);
+                }
+
+                armTimer();
+
+                return true;
+            #else
+                return false;
+            #endif
+            }
+
+            bool isActive(){
+                return active;
+            }
+
+            bool dispatch([[maybe_unused]] int timeout){
+            #if defined(__linux__)
+                constexpr int maxEvents = 8;
+                epoll_event events[maxEvents];
+
+                int count = epoll_wait(epollHandle, events, maxEvents, timeout);
+
+                if (count < 0){
+                    if (errno == EINTR)
+                        return true;
+
+                    LOGGER::log("Event loop failed to wait: " + std::string(strerror(errno)));
+                    return false;
+                }
+
+                // Someone else requested the termination, the statics may already be torn down so don't touch anything.
+                if (requestTermination)
+                    return false;
+
+                bool tasksDue = false;
+                std::vector<std::string> modifiedFiles;
+
+                for (int i = 0; i < count; i++){
+                    int handle = events[i].data.fd;
+                    uint64_t expirations = 0;
+
+                    if (handle == STDIN_FILENO){
+                        if (events[i].events & (EPOLLHUP | EPOLLERR)){
+                            // Nothing will ever arrive anymore, stop listening so that we don't spin on it.
+                            epoll_ctl(epollHandle, EPOLL_CTL_DEL, STDIN_FILENO, nullptr);
+                            continue;
+                        }
+
+                        queryInputs();
+                        processQueriedInputs();
+                    }
+                    else if (handle == signalHandle && handleSignals()){
+                        // Signaling the termination lets the main thread exit, so nothing can be done after it.
+                        LOGGER::log("Event loop terminated!");
+                        SignalThreadTermination();
+                        return false;
+                    }
+                    else if (handle == timerHandle){
+                        tasksDue = read(timerHandle, &expirations, sizeof(expirations)) == sizeof(expirations);
+                    }
+                    else if (handle == wakeHandle){
+                        // Only needed for re-arming the timer below.
+                        [[maybe_unused]] ssize_t ignored = read(wakeHandle, &expirations, sizeof(expirations));
+                    }
+                    else if (handle == inotifyHandle){
+                        handleFileEvents(modifiedFiles);
+                    }
+                }
+
+                if ((tasksDue || !modifiedFiles.empty()) && waitForRenderPause()){
+                    if (tasksDue)
+                        runEventTasks();
+
+                    for (const std::string& name : modifiedFiles){
+                        fileStream* stream = getFileStreamHandle(name);
+
+                        if (stream)
+                            stream->changed();
+                    }
+                }
+
+                armTimer();
+
+                return !requestTermination;
+            #else
+                return false;
+            #endif
+            }
+
+            void run(){
+                while (dispatch(-1));
+            }
+
+            int getHandle(){
+            #if defined(__linux__)
+                return epollHandle;
+            #else
+                return -1;
+            #endif
+            }
+
+            void wake(){
+            #if defined(__linux__)
+                if (wakeHandle < 0)
+                    return;
+
+                uint64_t one = 1;
+                [[maybe_unused]] ssize_t ignored = write(wakeHandle, &one, sizeof(one));
+            #endif
+            }
+
+            void watchFile([[maybe_unused]] const std::string& fileName){
+            #if defined(__linux__)
+                if (!active)
+                    return; // init() will pick it up.
+
+                int descriptor = inotify_add_watch(inotifyHandle, fileName.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF);
+
+                if (descriptor < 0){
+                    // Not an error, the file may not exist yet, then it is polled like before.
+                    wake();
+                    return;
+                }
+
+                watches([descriptor, &fileName](std::unordered_map<int, std::string>& self){
+                    self[descriptor] = fileName;
+                });
+            #endif
+            }
+
+            bool isWatched(const std::string& fileName){
+                bool result = false;
+
+                watches.read([&fileName, &result](const std::unordered_map<int, std::string>& self){
+                    for (auto& pair : self){
+                        if (pair.second == fileName){
+                            result = true;
+                            return;
+                        }
+                    }
+                });
+
+                return result;
+            }
+
+            long long nextDeadline(){
+                long long deadline = -1;
+
+                auto closer = [&deadline](long long candidate){
+                    candidate = Max(candidate, 1LL);
+
+                    if (deadline < 0 || candidate < deadline)
+                        deadline = candidate;
+                };
+
+                currentContext->remember.read([&closer](const memoryScheduler& self){
+                    std::chrono::high_resolution_clock::time_point closest;
+                    if (!self.nextDeadline(closest))
+                        return;
+
+                    auto currentTime = CLOCK::now();
+
+                    // recallMemories() only runs memories whose deadline is strictly in the past, retriggered ones have theirs at the beginning of time.
+                    closer(closest < currentTime ? 0 : std::chrono::duration_cast<std::chrono::milliseconds>(closest - currentTime).count() + 1);
+                });
+
+                if (!currentContext->multiFrameCanvas.empty())
+                    closer(CURRENT_UPDATE_SPEED);
+
+                for (auto& pair : fileStreamerHandles){
+                    if (pair.second && pair.second->getType() == FILE_STREAM_TYPE::READ && !isWatched(pair.first)){
+                        closer(MAX_UPDATE_SPEED);
+                        break;
+                    }
+                }
+
+                return deadline;
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef _EVENT_LOOP_H_
+#define _EVENT_LOOP_H_
+
+#include <string>
+
+namespace GGUI {
+    // autoGen: Ignore start
+    namespace INTERNAL {
+        namespace EVENT_LOOP {
+            /**
+             * @brief Sets up the event loop, which replaces the separately timed input, event and signal threads.
+             * @details On Linux this creates one epoll instance over:
+             *          - STDIN, when watchStdin is set.
+             *          - A signalfd for SIGWINCH, SIGINT, SIGTERM and SIGQUIT, these signals are blocked for all threads created after this call.
+             *          - A timerfd, which is armed to the next memory, animation or polled file deadline.
+             *          - An inotify handle for READ file streams.
+             *          - An eventfd, so that other threads can wake the loop when they add new timed work.
+             *          On other platforms, or if any of these fail to be created, nothing is changed and false is returned,
+             *          in which case the caller should fall back into the separate threads.
+             * @param watchStdin Whether user input should be read from STDIN by the loop.
+             * @return True if the loop is ready to be run with run().
+             */
+            extern bool init(bool watchStdin);
+
+            /**
+             * @brief Tells whether init() succeeded, so that the threads it replaces are not started.
+             */
+            extern bool isActive();
+
+            /**
+             * @brief Waits for the events once and dispatches them.
+             * @details - STDIN: queries and processes the input with processQueriedInputs().
+             *          - SIGWINCH: marks the resize into the carry flags and requests a new frame.
+             *          - SIGINT, SIGTERM, SIGQUIT: requests termination.
+             *          - Timer: runs runEventTasks() once the rendering thread is paused.
+             *          - inotify: calls changed() for the modified file streams.
+             *          Afterwards the timer is re-armed to nextDeadline().
+             * @param timeout Milliseconds to wait at most, 0 for not waiting and -1 for waiting until something happens.
+             * @return False once termination has been requested, after which the loop must not be dispatched anymore.
+             */
+            extern bool dispatch(int timeout);
+
+            /**
+             * @brief Dispatches the events until termination is requested.
+             * @details Sleeps in epoll_wait() without timeout, so an idle application does not wake up at all.
+             */
+            extern void run();
+
+            /**
+             * @brief Gives the epoll descriptor of the loop, which becomes readable whenever dispatch() has something to do.
+             * @details Includes the timer, so the descriptor also becomes readable when the next deadline passes.
+             * @return The descriptor, or -1 if the loop is not active.
+             */
+            extern int getHandle();
+
+            /**
+             * @brief Wakes the loop so that it re-calculates its next deadline.
+             * @details Must be called after adding new multi-frame canvases or other timed work from outside the loop, otherwise they would
+             *          only be noticed on the next wake-up. Safe to call from any thread and before init().
+             */
+            extern void wake();
+
+            /**
+             * @brief Starts watching the given file for modifications with inotify.
+             * @details Files which cannot be watched are left for Go_Through_File_Streams() to poll.
+             *          Called for new READ file streams, and by init() for the streams created before it.
+             * @param fileName Name of the file, as given to the file stream.
+             */
+            extern void watchFile(const std::string& fileName);
+
+            /**
+             * @brief Tells whether the file is watched by the loop, in which case there is no need to poll it.
+             * @param fileName Name of the file, as given to the file stream.
+             */
+            extern bool isWatched(const std::string& fileName);
+
+            /**
+             * @brief Calculates how long the loop can sleep before some timed work is due.
+             * @details Takes the smallest of: the time left to the closest memory deadline, the current update speed when multi-frame canvases
+             *          need to be animated and the maximum update speed when there are file streams which need polling.
+             * @return Milliseconds until the next deadline, at least one, or -1 if there is no timed work at all.
+             */
+            extern long long nextDeadline();
+        }
+    }
+    // autoGen: Ignore end
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "fileStreamer.h"
 #include "../renderer.h"
+#include "eventLoop.h"
 
 #include <filesystem>
 
@@ -228,6 +229,10 @@ namespace GGUI{
         if (it == fileStreamerHandles.end()){
             auto fs = std::make_unique<fileStream>(File_Name, Handle, type);
             fileStreamerHandles.emplace(File_Name, std::move(fs));
+
+            // Let the event loop notice modifications instead of polling the file.
+            if (type == FILE_STREAM_TYPE::READ)
+                INTERNAL::EVENT_LOOP::watchFile(File_Name);
         } else {
             it->second->addOnChangeHandler(Handle);
         }
@@ -0,0 +1,436 @@
+#include "frameServer.h"
+#include "constants.h"
+#include "logger.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <array>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__linux__)
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <sys/stat.h>
+    #include <sys/eventfd.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstdint>
+#endif
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace FRAME_SERVER{
+            /**
+             * @brief What a cell looked like in the previously published frame.
+             * @details Owns its text, since the cells of the rendered frame only point into the elements.
+             */
+            struct cellSnapshot{
+                char text[8];
+                unsigned char size = 0;
+                RGB foreground;
+                RGB background;
+            };
+
+            /**
+             * @brief One connected subscriber and its cursor into the ring.
+             */
+            struct subscriber{
+                int handle = -1;
+                unsigned long long next = 0;                    // Sequence of the next change to send, 0 until the first keyframe.
+                std::shared_ptr<const std::string> pending;     // What is being sent right now.
+                size_t offset = 0;                              // How much of pending is already sent.
+                bool blocked = false;                           // The socket buffer is full, wait for it to drain.
+            };
+
+            struct serverState{
+                std::mutex lock;                                // Guards the ring, keyframe and latest.
+                std::array<std::shared_ptr<const std::string>, ringSize> ring;
+                std::shared_ptr<const std::string> keyframe;    // The whole frame of the sequence latest.
+                unsigned long long latest = 0;
+
+                // Only touched by the publishing thread.
+                std::vector<cellSnapshot> previous;
+                unsigned int previousWidth = 0;
+                unsigned int previousHeight = 0;
+
+                // Only touched by the serving thread.
+                std::vector<subscriber> subscribers;
+
+                std::atomic<bool> running = false;
+                std::thread server;
+                std::string path;
+                int listenHandle = -1;
+                int wakeHandle = -1;
+
+                std::atomic<size_t> subscriberCount = 0;
+                std::atomic<size_t> published = 0;
+                std::atomic<size_t> keyframesSent = 0;
+                std::atomic<size_t> diffsSent = 0;
+                std::atomic<unsigned long long> bytesEncoded = 0;
+                std::atomic<unsigned long long> bytesSent = 0;
+            };
+
+            /**
+             * @brief Gives the shared state of the server.
+             * @details Allocated once and never destructed, so that a server still running at exit does not terminate the process.
+             */
+            static serverState& state(){
+                static serverState* instance = new serverState();
+                return *instance;
+            }
+
+            static void append(std::string& result, const compactString& text){
+                result.append(text.text, text.size);
+            }
+
+            static bool unchanged(const cellSnapshot& previous, const UTF& current){
+                return
+                    current.size <= sizeof(previous.text) &&
+                    previous.size == current.size &&
+                    (current.size == 0 || std::memcmp(previous.text, current.text, current.size) == 0) &&
+                    previous.foreground == current.foreground &&
+                    previous.background == current.background;
+            }
+
+            static void remember(cellSnapshot& previous, const UTF& current){
+                // Longer clusters than fit are remembered as empty, so they are always sent.
+                previous.size = current.size <= sizeof(previous.text) ? current.size : 0;
+                if (previous.size > 0)
+                    std::memcpy(previous.text, current.text, previous.size);
+
+                previous.foreground = current.foreground;
+                previous.background = current.background;
+            }
+
+            /**
+             * @brief Encodes the changed cells as runs, each starting with a cursor move to its first cell.
+             */
+            static std::string encodeChanges(serverState& self, const std::vector<UTF>& cells, unsigned int width, unsigned int height){
+                std::string result;
+                superString<constants::ANSI::maximumNeededPreAllocationForEncodedSuperString> cell;
+
+                for (unsigned int y = 0; y < height; y++){
+                    bool inRun = false;
+
+                    for (unsigned int x = 0; x < width; x++){
+                        size_t index = (size_t)y * width + x;
+
+                        if (unchanged(self.previous[index], cells[index])){
+                            inRun = false;
+                            continue;
+                        }
+
+                        if (!inRun){
+                            append(result, constants::ANSI::CSI_CODE);
+                            result += std::to_string(y + 1) + ';' + std::to_string(x + 1) + 'H';
+                            inRun = true;
+                        }
+
+                        cell.clear();
+                        cells[index].toSuperString(&cell);
+
+                        for (size_t i = 0; i < cell.currentIndex; i++)
+                            append(result, cell.data[i]);
+
+                        remember(self.previous[index], cells[index]);
+                    }
+                }
+
+                return result;
+            }
+
+        #if defined(__linux__)
+            static void closeHandle(int& handle){
+                if (handle >= 0)
+                    close(handle);
+                handle = -1;
+            }
+
+            // EAGAIN and EWOULDBLOCK are the same value on Linux, compared twice only where they differ.
+            static bool wouldBlock(int error){
+            #if EAGAIN != EWOULDBLOCK
+                if (error == EWOULDBLOCK)
+                    return true;
+            #endif
+                return error == EAGAIN;
+            }
+
+            /**
+             * @brief Sends to the subscriber until it is up to date or its socket is full.
+             * @details A subscriber which is new, or whose next change has already been overwritten in the ring, skips to the latest keyframe.
+             *          A half sent change is always finished first, so that the stream never breaks in the middle of an escape sequence.
+             * @return False if the subscriber is gone.
+             */
+            static bool flush(serverState& self, subscriber& target){
+                target.blocked = false;
+
+                while (true){
+                    if (!target.pending){
+                        std::lock_guard<std::mutex> hold(self.lock);
+
+                        if (self.latest == 0)
+                            return true;        // Nothing published yet.
+
+                        if (target.next == 0 || target.next + ringSize <= self.latest){
+                            target.pending = self.keyframe;
+                            target.next = self.latest + 1;
+                            self.keyframesSent++;
+                        }
+                        else if (target.next <= self.latest){
+                            target.pending = self.ring[target.next % ringSize];
+                            target.next++;
+                            self.diffsSent++;
+                        }
+                        else{
+                            return true;        // Up to date.
+                        }
+
+                        target.offset = 0;
+                    }
+
+                    ssize_t sent = send(target.handle, target.pending->data() + target.offset, target.pending->size() - target.offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+                    if (sent < 0){
+                        if (wouldBlock(errno)){
+                            target.blocked = true;
+                            return true;
+                        }
+                        return errno == EINTR;
+                    }
+
+                    self.bytesSent += sent;
+                    target.offset += sent;
+
+                    if (target.offset == target.pending->size())
+                        target.pending.reset();
+                }
+            }
+
+            /**
+             * @brief Accepts the subscribers and keeps them fed until stop() is called.
+             */
+            static void serve(){
+                LOGGER::registerCurrentThread();
+
+                serverState& self = state();
+                std::vector<pollfd> polls;
+
+                while (self.running){
+                    polls.clear();
+                    polls.push_back({ self.wakeHandle, POLLIN, 0 });
+                    polls.push_back({ self.listenHandle, POLLIN, 0 });
+
+                    // Subscribers are always polled for reading, so that a disconnect is noticed even when there is nothing to send.
+                    for (subscriber& current : self.subscribers)
+                        polls.push_back({ current.handle, (short)(POLLIN | (current.blocked ? POLLOUT : 0)), 0 });
+
+                    if (poll(polls.data(), polls.size(), -1) < 0){
+                        if (errno == EINTR)
+                            continue;
+
+                        LOGGER::log("Frame server failed to wait: " + std::string(strerror(errno)));
+                        break;
+                    }
+
+                    if (polls[0].revents & POLLIN){
+                        uint64_t published;
+                        [[maybe_unused]] ssize_t ignored = read(self.wakeHandle, &published, sizeof(published));
+                    }
+
+                    if (polls[1].revents & POLLIN){
+                        int handle;
+                        while ((handle = accept4(self.listenHandle, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0){
+                            subscriber joined;
+                            joined.handle = handle;
+                            self.subscribers.push_back(std::move(joined));
+                        }
+                    }
+
+                    // The subscribers accepted just now are not in the polls yet.
+                    for (size_t i = 0; i < self.subscribers.size(); i++){
+                        subscriber& current = self.subscribers[i];
+                        bool alive = true;
+
+                        if (i + 2 < polls.size() && (polls[i + 2].revents & (POLLIN | POLLHUP | POLLERR))){
+                            // Subscribers have nothing to say, anything they send is discarded.
+                            char discard[256];
+                            ssize_t length = recv(current.handle, discard, sizeof(discard), MSG_DONTWAIT);
+
+                            alive = length > 0 || (length < 0 && (wouldBlock(errno) || errno == EINTR));
+                        }
+
+                        if (alive)
+                            alive = flush(self, current);
+
+                        if (!alive)
+                            closeHandle(current.handle);
+                    }
+
+                    self.subscribers.erase(std::remove_if(self.subscribers.begin(), self.subscribers.end(), [](const subscriber& current){
+                        return current.handle < 0;
+                    }), self.subscribers.end());
+
+                    self.subscriberCount = self.subscribers.size();
+                }
+
+                for (subscriber& current : self.subscribers)
+                    closeHandle(current.handle);
+
+                self.subscribers.clear();
+                self.subscriberCount = 0;
+            }
+        #endif
+
+            bool start([[maybe_unused]] const std::string& path){
+            #if defined(__linux__)
+                serverState& self = state();
+
+                if (self.running)
+                    return true;
+
+                sockaddr_un address{};
+                address.sun_family = AF_UNIX;
+
+                if (path.empty() || path.size() >= sizeof(address.sun_path)){
+                    LOGGER::log("Frame server socket path '" + path + "' is empty or too long.");
+                    return false;
+                }
+
+                std::memcpy(address.sun_path, path.c_str(), path.size());
+
+                // Replace the socket left behind by a previous run, but nothing else.
+                struct stat information;
+                if (stat(path.c_str(), &information) == 0 && S_ISSOCK(information.st_mode))
+                    unlink(path.c_str());
+
+                self.listenHandle = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                self.wakeHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+                bool success = self.listenHandle >= 0 && self.wakeHandle >= 0 &&
+                    bind(self.listenHandle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                    listen(self.listenHandle, 16) == 0;
+
+                if (!success){
+                    LOGGER::log("Failed to start the frame server at '" + path + "': " + std::string(strerror(errno)));
+                    closeHandle(self.listenHandle);
+                    closeHandle(self.wakeHandle);
+                    return false;
+                }
+
+                self.path = path;
+                self.running = true;
+                self.server = std::thread(serve);
+
+                LOGGER::log("Frame server listening at '" + path + "'.");
+                return true;
+            #else
+                LOGGER::log("Frame server is only available on Linux.");
+                return false;
+            #endif
+            }
+
+            void stop(){
+            #if defined(__linux__)
+                serverState& self = state();
+
+                if (!self.running)
+                    return;
+
+                self.running = false;
+
+                uint64_t one = 1;
+                [[maybe_unused]] ssize_t ignored = write(self.wakeHandle, &one, sizeof(one));
+
+                if (self.server.joinable())
+                    self.server.join();
+
+                closeHandle(self.listenHandle);
+                closeHandle(self.wakeHandle);
+                unlink(self.path.c_str());
+
+                // The next start() begins with a fresh stream.
+                std::lock_guard<std::mutex> hold(self.lock);
+                self.ring.fill(nullptr);
+                self.keyframe.reset();
+                self.latest = 0;
+                self.previous.clear();
+                self.previousWidth = 0;
+                self.previousHeight = 0;
+            #endif
+            }
+
+            bool isRunning(){
+                return state().running;
+            }
+
+            void publish(const std::vector<UTF>& cells, unsigned int width, unsigned int height, const std::string& encodedFrame){
+            #if defined(__linux__)
+                serverState& self = state();
+
+                if (!self.running || cells.size() < (size_t)width * height)
+                    return;
+
+                bool resized = width != self.previousWidth || height != self.previousHeight;
+                std::string changes;
+
+                if (resized){
+                    // Nothing to compare against, the subscribers redraw everything.
+                    self.previous.assign((size_t)width * height, cellSnapshot());
+                    for (size_t i = 0; i < self.previous.size(); i++)
+                        remember(self.previous[i], cells[i]);
+
+                    self.previousWidth = width;
+                    self.previousHeight = height;
+                }
+                else{
+                    changes = encodeChanges(self, cells, width, height);
+
+                    // Unchanged frames are not copied into a keyframe either.
+                    if (changes.empty())
+                        return;
+                }
+
+                auto keyframe = std::make_shared<std::string>();
+                keyframe->reserve(encodedFrame.size() + constants::ANSI::CLEAR_SCREEN.size + constants::ANSI::SET_CURSOR_TO_START.size);
+                append(*keyframe, constants::ANSI::CLEAR_SCREEN);
+                append(*keyframe, constants::ANSI::SET_CURSOR_TO_START);
+                keyframe->append(encodedFrame);
+
+                std::shared_ptr<const std::string> change = resized ? keyframe : std::make_shared<const std::string>(std::move(changes));
+
+                self.bytesEncoded += change->size();
+                self.published++;
+
+                {
+                    std::lock_guard<std::mutex> hold(self.lock);
+
+                    self.latest++;
+                    self.ring[self.latest % ringSize] = change;
+                    self.keyframe = keyframe;
+                }
+
+                uint64_t one = 1;
+                [[maybe_unused]] ssize_t ignored = write(self.wakeHandle, &one, sizeof(one));
+            #endif
+            }
+
+            serverStats getStats(){
+                serverState& self = state();
+
+                serverStats result;
+                result.subscribers = self.subscriberCount;
+                result.published = self.published;
+                result.keyframesSent = self.keyframesSent;
+                result.diffsSent = self.diffsSent;
+                result.bytesEncoded = self.bytesEncoded;
+                result.bytesSent = self.bytesSent;
+
+                return result;
+            }
+        }
+    }
+}
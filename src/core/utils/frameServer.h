@@ -0,0 +1,68 @@
+#ifndef _FRAME_SERVER_H_
+#define _FRAME_SERVER_H_
+
+#include <string>
+#include <vector>
+
+#include "utf.h"
+
+namespace GGUI {
+    // autoGen: Ignore start
+    namespace INTERNAL {
+        namespace FRAME_SERVER {
+            // How many published frames are kept for the subscribers to catch up from, before they are given a keyframe instead.
+            constexpr unsigned int ringSize = 64;
+
+            /**
+             * @brief Counters of the frame server since it was started.
+             */
+            struct serverStats{
+                size_t subscribers = 0;
+                size_t published = 0;               // Frames encoded into the ring, once for all subscribers.
+                size_t keyframesSent = 0;           // Full frames given to new and lagging subscribers.
+                size_t diffsSent = 0;
+                unsigned long long bytesEncoded = 0;
+                unsigned long long bytesSent = 0;
+            };
+
+            /**
+             * @brief Starts listening for subscribers on a Unix domain socket and serves them from their own thread.
+             * @details A leftover socket at the path from a previous run is replaced. Given with --frameServer=<path>.
+             * @param path File system path of the socket.
+             * @return True if the server is running.
+             */
+            extern bool start(const std::string& path);
+
+            /**
+             * @brief Disconnects all subscribers, stops the serving thread and removes the socket.
+             */
+            extern void stop();
+
+            /**
+             * @brief Tells whether start() has succeeded and stop() has not been called since.
+             */
+            extern bool isRunning();
+
+            /**
+             * @brief Encodes the changes from the previously published frame once and queues them for all subscribers.
+             * @details Each subscriber keeps its own cursor into a ring of the last ringSize changes. A subscriber whose cursor
+             *          falls out of the ring, and a newly connected one, is given the latest keyframe and continues from there,
+             *          so a slow subscriber never makes the others, or the rendering, wait for it.
+             *          A size change publishes the keyframe as the change.
+             * @param cells The rendered frame, row by row.
+             * @param width Width of the frame in cells.
+             * @param height Height of the frame in cells.
+             * @param encodedFrame The same frame as already encoded for the terminal, used as the keyframe.
+             */
+            extern void publish(const std::vector<UTF>& cells, unsigned int width, unsigned int height, const std::string& encodedFrame);
+
+            /**
+             * @brief Gives a copy of the counters.
+             */
+            extern serverStats getStats();
+        }
+    }
+    // autoGen: Ignore end
+}
+
+#endif
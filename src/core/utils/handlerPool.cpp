@@ -0,0 +1,226 @@
+#include "handlerPool.h"
+#include "eventLoop.h"
+#include "settings.h"
+#include "trace.h"
+#include "../renderer.h"
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace HANDLER_POOL{
+            struct queuedJob{
+                const void* owner;
+                context* session;       // The context of the submitting thread, which the job runs in.
+                std::string id;
+                std::function<bool()> job;
+                inputCause cause;       // The input the submitting handler reacts to, for the frames the job requests.
+            };
+
+            struct poolState{
+                std::mutex lock;
+                std::condition_variable available;     // Signaled to the workers when a job is queued.
+                std::condition_variable finished;      // Signaled to forget() and waitIdle() when a job is done.
+                std::deque<queuedJob> queue;
+                std::vector<const void*> running;      // Owners of the jobs currently running, one entry per busy worker.
+
+                atomic::guard<std::unordered_map<std::string, handlerStats>> stats;
+            };
+
+            // Set once the workers are started, so that destroying elements costs nothing when no async handlers are in use.
+            static std::atomic<bool> started = false;
+
+            // The owner whose job runs on this thread, nullptr outside of the workers.
+            static thread_local const void* currentOwner = nullptr;
+            static thread_local const std::string* currentId = nullptr;
+            static thread_local bool worker = false;
+
+            /**
+             * @brief Gives the shared state of the pool.
+             * @details Allocated once and never destructed, since the detached workers may still be waiting on it while the statics are torn down at exit.
+             */
+            static poolState& state(){
+                static poolState* instance = new poolState();
+                return *instance;
+            }
+
+            /**
+             * @brief Runs the queued jobs one at a time until the process exits.
+             */
+            static void work(){
+                LOGGER::registerCurrentThread();
+                worker = true;
+
+                poolState& self = state();
+                std::unique_lock<std::mutex> hold(self.lock);
+
+                while (true){
+                    self.available.wait(hold, [&self](){ return !self.queue.empty(); });
+
+                    queuedJob current = std::move(self.queue.front());
+                    self.queue.pop_front();
+                    self.running.push_back(current.owner);
+                    currentOwner = current.owner;
+                    currentId = &current.id;
+                    currentContext = current.session;
+                    activeCause = current.cause;
+
+                    hold.unlock();
+
+                    auto start = std::chrono::high_resolution_clock::now();
+
+                    try{
+                        GGUI_TRACE_SCOPE_DETAIL("eventHandler", current.id);
+
+                        if (!current.job())
+                            INTERNAL::reportStack("Job '" + current.id + "' failed!");
+                    }
+                    catch(std::exception& problem){
+                        INTERNAL::reportStack("In event: '" + current.id + "' Problem: " + std::string(problem.what()));
+                    }
+
+                    record(current.id, std::chrono::high_resolution_clock::now() - start, true);
+
+                    // Release the captures of the handler before its owner is let to be destroyed.
+                    current.job = nullptr;
+
+                    // The posted mutations need a wake-up in cooperative mode, where nothing else is waiting for frame requests.
+                    EVENT_LOOP::wake();
+
+                    hold.lock();
+                    currentOwner = nullptr;
+                    currentId = nullptr;
+                    activeCause = inputCause();
+                    self.running.erase(std::find(self.running.begin(), self.running.end(), current.owner));
+                    self.finished.notify_all();
+                }
+            }
+
+            void submit(const void* owner, const std::string& id, std::function<bool()> job){
+                poolState& self = state();
+
+                {
+                    std::lock_guard<std::mutex> hold(self.lock);
+
+                    if (!started){
+                        // Half of the cores, so that the workers don't compete with the rendering and input threads.
+                        unsigned int count = Min(Max(std::thread::hardware_concurrency() / 2, 1u), 4u);
+
+                        for (unsigned int i = 0; i < count; i++)
+                            std::thread(work).detach();
+
+                        started = true;
+                    }
+
+                    self.queue.push_back({ owner, currentContext, id, std::move(job), activeCause });
+                }
+
+                self.available.notify_one();
+            }
+
+            void forget(const void* owner){
+                if (!started)
+                    return;
+
+                poolState& self = state();
+                std::unique_lock<std::mutex> hold(self.lock);
+
+                self.queue.erase(std::remove_if(self.queue.begin(), self.queue.end(), [owner](const queuedJob& job){
+                    return job.owner == owner;
+                }), self.queue.end());
+
+                // A handler may destroy its own element, in which case its own job is the one left running.
+                size_t ownRunning = currentOwner == owner ? 1 : 0;
+
+                self.finished.wait(hold, [&self, owner, ownRunning](){
+                    return (size_t)std::count(self.running.begin(), self.running.end(), owner) <= ownRunning;
+                });
+            }
+
+            void waitIdle(){
+                if (!started)
+                    return;
+
+                poolState& self = state();
+                std::unique_lock<std::mutex> hold(self.lock);
+
+                self.finished.wait(hold, [&self](){
+                    return self.queue.empty() && self.running.empty();
+                });
+            }
+
+            bool isWorker(){
+                return worker;
+            }
+
+            void reportDirectChange(){
+                if (!currentId)
+                    return;
+
+                const std::string& id = *currentId;
+                bool first = false;
+
+                state().stats([&](std::unordered_map<std::string, handlerStats>& self){
+                    handlerStats& entry = self[id];
+
+                    entry.id = id;
+                    entry.async = true;
+                    first = entry.directChanges++ == 0;
+                });
+
+                // Only the first one is reported, the rest are counted into the accounting.
+                if (first)
+                    LOGGER::log("Async handler '" + id + "' changed the elements directly from its worker, racing the rendering thread. Make its changes inside pauseGGUI(f), batch(f) or post().");
+            }
+
+            void record(const std::string& id, std::chrono::nanoseconds duration, bool async){
+                unsigned long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+                unsigned long long budget = SETTINGS::handlerBudget * 1000;
+                bool firstOverrun = false;
+
+                state().stats([&](std::unordered_map<std::string, handlerStats>& self){
+                    handlerStats& entry = self[id];
+
+                    entry.id = id;
+                    entry.async = async;
+                    entry.calls++;
+                    entry.totalMicroseconds += microseconds;
+                    entry.maxMicroseconds = Max(entry.maxMicroseconds, microseconds);
+
+                    if (budget > 0 && microseconds > budget)
+                        firstOverrun = entry.overBudget++ == 0;
+                });
+
+                // Only the first overrun is logged, the rest are counted into the accounting.
+                if (firstOverrun){
+                    LOGGER::log(
+                        "Handler '" + id + "' took " + std::to_string(microseconds / 1000) + " ms, over the budget of " + std::to_string(SETTINGS::handlerBudget) + " ms" +
+                        (async ? "." : ", consider registering it as async.")
+                    );
+                }
+            }
+
+            std::vector<handlerStats> getStats(){
+                std::vector<handlerStats> result;
+
+                state().stats.read([&result](const std::unordered_map<std::string, handlerStats>& self){
+                    for (auto& pair : self)
+                        result.push_back(pair.second);
+                });
+
+                // Most expensive first.
+                std::sort(result.begin(), result.end(), [](const handlerStats& a, const handlerStats& b){
+                    return a.totalMicroseconds > b.totalMicroseconds;
+                });
+
+                return result;
+            }
+        }
+    }
+}
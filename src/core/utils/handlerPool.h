@@ -0,0 +1,78 @@
+#ifndef _HANDLER_POOL_H_
+#define _HANDLER_POOL_H_
+
+#include <string>
+#include <functional>
+#include <chrono>
+#include <vector>
+
+namespace GGUI {
+    // autoGen: Ignore start
+    namespace INTERNAL {
+        namespace HANDLER_POOL {
+            /**
+             * @brief Execution time accounting of one event handler, identified by the ID of its action.
+             */
+            struct handlerStats{
+                std::string id;
+                bool async = false;
+                size_t calls = 0;
+                size_t overBudget = 0;      // Calls which took longer than SETTINGS::handlerBudget.
+                size_t directChanges = 0;   // Frame requests of an async handler which changed the elements directly, see reportDirectChange().
+                unsigned long long totalMicroseconds = 0;
+                unsigned long long maxMicroseconds = 0;
+            };
+
+            /**
+             * @brief Queues the job to be run on one of the worker threads, which are started on the first submit.
+             * @details The job runs in the context of the calling thread, is timed like the inline handlers and a job returning false is reported as a failed job.
+             *          While the job runs, pauseGGUI(f) and batch(f) post their function with GGUI::post() instead of waiting,
+             *          so the mutations of the handler are applied by the rendering thread at the start of the next frame.
+             *          Mutations made outside of them race the rendering thread, and are counted by reportDirectChange().
+             * @param owner The element the handler belongs to, so that forget() can drop its jobs when the element is destroyed.
+             * @param id ID of the handler for the accounting and the reports.
+             * @param job The handler with its event already bound.
+             */
+            extern void submit(const void* owner, const std::string& id, std::function<bool()> job);
+
+            /**
+             * @brief Drops the queued jobs of the owner and waits for its running ones to finish.
+             * @details Called by the element destructor. Does not wait for the job which is running on the calling thread itself.
+             * @param owner The element being destroyed.
+             */
+            extern void forget(const void* owner);
+
+            /**
+             * @brief Blocks until the queue is empty and no job is running.
+             */
+            extern void waitIdle();
+
+            /**
+             * @brief Tells whether the calling thread is a worker which is running an async handler.
+             */
+            extern bool isWorker();
+
+            /**
+             * @brief Counts a change which the async handler running on this worker made to the elements directly, and reports it the first time.
+             * @details Called by updateFrame() on the workers. Such a change races the rendering thread, it belongs into pauseGGUI(f), batch(f) or post().
+             */
+            extern void reportDirectChange();
+
+            /**
+             * @brief Adds one call of the handler into its accounting and reports it the first time it goes over SETTINGS::handlerBudget.
+             * @param id ID of the handler.
+             * @param duration How long the call took.
+             * @param async Whether the call ran on a worker.
+             */
+            extern void record(const std::string& id, std::chrono::nanoseconds duration, bool async);
+
+            /**
+             * @brief Gives a copy of the accounting of all the handlers called so far.
+             */
+            extern std::vector<handlerStats> getStats();
+        }
+    }
+    // autoGen: Ignore end
+}
+
+#endif
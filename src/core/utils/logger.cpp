@@ -9,6 +9,8 @@
 #include <functional>
 #include <vector>
 #include <string>
+#include <mutex>
+#include <condition_variable>
 
 #ifndef GGUI_RELEASE
     #if _WIN32
@@ -66,6 +68,12 @@ namespace GGUI{
             thread_local guardedQueue* localQueue = new guardedQueue();
             INTERNAL::atomic::guard<std::vector<guardedQueue*>> AllQueues;
 
+            // Lets report() wake up the logger thread, so that it doesn't need to poll the queues while nothing is reported.
+            // Never destructed, since the detached logger thread is still waiting on it while the statics are torn down at exit.
+            std::mutex reportsMutex;
+            std::condition_variable* reportsArrived = new std::condition_variable();
+            bool reportsPending = false;
+
             /**
              * @brief Initializes the logger file stream if it is uninitialized.
              *
@@ -487,7 +495,7 @@ namespace GGUI{
             symbolInfo->SizeOfStruct = sizeof(SYMBOL_INFO);
 
             // Ensure any global visual layout constants are updated
-            if (maxWidth == 0) {
+            if (currentContext->maxWidth == 0) {
                 updateMaxWidthAndHeight(); // Presumed external function
             }
 
@@ -495,7 +503,7 @@ namespace GGUI{
             std::string formattedStackTrace = "Stack Trace:\n";
             int visualDepthIndex = 0;
 
-            const bool enableIndentation = capturedFrameCount < (Max((signed)maxWidth, 0) / 2);
+            const bool enableIndentation = capturedFrameCount < (Max((signed)currentContext->maxWidth, 0) / 2);
 
             // Traverse stack frames in reverse (from newest to oldest)
             for (int frameIndex = capturedFrameCount - 1; frameIndex > 0; --frameIndex) {
@@ -688,12 +696,12 @@ namespace GGUI{
             }
 
             // Ensure UI constraints are initialized before printing
-            if (maxWidth == 0) {
+            if (currentContext->maxWidth == 0) {
                 updateMaxWidthAndHeight();
             }
 
             std::string formattedTrace = "Stack Trace:\n";
-            bool useIndentation = static_cast<unsigned int>(capturedFrameCount) < (maxWidth / 2);
+            bool useIndentation = static_cast<unsigned int>(capturedFrameCount) < (currentContext->maxWidth / 2);
             int currentIndentLevel = 0;
 
             // Iterate backwards through the captured frames, omitting the frame that called reportStack
@@ -764,13 +772,13 @@ namespace GGUI{
                     INTERNAL::LOGGER::log(problem);
 
                     // reportStack is called when the height or width is zero at init, so we dont ned to compute further.
-                    if (INTERNAL::maxHeight == 0 || INTERNAL::maxWidth == 0){
+                    if (INTERNAL::currentContext->maxHeight == 0 || INTERNAL::currentContext->maxWidth == 0){
                         return;
                     }
 
                     std::string Problem = " " + problem + " ";
 
-                    if (INTERNAL::main && (INTERNAL::maxWidth != 0 && INTERNAL::maxHeight != 0)){
+                    if (INTERNAL::currentContext->main && (INTERNAL::currentContext->maxWidth != 0 && INTERNAL::currentContext->maxHeight != 0)){
                         bool Create_New_Line = true;
 
                         // First check if there already is a report log.
@@ -875,22 +883,20 @@ namespace GGUI{
                         }
 
                         // If the user has disabled the Inspect_Tool then the errors appear as an popup window ,which disappears after 30s.
-                        if (Error_Logger->getParent() == INTERNAL::main){
+                        if (Error_Logger->getParent() == INTERNAL::currentContext->main){
                             Error_Logger->display(true);
 
-                            INTERNAL::remember([Error_Logger](std::vector<memory>& rememberable){
-                                rememberable.push_back(memory(
-                                    TIME::SECOND * 30,
-                                    [Error_Logger](GGUI::event*){
-                                        //delete tmp;
-                                        Error_Logger->display(false);
-                                        //job successfully done
-                                        return true;
-                                    },
-                                    MEMORY_FLAGS::PROLONG_MEMORY,
-                                    "Report Logger Clearer"
-                                ));
-                            });
+                            addMemory(memory(
+                                TIME::SECOND * 30,
+                                [Error_Logger](GGUI::event*){
+                                    //delete tmp;
+                                    Error_Logger->display(false);
+                                    //job successfully done
+                                    return true;
+                                },
+                                MEMORY_FLAGS::PROLONG_MEMORY,
+                                "Report Logger Clearer"
+                            ));
                         }
 
                     }
@@ -919,37 +925,69 @@ namespace GGUI{
             }
         }
 
-        void loggerThread(){
-            while (true){
-                LOGGER::queue LinearQueue(true);
-
-                // First we'll quickly do a checkup into the AllQueues and look if there is anything to log.
-                LOGGER::AllQueues([&LinearQueue](std::vector<LOGGER::guardedQueue*>& self){
-                    for (auto* queue : self){
-                        // Pause the current queue
-                        (*queue)([&LinearQueue](LOGGER::queue& self2){
-                            self2.flushInto(LinearQueue);
-                        });
-                    }
-                });
-                
-                int LinearQueueSize = LinearQueue.handle->size();
+        size_t LOGGER::getQueuedBytes(){
+            size_t bytes = 0;
 
-                while (!LinearQueue.handle->empty()){
-                    std::string CurrentProblem = LinearQueue.handle->front();
-                    LinearQueue.handle->pop();
+            LOGGER::AllQueues([&bytes](std::vector<LOGGER::guardedQueue*>& self){
+                for (auto* queue : self){
+                    (*queue)([&bytes](LOGGER::queue& self2){
+                        if (!self2.handle)
+                            return;
 
-                    renderLogger(CurrentProblem);
+                        // std::queue does not expose its storage, so the reports are counted by their own sizes.
+                        std::queue<std::string> copy = *self2.handle;
+                        for (; !copy.empty(); copy.pop())
+                            bytes += sizeof(std::string) + copy.front().capacity();
+                    });
+                }
+            });
+
+            return bytes;
+        }
+
+        /**
+         * @brief Renders everything reported with GGUI::report() from all the registered threads.
+         * @return The number of reports rendered.
+         */
+        size_t flushReports(){
+            LOGGER::queue LinearQueue(true);
+
+            // First we'll quickly do a checkup into the AllQueues and look if there is anything to log.
+            LOGGER::AllQueues([&LinearQueue](std::vector<LOGGER::guardedQueue*>& self){
+                for (auto* queue : self){
+                    // Pause the current queue
+                    (*queue)([&LinearQueue](LOGGER::queue& self2){
+                        self2.flushInto(LinearQueue);
+                    });
                 }
+            });
+            
+            size_t LinearQueueSize = LinearQueue.handle->size();
 
-                unsigned int SleepTime = GGUI::TIME::SECOND;
+            while (!LinearQueue.handle->empty()){
+                std::string CurrentProblem = LinearQueue.handle->front();
+                LinearQueue.handle->pop();
 
-                if (LinearQueueSize != 0){
-                    // If there was something to log, then we can sleep less.
-                    SleepTime = GGUI::TIME::MILLISECOND * 100;
+                renderLogger(CurrentProblem);
+            }
+
+            delete LinearQueue.handle;
+
+            return LinearQueueSize;
+        }
+
+        void loggerThread(){
+            while (true){
+                if (flushReports() != 0){
+                    // Give the reports some time to pile up, so that a burst of them doesn't pause the renderer for each one.
+                    std::this_thread::sleep_for(std::chrono::milliseconds(GGUI::TIME::MILLISECOND * 100));
+                    continue;
                 }
 
-                std::this_thread::sleep_for(std::chrono::milliseconds(SleepTime));
+                // Nothing was reported, so sleep until report() says otherwise.
+                std::unique_lock lock(LOGGER::reportsMutex);
+                LOGGER::reportsArrived->wait(lock, [](){ return LOGGER::reportsPending; });
+                LOGGER::reportsPending = false;
             }
         }
 
@@ -963,6 +1001,12 @@ namespace GGUI{
                 INTERNAL::LOGGER::log("Unregistered thread: " + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + " reported: " + problem);
             }
         });
+
+        {
+            std::unique_lock lock(INTERNAL::LOGGER::reportsMutex);
+            INTERNAL::LOGGER::reportsPending = true;
+        }
+        INTERNAL::LOGGER::reportsArrived->notify_one();
     }
 
 }
\ No newline at end of file
@@ -21,10 +21,17 @@ namespace GGUI{
             extern void log(std::string Text);
 
             extern void registerCurrentThread();
+
+            /**
+             * @brief Gives the bytes of the reports waiting in the queues of all the registered threads.
+             */
+            extern size_t getQueuedBytes();
         }
         
         extern void reportStack(const std::string& problemDescription);
 
+        extern size_t flushReports();
+
         extern void loggerThread();
     }
     // autoGen: Ignore end
@@ -0,0 +1,154 @@
+#include "memoryUsage.h"
+#include "logger.h"
+#include "../renderer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#elif defined(__linux__)
+    #include <unistd.h>
+#endif
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace MEMORY_USAGE{
+            static std::vector<element*> allElements(){
+                if (!currentContext->main)
+                    return {};
+
+                // The hidden ones hold their buffers all the same.
+                return currentContext->main->getAllNestedElements(true);
+            }
+
+            static elementUsage usageOf(const element* self){
+                elementUsage usage;
+                usage.name = self->getName();
+                self->accountMemory(usage);
+
+                return usage;
+            }
+
+            std::vector<elementUsage> top(size_t count){
+                std::vector<elementUsage> usages;
+
+                for (element* current : allElements())
+                    usages.push_back(usageOf(current));
+
+                std::sort(usages.begin(), usages.end(), [](const elementUsage& a, const elementUsage& b){
+                    return a.total() > b.total();
+                });
+
+                if (count && usages.size() > count)
+                    usages.resize(count);
+
+                return usages;
+            }
+
+            std::vector<subsystemUsage> subsystems(){
+                std::vector<subsystemUsage> result;
+
+                subsystemUsage elements{"elements"};
+                for (element* current : allElements()){
+                    elements.bytes += usageOf(current).total();
+                    elements.count++;
+                }
+                result.push_back(elements);
+
+                // The encoding buffers reused from frame to frame, the cells themselves are the render buffer of the main element.
+                subsystemUsage frame{"frame"};
+                frame.bytes = currentContext->encodedFrame.capacity() +
+                              currentContext->liquifiedText.getCapacity() * sizeof(compactString) +
+                              sizeof(currentContext->liquifyContainer) +
+                              currentContext->cellFingerprints.capacity() * sizeof(uint64_t);
+                frame.count = currentContext->cellFingerprints.size();
+                result.push_back(frame);
+
+                subsystemUsage events{"events"};
+                events.bytes = currentContext->eventHandlers.capacity() * sizeof(element*) +
+                               currentContext->inputs.capacity() * sizeof(input*) + currentContext->inputs.size() * sizeof(input) +
+                               currentContext->spareInputs.capacity() * sizeof(std::unique_ptr<input>) + currentContext->spareInputs.size() * sizeof(input);
+                events.count = currentContext->eventHandlers.size();
+
+                currentContext->remember.read([&events](const memoryScheduler& self){
+                    events.bytes += self.getMemoryUsage();
+                    events.count += self.size();
+                });
+                result.push_back(events);
+
+                subsystemUsage names{"names"};
+                for (auto& [key, named] : currentContext->elementNames)
+                    names.bytes += sizeof(std::pair<const std::string, element*>) + key.capacity();
+                names.count = currentContext->elementNames.size();
+                result.push_back(names);
+
+                subsystemUsage classes{"classes"};
+                currentContext->classes.read([&classes](const std::unordered_map<int, styling>& self){
+                    for (auto& [id, style] : self)
+                        classes.bytes += sizeof(int) + style.getMemoryUsage();
+                    classes.count = self.size();
+                });
+                result.push_back(classes);
+
+                subsystemUsage logger{"logger"};
+                logger.bytes = LOGGER::getQueuedBytes();
+                result.push_back(logger);
+
+                return result;
+            }
+
+            size_t residentBytes(){
+            #if defined(_WIN32)
+                // The kernel32 export, so that psapi does not need to be linked.
+                PROCESS_MEMORY_COUNTERS counters;
+                if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+                    return counters.WorkingSetSize;
+                return 0;
+            #elif defined(__linux__)
+                // The second field of statm is the resident pages.
+                FILE* statm = std::fopen("/proc/self/statm", "r");
+                if (!statm)
+                    return 0;
+
+                unsigned long long pages = 0, resident = 0;
+                int read = std::fscanf(statm, "%llu %llu", &pages, &resident);
+                std::fclose(statm);
+
+                return read == 2 ? resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+            #else
+                return 0;
+            #endif
+            }
+
+            std::string toJSON(const std::vector<subsystemUsage>& systems, const std::vector<elementUsage>& elements){
+                std::string result = "{\"resident\":" + std::to_string(residentBytes()) + ",\"subsystems\":{";
+
+                for (size_t i = 0; i < systems.size(); i++){
+                    result += (i ? ",\"" : "\"") + systems[i].name + "\":{\"bytes\":" + std::to_string(systems[i].bytes) +
+                              ",\"count\":" + std::to_string(systems[i].count) + "}";
+                }
+
+                result += "},\"elements\":[";
+
+                for (size_t i = 0; i < elements.size(); i++){
+                    const elementUsage& usage = elements[i];
+
+                    std::string name;
+                    for (char c : usage.name){
+                        if (c == '"' || c == '\\')
+                            name += '\\';
+                        name += c;
+                    }
+
+                    result += std::string(i ? "," : "") + "{\"name\":\"" + name + "\",\"object\":" + std::to_string(usage.object) +
+                              ",\"renderBuffer\":" + std::to_string(usage.renderBuffer) + ",\"style\":" + std::to_string(usage.style) +
+                              ",\"content\":" + std::to_string(usage.content) + "}";
+                }
+
+                return result + "]}";
+            }
+        }
+    }
+}
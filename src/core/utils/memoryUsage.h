@@ -0,0 +1,63 @@
+#ifndef _MEMORY_USAGE_H_
+#define _MEMORY_USAGE_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace GGUI {
+    namespace INTERNAL {
+        /**
+         * @brief Accounts the bytes held by each element and by each subsystem of the current context, on request.
+         * @details Nothing is tracked while rendering, the containers are walked when asked, so the figures are their capacities
+         *          at that moment. Memory owned by the standard library itself (map nodes, allocator overhead) is not included.
+         *          The Inspect tool lists the subsystems and the heaviest elements.
+         */
+        namespace MEMORY_USAGE {
+            /**
+             * @brief The bytes held by one element, filled by element::accountMemory().
+             */
+            struct elementUsage {
+                std::string name;
+                size_t object = 0;          // The element object itself, its name and its handlers.
+                size_t renderBuffer = 0;    // The cells it renders into.
+                size_t style = 0;           // Its styling, with the unparsed style chain.
+                size_t content = 0;         // What the element type holds besides, like the text and its line cache, or the sprites.
+
+                size_t total() const { return object + renderBuffer + style + content; }
+            };
+
+            /**
+             * @brief The bytes held by one subsystem, for example "elements", "frame", "events" or "logger".
+             */
+            struct subsystemUsage {
+                std::string name;
+                size_t bytes = 0;
+                size_t count = 0;           // Of the things it holds, like elements, scheduled memories or queued reports.
+            };
+
+            /**
+             * @brief Gives the heaviest elements of the current context, heaviest first.
+             * @param count How many to give at most, zero for all of them.
+             */
+            extern std::vector<elementUsage> top(size_t count);
+
+            /**
+             * @brief Gives the bytes held by each subsystem of the current context.
+             */
+            extern std::vector<subsystemUsage> subsystems();
+
+            /**
+             * @brief Gives the resident set size of the process in bytes, or zero where it cannot be read.
+             */
+            extern size_t residentBytes();
+
+            /**
+             * @brief Formats the subsystems and the elements as one line of JSON, together with the resident set size.
+             */
+            extern std::string toJSON(const std::vector<subsystemUsage>& systems, const std::vector<elementUsage>& elements);
+        }
+    }
+}
+
+#endif
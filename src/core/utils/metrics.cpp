@@ -0,0 +1,225 @@
+#include "metrics.h"
+#include "logger.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace METRICS{
+            struct registry{
+                std::mutex lock;
+                std::map<std::string, std::unique_ptr<counter>> counters;
+                std::map<std::string, std::unique_ptr<histogram>> histograms;
+            };
+
+            static registry& state(){
+                static registry* instance = new registry();
+                return *instance;
+            }
+
+            unsigned int histogram::bucketOf(uint64_t value){
+                if (value < subBuckets)
+                    return value;
+
+            #if defined(_MSC_VER)
+                unsigned long highest = 0;
+                _BitScanReverse64(&highest, value);
+                unsigned int exponent = highest;
+            #else
+                unsigned int exponent = 63 - __builtin_clzll(value);
+            #endif
+                unsigned int sub = (value >> (exponent - subBucketBits)) & (subBuckets - 1);
+
+                return subBuckets + (exponent - subBucketBits) * subBuckets + sub;
+            }
+
+            uint64_t histogram::highestOf(unsigned int bucket){
+                if (bucket < subBuckets)
+                    return bucket;
+
+                unsigned int exponent = (bucket - subBuckets) / subBuckets + subBucketBits;
+                uint64_t sub = (bucket - subBuckets) % subBuckets;
+                uint64_t width = 1ULL << (exponent - subBucketBits);
+
+                return ((subBuckets + sub) << (exponent - subBucketBits)) + (width - 1);
+            }
+
+            void histogram::record(uint64_t value){
+                buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+                count.fetch_add(1, std::memory_order_relaxed);
+                sum.fetch_add(value, std::memory_order_relaxed);
+
+                uint64_t current = max.load(std::memory_order_relaxed);
+                while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+
+                current = min.load(std::memory_order_relaxed);
+                while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+            }
+
+            uint64_t histogram::getMin() const{
+                uint64_t lowest = min.load(std::memory_order_relaxed);
+                return lowest == UINT64_MAX ? 0 : lowest;
+            }
+
+            double histogram::getMean() const{
+                uint64_t recorded = getCount();
+                return recorded ? (double)sum.load(std::memory_order_relaxed) / (double)recorded : 0;
+            }
+
+            uint64_t histogram::getPercentile(double percentile) const{
+                // The buckets are summed instead of using count, which may already include a value whose bucket is not yet added.
+                uint64_t total = 0;
+                for (const std::atomic<uint64_t>& bucket : buckets)
+                    total += bucket.load(std::memory_order_relaxed);
+
+                if (total == 0)
+                    return 0;
+
+                uint64_t wanted = (uint64_t)std::ceil(total * std::min(std::max(percentile, 0.0), 100.0) / 100.0);
+                if (wanted == 0)
+                    wanted = 1;
+
+                uint64_t seen = 0;
+                for (unsigned int i = 0; i < bucketCount; i++){
+                    seen += buckets[i].load(std::memory_order_relaxed);
+
+                    if (seen >= wanted)
+                        return std::min(highestOf(i), getMax());
+                }
+
+                return getMax();
+            }
+
+            void histogram::reset(){
+                for (std::atomic<uint64_t>& bucket : buckets)
+                    bucket.store(0, std::memory_order_relaxed);
+
+                count.store(0, std::memory_order_relaxed);
+                sum.store(0, std::memory_order_relaxed);
+                max.store(0, std::memory_order_relaxed);
+                min.store(UINT64_MAX, std::memory_order_relaxed);
+            }
+
+            uint64_t snapshot::getCounter(const std::string& name) const{
+                for (const auto& [counterName, value] : counters)
+                    if (counterName == name)
+                        return value;
+
+                return 0;
+            }
+
+            histogramSnapshot snapshot::getHistogram(const std::string& name) const{
+                for (const histogramSnapshot& current : histograms)
+                    if (current.name == name)
+                        return current;
+
+                return histogramSnapshot();
+            }
+
+            counter& getCounter(const std::string& name){
+                registry& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                std::unique_ptr<counter>& result = self.counters[name];
+                if (!result)
+                    result = std::make_unique<counter>();
+
+                return *result;
+            }
+
+            histogram& getHistogram(const std::string& name, const std::string& unit){
+                registry& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                std::unique_ptr<histogram>& result = self.histograms[name];
+                if (!result)
+                    result = std::make_unique<histogram>(unit);
+
+                return *result;
+            }
+
+            snapshot takeSnapshot(){
+                registry& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                snapshot result;
+
+                for (auto& [name, current] : self.counters)
+                    result.counters.emplace_back(name, current->get());
+
+                for (auto& [name, current] : self.histograms){
+                    histogramSnapshot entry;
+                    entry.name = name;
+                    entry.unit = current->getUnit();
+                    entry.count = current->getCount();
+                    entry.min = current->getMin();
+                    entry.max = current->getMax();
+                    entry.mean = current->getMean();
+                    entry.p50 = current->getPercentile(50);
+                    entry.p95 = current->getPercentile(95);
+                    entry.p99 = current->getPercentile(99);
+
+                    result.histograms.push_back(entry);
+                }
+
+                return result;
+            }
+
+            std::string toJSON(const snapshot& current){
+                std::ostringstream result;
+
+                long long time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                result << "{\"time\":" << time << ",\"counters\":{";
+
+                for (size_t i = 0; i < current.counters.size(); i++)
+                    result << (i ? "," : "") << '"' << current.counters[i].first << "\":" << current.counters[i].second;
+
+                result << "},\"histograms\":{";
+
+                for (size_t i = 0; i < current.histograms.size(); i++){
+                    const histogramSnapshot& entry = current.histograms[i];
+
+                    result << (i ? "," : "") << '"' << entry.name << "\":{\"unit\":\"" << entry.unit << "\",\"count\":" << entry.count
+                           << ",\"min\":" << entry.min << ",\"mean\":" << (uint64_t)entry.mean << ",\"p50\":" << entry.p50
+                           << ",\"p95\":" << entry.p95 << ",\"p99\":" << entry.p99 << ",\"max\":" << entry.max << "}";
+                }
+
+                result << "}}";
+                return result.str();
+            }
+
+            bool dump(const std::string& path){
+                std::ofstream file(path, std::ios::app);
+
+                if (!file.is_open()){
+                    LOGGER::log("Failed to open '" + path + "' for the metrics.");
+                    return false;
+                }
+
+                file << toJSON(takeSnapshot()) << '\n';
+                return file.good();
+            }
+
+            void resetAll(){
+                registry& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                for (auto& [name, current] : self.counters)
+                    current->reset();
+
+                for (auto& [name, current] : self.histograms)
+                    current->reset();
+            }
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef _METRICS_H_
+#define _METRICS_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GGUI {
+    namespace INTERNAL {
+        /**
+         * @brief Process wide counters and latency histograms, updated by the render, input and event threads without locks.
+         * @details The metrics are created by name on first use and live until the exit, so the hot paths look them up once
+         *          and keep the reference. Read them with takeSnapshot(), or periodically into a file with --metrics=<file>.
+         *          GGUI records these itself:
+         *           - frames.presented, frames.identical and frames.dropped: counters of the rendered frames.
+         *           - bytes.written: counter of the encoded frame bytes given to the backend.
+         *           - frame.time (ns): whole renderCycle() of the presented frames, frame.render, frame.encode and frame.output (ns) its phases.
+         *           - frame.bytes (bytes) and frame.cellsChanged (cells): size and reach of each presented frame.
+         *           - input.time (ns): translating the input and running its event handlers.
+         *           - input.latency (ns): from the raw input being read to the write of the first frame showing its changes.
+         *           - event.time (ns): one round of the memories, file streams and animations.
+         *           - frame.allocations (allocations): heap allocations of each renderCycle(), only when ALLOCATIONS::isCounting().
+         */
+        namespace METRICS {
+            // A frame which takes longer than one refresh of a 60 Hz display is counted as dropped.
+            constexpr uint64_t frameBudgetNanoseconds = 1000000000 / 60;
+
+            /**
+             * @brief A monotonic count of events.
+             */
+            class counter {
+            public:
+                void add(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+                uint64_t get() const { return value.load(std::memory_order_relaxed); }
+                void reset() { value.store(0, std::memory_order_relaxed); }
+
+            private:
+                std::atomic<uint64_t> value = 0;
+            };
+
+            /**
+             * @brief Distribution of recorded values in log-linear buckets, like an HDR histogram with 16 sub-buckets per power of two.
+             * @details Values below 16 are exact, larger ones are kept within 6.25% of their value. Recording is a few relaxed atomic
+             *          additions, so any thread can record while others read the percentiles.
+             */
+            class histogram {
+            public:
+                static constexpr unsigned int subBucketBits = 4;
+                static constexpr unsigned int subBuckets = 1 << subBucketBits;
+                static constexpr unsigned int bucketCount = subBuckets + (64 - subBucketBits) * subBuckets;
+
+                histogram(const std::string& Unit = "ns") : unit(Unit) {}
+
+                /**
+                 * @brief Adds the value into the distribution.
+                 */
+                void record(uint64_t value);
+
+                uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+                uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+                uint64_t getMin() const;
+                double getMean() const;
+
+                /**
+                 * @brief Gives the value below or at which the given percentage of the recorded values are.
+                 * @param percentile From 0 to 100.
+                 * @return The highest value of the bucket it falls into, at most the largest recorded value. Zero if nothing was recorded.
+                 */
+                uint64_t getPercentile(double percentile) const;
+
+                /**
+                 * @brief Unit of the values, like "ns", "bytes" or "cells".
+                 */
+                const std::string& getUnit() const { return unit; }
+
+                void reset();
+
+                /**
+                 * @brief Gives the bucket of the value.
+                 */
+                static unsigned int bucketOf(uint64_t value);
+
+                /**
+                 * @brief Gives the highest value which falls into the bucket.
+                 */
+                static uint64_t highestOf(unsigned int bucket);
+
+            private:
+                std::string unit;
+                std::atomic<uint64_t> buckets[bucketCount] = {};
+                std::atomic<uint64_t> count = 0;
+                std::atomic<uint64_t> sum = 0;
+                std::atomic<uint64_t> max = 0;
+                std::atomic<uint64_t> min = UINT64_MAX;
+            };
+
+            struct histogramSnapshot {
+                std::string name;
+                std::string unit;
+                uint64_t count = 0;
+                uint64_t min = 0;
+                uint64_t max = 0;
+                double mean = 0;
+                uint64_t p50 = 0;
+                uint64_t p95 = 0;
+                uint64_t p99 = 0;
+            };
+
+            struct snapshot {
+                std::vector<std::pair<std::string, uint64_t>> counters;
+                std::vector<histogramSnapshot> histograms;
+
+                /**
+                 * @brief Gives the value of the counter, zero if it does not exist.
+                 */
+                uint64_t getCounter(const std::string& name) const;
+
+                /**
+                 * @brief Gives the histogram, an empty one if it does not exist.
+                 */
+                histogramSnapshot getHistogram(const std::string& name) const;
+            };
+
+            /**
+             * @brief Gives the counter with the name, created on first use.
+             */
+            extern counter& getCounter(const std::string& name);
+
+            /**
+             * @brief Gives the histogram with the name, created with the unit on first use.
+             */
+            extern histogram& getHistogram(const std::string& name, const std::string& unit = "ns");
+
+            /**
+             * @brief Reads all of the metrics, sorted by name.
+             */
+            extern snapshot takeSnapshot();
+
+            /**
+             * @brief Formats the snapshot as one line of JSON.
+             */
+            extern std::string toJSON(const snapshot& current);
+
+            /**
+             * @brief Appends the current snapshot as one line of JSON into the file, given as --metrics=<file> which does it every second.
+             * @return False if the file could not be opened.
+             */
+            extern bool dump(const std::string& path);
+
+            /**
+             * @brief Zeroes all of the metrics, for example between benchmark runs.
+             */
+            extern void resetAll();
+        }
+    }
+}
+
+#endif
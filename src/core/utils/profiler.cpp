@@ -0,0 +1,207 @@
+#include "profiler.h"
+#include "logger.h"
+#include "../renderer.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace PROFILER{
+            struct elementCost{
+                unsigned long long renders = 0;
+                unsigned long long dirtyRenders = 0;
+                unsigned long long renderNanoseconds = 0;
+                unsigned long long childNanoseconds = 0;
+                unsigned long long nestNanoseconds = 0;
+                unsigned long long cellsTouched = 0;
+            };
+
+            struct profilerState{
+                std::mutex lock;
+                std::unordered_map<const element*, elementCost> costs;
+                unsigned long long frames = 0;      // Profiled renders of the main element.
+            };
+
+            static profilerState& state(){
+                static profilerState* instance = new profilerState();
+                return *instance;
+            }
+
+            static std::atomic<bool> enabled = false;
+
+            // Set once anything was accounted, so that destroying elements costs nothing when the profiler was never used.
+            static std::atomic<bool> used = false;
+
+            // The innermost render being accounted on this thread.
+            static thread_local renderScope* currentScope = nullptr;
+
+            static unsigned long long nanosecondsBetween(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end){
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            }
+
+            void enable(bool State){
+                if (State)
+                    used.store(true, std::memory_order_relaxed);
+
+                enabled.store(State, std::memory_order_relaxed);
+            }
+
+            bool isEnabled(){
+                return enabled.load(std::memory_order_relaxed);
+            }
+
+            void reset(){
+                profilerState& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                self.costs.clear();
+                self.frames = 0;
+            }
+
+            renderScope::renderScope(element* Parent, element* Child){
+                if (!enabled.load(std::memory_order_relaxed))
+                    return;
+
+                parent = Parent;
+                child = Child;
+                dirty = !Child->getDirty().is(STAIN_TYPE::CLEAN);
+                previous = currentScope;
+                currentScope = this;
+                start = std::chrono::high_resolution_clock::now();
+            }
+
+            void renderScope::nesting(size_t Cells){
+                if (!child)
+                    return;
+
+                rendered = std::chrono::high_resolution_clock::now();
+                cells = Cells;
+                currentScope = previous;
+            }
+
+            renderScope::~renderScope(){
+                if (!child)
+                    return;
+
+                auto end = std::chrono::high_resolution_clock::now();
+                bool nested = rendered != std::chrono::high_resolution_clock::time_point();
+
+                unsigned long long renderDuration = nanosecondsBetween(start, nested ? rendered : end);
+                unsigned long long nestDuration = nested ? nanosecondsBetween(rendered, end) : 0;
+
+                if (!nested)
+                    currentScope = previous;
+
+                profilerState& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                elementCost& own = self.costs[child];
+                own.renders++;
+                own.renderNanoseconds += renderDuration;
+
+                if (dirty){
+                    own.dirtyRenders++;
+                    own.cellsTouched += child->getWidth() * child->getHeight();
+                }
+
+                if (parent){
+                    elementCost& host = self.costs[parent];
+                    host.childNanoseconds += renderDuration;
+                    host.nestNanoseconds += nestDuration;
+                    host.cellsTouched += cells;
+                }
+                else{
+                    self.frames++;
+                }
+            }
+
+            void markDirty(const element* self){
+                if (currentScope && currentScope->child == self)
+                    currentScope->dirty = true;
+            }
+
+            void forget(const element* self){
+                if (!used.load(std::memory_order_relaxed))
+                    return;
+
+                profilerState& profiler = state();
+                std::lock_guard<std::mutex> hold(profiler.lock);
+
+                profiler.costs.erase(self);
+            }
+
+            std::vector<elementReport> top(size_t count){
+                std::vector<elementReport> reports;
+
+                {
+                    profilerState& self = state();
+                    std::lock_guard<std::mutex> hold(self.lock);
+
+                    // The costs are averaged over all the profiled frames, so that the rarely rendered elements rank by their share.
+                    double frames = (double)std::max(self.frames, 1ULL);
+
+                    for (auto& [profiled, cost] : self.costs){
+                        elementReport report;
+                        report.name = profiled->getName();
+                        report.renders = cost.renders;
+                        report.dirtyRenders = cost.dirtyRenders;
+                        report.renderNanoseconds = cost.renderNanoseconds / frames;
+                        report.selfNanoseconds = (cost.renderNanoseconds - std::min(cost.childNanoseconds, cost.renderNanoseconds)) / frames;
+                        report.nestNanoseconds = cost.nestNanoseconds / frames;
+                        report.cellsTouched = cost.cellsTouched / frames;
+
+                        reports.push_back(report);
+                    }
+                }
+
+                std::sort(reports.begin(), reports.end(), [](const elementReport& a, const elementReport& b){
+                    return a.selfNanoseconds + a.nestNanoseconds > b.selfNanoseconds + b.nestNanoseconds;
+                });
+
+                if (count && reports.size() > count)
+                    reports.resize(count);
+
+                return reports;
+            }
+
+            std::string toCSV(const std::vector<elementReport>& reports){
+                std::string result = "name,renders,dirtyRenders,renderNanoseconds,selfNanoseconds,nestNanoseconds,cellsTouched\n";
+                char numbers[160];
+
+                for (const elementReport& report : reports){
+                    // The names may contain commas or quotes, so they are always quoted.
+                    result += '"';
+                    for (char c : report.name){
+                        if (c == '"')
+                            result += '"';
+                        result += c;
+                    }
+                    result += '"';
+
+                    std::snprintf(numbers, sizeof(numbers), ",%llu,%llu,%.0f,%.0f,%.0f,%.1f\n",
+                        report.renders, report.dirtyRenders, report.renderNanoseconds, report.selfNanoseconds, report.nestNanoseconds, report.cellsTouched);
+                    result += numbers;
+                }
+
+                return result;
+            }
+
+            bool dump(const std::string& path){
+                std::ofstream file(path, std::ios::trunc);
+
+                if (!file.is_open()){
+                    LOGGER::log("Failed to open '" + path + "' for the element profile.");
+                    return false;
+                }
+
+                file << toCSV(top(0));
+                return file.good();
+            }
+        }
+    }
+}
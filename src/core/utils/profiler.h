@@ -0,0 +1,111 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+
+namespace GGUI {
+    class element;
+
+    namespace INTERNAL {
+        /**
+         * @brief Opt-in render cost accounting per element, collected by the rendering thread.
+         * @details Enabled with --elementProfile=<file>, which also writes the report into the file on exit, or with enable().
+         *          Every element rendered while enabled accumulates the time in its render() and in nesting its children,
+         *          the cells it re-rendered or nested, and in how many frames it had changes. The Inspect tool lists the costliest.
+         *          While disabled a render costs one relaxed load.
+         */
+        namespace PROFILER {
+            /**
+             * @brief The cost of one element, averaged over the profiled frames.
+             */
+            struct elementReport {
+                std::string name;
+                unsigned long long renders = 0;         // Frames in which its render() was called.
+                unsigned long long dirtyRenders = 0;    // Of which it had changes to render.
+                double renderNanoseconds = 0;           // In its render(), its children included.
+                double selfNanoseconds = 0;             // In its render(), without its children and their nesting.
+                double nestNanoseconds = 0;             // Nesting its children into its buffer.
+                double cellsTouched = 0;                // Cells re-rendered into its buffer or nested into it.
+            };
+
+            /**
+             * @brief Starts or stops the accounting, the accumulated costs are kept until reset().
+             */
+            extern void enable(bool state);
+
+            /**
+             * @brief Tells whether the renders are accounted.
+             */
+            extern bool isEnabled();
+
+            /**
+             * @brief Forgets the accumulated costs and the count of profiled frames.
+             */
+            extern void reset();
+
+            /**
+             * @brief Gives the costliest elements by their own render and nesting time per frame, costliest first.
+             * @param count How many to give at most, zero for all of them.
+             */
+            extern std::vector<elementReport> top(size_t count);
+
+            /**
+             * @brief Formats the reports as CSV with a header line, the times in nanoseconds per profiled frame.
+             */
+            extern std::string toCSV(const std::vector<elementReport>& reports);
+
+            /**
+             * @brief Writes the report of all the profiled elements into the file as CSV.
+             * @return False if the file could not be written.
+             */
+            extern bool dump(const std::string& path);
+
+            // autoGen: Ignore start
+            /**
+             * @brief Accounts the render() of the child into the child and as child time into the parent, and then the nesting of its buffer into the parent.
+             * @details The render lasts until nesting() is called or the scope ends, the nesting from there to the end of the scope.
+             *          Both are committed at the end with one lock. The main element is given without a parent, which also counts one profiled frame.
+             */
+            class renderScope {
+            public:
+                renderScope(element* Parent, element* Child);
+                ~renderScope();
+
+                renderScope(const renderScope&) = delete;
+                renderScope& operator=(const renderScope&) = delete;
+
+                /**
+                 * @brief Ends the render and starts the nesting of the given count of cells into the parent.
+                 */
+                void nesting(size_t Cells);
+
+            private:
+                friend void markDirty(const element* self);
+
+                element* parent = nullptr;
+                element* child = nullptr;      // Null when not accounted.
+                bool dirty = false;
+                size_t cells = 0;
+                renderScope* previous = nullptr;
+                std::chrono::high_resolution_clock::time_point start;
+                std::chrono::high_resolution_clock::time_point rendered;     // Set by nesting().
+            };
+
+            /**
+             * @brief Tells the render being accounted that the element had changes, for the cases which the stains before the render do not show.
+             */
+            extern void markDirty(const element* self);
+
+            /**
+             * @brief Drops the costs of the element, called by its destructor.
+             */
+            extern void forget(const element* self);
+            // autoGen: Ignore end
+        }
+    }
+}
+
+#endif
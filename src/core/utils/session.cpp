@@ -0,0 +1,352 @@
+#include "session.h"
+#include "clock.h"
+#include "backend.h"
+#include "eventLoop.h"
+#include "../renderer.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <mutex>
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace SESSION{
+            // Identifies the file and its format version.
+            static const std::string magic = "GGUISES1";
+
+            enum class recordType : unsigned char{
+                INPUT = 1,      // Length and the raw bytes read from the terminal.
+                RESIZE = 2,     // New width and height.
+                END = 3,        // Nothing, only the time from the last event to the end of the recording.
+            };
+
+            static struct{
+                std::mutex lock;
+                std::ofstream file;
+                CLOCK::timePoint previous;
+                bool active = false;
+            } recorder;
+
+            /**
+             * @brief Appends the number seven bits at a time, the high bit telling whether more follow.
+             */
+            static void writeNumber(std::string& result, unsigned long long value){
+                do{
+                    unsigned char part = value & 0x7F;
+                    value >>= 7;
+
+                    if (value)
+                        part |= 0x80;
+
+                    result += (char)part;
+                } while (value);
+            }
+
+            /**
+             * @brief Reads a number written by writeNumber().
+             * @return False if the data ends in the middle of the number.
+             */
+            static bool readNumber(const std::string& data, size_t& offset, unsigned long long& value){
+                value = 0;
+
+                for (unsigned int shift = 0; offset < data.size() && shift < 64; shift += 7){
+                    unsigned char part = data[offset++];
+                    value |= (unsigned long long)(part & 0x7F) << shift;
+
+                    if (!(part & 0x80))
+                        return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * @brief Writes one record with the time passed since the previous one.
+             */
+            static void writeRecord(recordType type, const std::string& payload){
+                std::lock_guard<std::mutex> hold(recorder.lock);
+
+                if (!recorder.active)
+                    return;
+
+                CLOCK::timePoint currentTime = CLOCK::now();
+
+                std::string record;
+                record += (char)type;
+                writeNumber(record, std::chrono::duration_cast<std::chrono::microseconds>(currentTime - recorder.previous).count());
+                record += payload;
+
+                recorder.previous = currentTime;
+
+                // Flushed right away, so that a crash still leaves the session up to it behind.
+                recorder.file.write(record.data(), record.size());
+                recorder.file.flush();
+            }
+
+            bool startRecording(const std::string& path){
+                std::lock_guard<std::mutex> hold(recorder.lock);
+
+                if (recorder.active)
+                    recorder.file.close();
+
+                recorder.file.open(path, std::ios::binary | std::ios::trunc);
+
+                if (!recorder.file.is_open()){
+                    LOGGER::log("Failed to open '" + path + "' for recording the session.");
+                    recorder.active = false;
+                    return false;
+                }
+
+                std::string header = magic;
+                writeNumber(header, currentContext->maxWidth);
+                writeNumber(header, currentContext->maxHeight);
+
+                recorder.file.write(header.data(), header.size());
+                recorder.previous = CLOCK::now();
+                recorder.active = true;
+
+                LOGGER::log("Recording the session into '" + path + "'.");
+                return true;
+            }
+
+            void stopRecording(){
+                // The time after the last event is replayed too, for what the memories and animations did in it.
+                writeRecord(recordType::END, "");
+
+                std::lock_guard<std::mutex> hold(recorder.lock);
+
+                if (!recorder.active)
+                    return;
+
+                recorder.file.close();
+                recorder.active = false;
+            }
+
+            bool isRecording(){
+                return recorder.active;
+            }
+
+            void recordInput(const char* data, size_t size){
+                std::string payload;
+                writeNumber(payload, size);
+                payload.append(data, size);
+
+                writeRecord(recordType::INPUT, payload);
+            }
+
+            void recordResize(unsigned int width, unsigned int height){
+                std::string payload;
+                writeNumber(payload, width);
+                writeNumber(payload, height);
+
+                writeRecord(recordType::RESIZE, payload);
+            }
+
+            uint64_t checksum(const char* data, size_t size, uint64_t seed){
+                uint64_t result = seed;
+
+                for (size_t i = 0; i < size; i++){
+                    result ^= (unsigned char)data[i];
+                    result *= 0x100000001b3ULL;
+                }
+
+                return result;
+            }
+
+            /**
+             * @brief Renders one frame of the current context like the rendering thread would, and measures it.
+             */
+            static frameReport renderMeasured(unsigned long long time){
+                // In cooperative mode the ticket is in use, frames requested by the input are taken like tick() does.
+                bool taken = currentContext->ticket.take();
+
+                renderCycle();
+
+                if (taken)
+                    finishRenderCycle();
+
+                frameReport result;
+                result.time = time;
+                result.presented = !currentContext->identicalFrame;
+
+                if (result.presented){
+                    result.renderNanoseconds = currentContext->lastFrame.render;
+                    result.encodeNanoseconds = currentContext->lastFrame.encode;
+                    result.outputNanoseconds = currentContext->lastFrame.output;
+
+                    // Backends which send the cells as they are have no encoded frame.
+                    if (currentContext->frameBuffer){
+                        result.bytes = currentContext->frameBuffer->size();
+                        result.checksum = checksum(currentContext->frameBuffer->data(), currentContext->frameBuffer->size());
+                    }
+                }
+
+                return result;
+            }
+
+            /**
+             * @brief Runs the event tasks falling due until the given time, with a frame after each round like the live session would.
+             * @details The memories, multi-frame canvases and polled file streams move on with the time, not with the input, so they are
+             *          run at their own deadlines on the way to the next record.
+             * @param origin The start of the replay on the virtual clock.
+             * @param elapsed Microseconds replayed so far, moved to the last deadline run.
+             * @param until Microseconds of the next record.
+             */
+            static void runDueTasks(CLOCK::timePoint origin, unsigned long long& elapsed, unsigned long long until, replayReport& report){
+                while (true){
+                    long long wait = EVENT_LOOP::nextDeadline();
+
+                    if (wait < 0 || elapsed + wait * 1000ULL > until)
+                        return;
+
+                    elapsed += wait * 1000ULL;
+                    CLOCK::setVirtual(origin + std::chrono::microseconds(elapsed));
+
+                    runEventTasks();
+                    report.frames.push_back(renderMeasured(elapsed));
+                }
+            }
+
+            bool replay(const std::string& path, replayReport& report){
+                std::ifstream file(path, std::ios::binary);
+
+                if (!file.is_open()){
+                    LOGGER::log("Failed to open the recorded session '" + path + "'.");
+                    return false;
+                }
+
+                std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                size_t offset = magic.size();
+                unsigned long long width = 0, height = 0;
+
+                if (data.compare(0, magic.size(), magic) != 0 || !readNumber(data, offset, width) || !readNumber(data, offset, height)){
+                    LOGGER::log("'" + path + "' is not a recorded session.");
+                    return false;
+                }
+
+                headlessBackend* headless = dynamic_cast<headlessBackend*>(currentContext->output);
+
+                if (headless)
+                    headless->resize(width, height);
+
+                report = replayReport();
+                report.checksum = checksum(nullptr, 0);
+
+                CLOCK::timePoint origin = CLOCK::now();
+                unsigned long long elapsed = 0;     // Where the virtual clock is, since the start.
+                unsigned long long recorded = 0;    // When the latest record happened, since the start.
+                uint64_t previousChecksum = 0;
+                bool intact = true;
+                bool refused = false;
+
+                CLOCK::setVirtual(origin);
+
+                // The frame of the starting size, before any of the events.
+                report.frames.push_back(renderMeasured(elapsed));
+
+                while (offset < data.size()){
+                    recordType type = (recordType)data[offset++];
+                    unsigned long long delta = 0;
+
+                    if (!readNumber(data, offset, delta)){
+                        intact = false;
+                        break;
+                    }
+
+                    recorded += delta;
+                    runDueTasks(origin, elapsed, recorded, report);
+
+                    elapsed = recorded;
+                    CLOCK::setVirtual(origin + std::chrono::microseconds(elapsed));
+
+                    if (type == recordType::INPUT){
+                        unsigned long long length = 0;
+
+                        if (!readNumber(data, offset, length) || offset + length > data.size()){
+                            intact = false;
+                            break;
+                        }
+
+                        // Translated the same way as when it was read, in pieces as large as the raw input takes.
+                        for (size_t given = 0; given < length;){
+                            size_t taken = setRawInput(data.data() + offset + given, length - given);
+
+                            // Platforms which do not read their input as raw bytes take none of it.
+                            if (taken == 0){
+                                refused = true;
+                                break;
+                            }
+
+                            given += taken;
+                            processQueriedInputs();
+                        }
+
+                        if (refused)
+                            break;
+
+                        offset += length;
+                    }
+                    else if (type == recordType::RESIZE){
+                        unsigned long long newWidth = 0, newHeight = 0;
+
+                        if (!readNumber(data, offset, newWidth) || !readNumber(data, offset, newHeight)){
+                            intact = false;
+                            break;
+                        }
+
+                        if (headless)
+                            headless->resize(newWidth, newHeight);
+                    }
+                    else if (type == recordType::END){
+                        // Only brings the clock to the end of the recording.
+                    }
+                    else{
+                        intact = false;
+                        break;
+                    }
+
+                    report.frames.push_back(renderMeasured(elapsed));
+                }
+
+                CLOCK::useReal();
+
+                if (refused){
+                    LOGGER::log("The recorded session '" + path + "' cannot be replayed, this platform does not take raw input.");
+                    return false;
+                }
+
+                for (frameReport& frame : report.frames){
+                    if (!frame.presented){
+                        frame.checksum = previousChecksum;
+                        continue;
+                    }
+
+                    report.checksum = checksum(reinterpret_cast<const char*>(&frame.checksum), sizeof(frame.checksum), report.checksum);
+                    previousChecksum = frame.checksum;
+                }
+
+                if (!intact)
+                    LOGGER::log("The recorded session '" + path + "' ends in the middle of a record, replayed up to it.");
+
+                return true;
+            }
+
+            std::string formatReport(const replayReport& report){
+                std::ostringstream result;
+
+                result << "frame\ttime_us\tpresented\trender_ns\tencode_ns\toutput_ns\tbytes\tchecksum\n";
+
+                for (size_t i = 0; i < report.frames.size(); i++){
+                    const frameReport& frame = report.frames[i];
+
+                    result << i << '\t' << frame.time << '\t' << frame.presented << '\t'
+                        << frame.renderNanoseconds << '\t' << frame.encodeNanoseconds << '\t' << frame.outputNanoseconds << '\t'
+                        << frame.bytes << '\t' << std::hex << std::setw(16) << std::setfill('0') << frame.checksum << std::dec << '\n';
+                }
+
+                return result.str();
+            }
+        }
+    }
+}
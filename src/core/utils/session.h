@@ -0,0 +1,88 @@
+#ifndef _SESSION_H_
+#define _SESSION_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GGUI {
+    // autoGen: Ignore start
+    namespace INTERNAL {
+        namespace SESSION {
+            /**
+             * @brief What a replay measured for the frame after one recorded event, or after one round of the event tasks due before it.
+             */
+            struct frameReport{
+                unsigned long long time = 0;        // Microseconds since the start of the recording.
+                bool presented = false;             // False if the event did not change the frame.
+                long long renderNanoseconds = 0;
+                long long encodeNanoseconds = 0;
+                long long outputNanoseconds = 0;
+                size_t bytes = 0;                   // Size of the encoded frame.
+                uint64_t checksum = 0;              // FNV-1a of the encoded frame, the previous one if nothing was presented.
+            };
+
+            struct replayReport{
+                std::vector<frameReport> frames;
+                uint64_t checksum = 0;              // Of all the presented frames in order, equal between identical replays.
+            };
+
+            /**
+             * @brief Starts writing the terminal input and resizes into the file, given as --record=<file>.
+             * @details The file starts with the size of the output, followed by one record per read of queryInputs() or resize,
+             *          each with the microseconds passed since the previous one, with the numbers as variable length integers.
+             *          stopRecording() ends it with the time passed since the last of them.
+             * @param path Where the session is written, replaced if it exists.
+             * @return True if the file could be opened.
+             */
+            extern bool startRecording(const std::string& path);
+
+            /**
+             * @brief Flushes and closes the recording.
+             */
+            extern void stopRecording();
+
+            /**
+             * @brief Tells whether a recording is in progress.
+             */
+            extern bool isRecording();
+
+            /**
+             * @brief Appends the raw bytes read from the terminal into the recording.
+             */
+            extern void recordInput(const char* data, size_t size);
+
+            /**
+             * @brief Appends a resize of the output into the recording.
+             */
+            extern void recordResize(unsigned int width, unsigned int height);
+
+            /**
+             * @brief Feeds the recorded session back through Translate_Inputs() on the virtual clock and renders a frame after each event.
+             * @details On the way to each event the memories, multi-frame canvases and file streams falling due are run at their own
+             *          deadlines, each followed by a frame, so that the time driven changes are replayed with the input.
+             *          Must be called from the thread which renders the current context: in cooperative mode, or for a context without
+             *          the rendering thread. A headless backend is resized as recorded, the other backends keep their size.
+             *          The clock returns to the real time afterwards.
+             * @param path The recorded session.
+             * @param report Filled with the measurements of each frame.
+             * @return False if the file could not be read, is not a recorded session, or the platform does not take raw input.
+             */
+            extern bool replay(const std::string& path, replayReport& report);
+
+            /**
+             * @brief Formats the report as one tab separated line per frame, after a header line.
+             */
+            extern std::string formatReport(const replayReport& report);
+
+            /**
+             * @brief 64-bit FNV-1a hash of the bytes.
+             * @param seed Hash to continue from, for hashing multiple pieces as one.
+             */
+            extern uint64_t checksum(const char* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+        }
+    }
+    // autoGen: Ignore end
+}
+
+#endif
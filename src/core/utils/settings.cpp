@@ -18,6 +18,14 @@ namespace GGUI {
         bool wordWrapping = true;
         bool enableGammaCorrection = false;
         bool enableDRM = false;
+        bool headless = false;
+        bool cooperative = false;
+        unsigned long long handlerBudget = 16;  // Milliseconds
+        std::string frameServer = "";
+        std::string record = "";
+        std::string trace = "";
+        std::string metrics = "";
+        std::string elementProfile = "";
         
         namespace LOGGER {
             std::string fileName = "";
@@ -167,6 +175,108 @@ namespace GGUI {
                     }
                 ),
                 
+                argumentDescriptor(
+                    "headless",
+                    argumentType::FLAG,
+                    "Render into memory instead of the terminal, for benchmarks and tests (default: false)",
+                    [](const std::string&) {
+                        headless = true;
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "cooperative",
+                    argumentType::FLAG,
+                    "Run without internal threads, the application drives GGUI with GGUI::tick() (default: false)",
+                    [](const std::string&) {
+                        cooperative = true;
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "handlerBudget",
+                    argumentType::UNSIGNED_LONG,
+                    "Set the time in milliseconds an event handler may take before it is reported, 0 to disable (default: 16)",
+                    [](const std::string& value) {
+                        try {
+                            handlerBudget = std::stoull(value);
+                        } catch (const std::exception& e) {
+                            INTERNAL::LOGGER::log("Error: Invalid value for handlerBudget: " + value);
+                            INTERNAL::LOGGER::log("Expected an unsigned integer value.");
+                        }
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "frameServer",
+                    argumentType::STRING,
+                    "Stream the frames to subscribers of the given Unix domain socket (default: disabled)",
+                    [](const std::string& value) {
+                        std::string cleanvalue = value;
+                        // Remove quotes if present
+                        if (cleanvalue.length() >= 2 && cleanvalue.front() == '"' && cleanvalue.back() == '"') {
+                            cleanvalue = cleanvalue.substr(1, cleanvalue.length() - 2);
+                        }
+                        frameServer = cleanvalue;
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "record",
+                    argumentType::STRING,
+                    "Record the terminal input and resizes into the given file for replaying (default: disabled)",
+                    [](const std::string& value) {
+                        std::string cleanvalue = value;
+                        // Remove quotes if present
+                        if (cleanvalue.length() >= 2 && cleanvalue.front() == '"' && cleanvalue.back() == '"') {
+                            cleanvalue = cleanvalue.substr(1, cleanvalue.length() - 2);
+                        }
+                        record = cleanvalue;
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "trace",
+                    argumentType::STRING,
+                    "Record the frame stages and dump them into the given file on exit, in the Chrome trace format (default: disabled)",
+                    [](const std::string& value) {
+                        std::string cleanvalue = value;
+                        // Remove quotes if present
+                        if (cleanvalue.length() >= 2 && cleanvalue.front() == '"' && cleanvalue.back() == '"') {
+                            cleanvalue = cleanvalue.substr(1, cleanvalue.length() - 2);
+                        }
+                        trace = cleanvalue;
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "metrics",
+                    argumentType::STRING,
+                    "Append a snapshot of the frame metrics into the given file every second, one JSON object per line (default: disabled)",
+                    [](const std::string& value) {
+                        std::string cleanvalue = value;
+                        // Remove quotes if present
+                        if (cleanvalue.length() >= 2 && cleanvalue.front() == '"' && cleanvalue.back() == '"') {
+                            cleanvalue = cleanvalue.substr(1, cleanvalue.length() - 2);
+                        }
+                        metrics = cleanvalue;
+                    }
+                ),
+                
+                argumentDescriptor(
+                    "elementProfile",
+                    argumentType::STRING,
+                    "Account the render cost of each element, shown in the Inspect tool and written into the given file on exit as CSV (default: disabled)",
+                    [](const std::string& value) {
+                        std::string cleanvalue = value;
+                        // Remove quotes if present
+                        if (cleanvalue.length() >= 2 && cleanvalue.front() == '"' && cleanvalue.back() == '"') {
+                            cleanvalue = cleanvalue.substr(1, cleanvalue.length() - 2);
+                        }
+                        elementProfile = cleanvalue;
+                    }
+                ),
+                
                 argumentDescriptor(
                     "help",
                     argumentType::FLAG,
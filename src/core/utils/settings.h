@@ -91,6 +91,30 @@ namespace GGUI {
         // Given as --enableDRM
         extern bool enableDRM;
 
+        // Given as --headless
+        extern bool headless;                       // Render into memory instead of the terminal, see INTERNAL::headlessBackend
+
+        // Given as --cooperative
+        extern bool cooperative;
+
+        // Given as --handlerBudget = 16
+        extern unsigned long long handlerBudget;    // Milliseconds, 0 disables the budget
+
+        // Given as --frameServer = "/tmp/ggui.sock"
+        extern std::string frameServer;             // Unix domain socket to stream the frames into, empty disables the server
+
+        // Given as --record = "session.bin"
+        extern std::string record;                  // File to record the input and resizes into for INTERNAL::SESSION::replay(), empty disables the recording
+
+        // Given as --trace = "trace.json"
+        extern std::string trace;                   // File to dump the INTERNAL::TRACE spans into on exit, empty disables the tracing
+
+        // Given as --metrics = "metrics.jsonl"
+        extern std::string metrics;                 // File to append an INTERNAL::METRICS snapshot into every second, empty disables the dumping
+
+        // Given as --elementProfile = "elements.csv"
+        extern std::string elementProfile;          // File to write the INTERNAL::PROFILER report into on exit, empty disables the profiling
+
         extern void parseCommandLineArguments(int argc, char** argv);
 
         /**
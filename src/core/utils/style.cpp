@@ -420,13 +420,14 @@ namespace GGUI{
     }
 
     INTERNAL::STAIN_TYPE onClick::embedValue([[maybe_unused]] styling* host, element* owner){
-        owner->onClick([this, owner](event*){
+        // The value is copied, since the style object may be a temporary which is gone by the time of the click.
+        owner->onClick([job = value, owner](event*){
             // The default, on_click wont do anything.
             // It will call the provided lambda (if any) and return true (allowing the event to propagate).
             if (dynamic_cast<switchBox*>(owner))
                 INTERNAL::DisableOthers((switchBox*)owner);
 
-            return this->value(owner);
+            return job(owner);
         });
 
         return INTERNAL::STAIN_TYPE::CLEAN;
@@ -713,6 +714,8 @@ namespace GGUI{
             // Then set the current_attribute into the nested one
             current_attribute = current_attribute->next;
         }
+
+        ownsUnParsedStyles = unParsedStyles != nullptr;
     }
 
     void styling::copyUnParsedStyles(const styling* other){
@@ -732,6 +735,18 @@ namespace GGUI{
             writer = writer->next; // Move to the next element in the writer styling object
             reader = reader->next; // Move to the next element in the other styling object
         }
+
+        ownsUnParsedStyles = unParsedStyles != nullptr;
+    }
+
+    size_t styling::getMemoryUsage() const{
+        size_t bytes = sizeof(styling) + Childs.capacity() * sizeof(element*);
+
+        // A chain which is not owned may point into the stack of the constructor, so only the deep copies are walked.
+        for (const STYLING_INTERNAL::styleBase* current = ownsUnParsedStyles ? unParsedStyles : nullptr; current; current = current->next)
+            bytes += current->getSize();
+
+        return bytes;
     }
 
     /**
@@ -803,8 +818,16 @@ namespace GGUI{
             if (dish)
                 // now we can release the anchor
                 dish->next = nullptr;
+
+            // The deep copies are not needed after embedding, otherwise every element built for later embedding would leak its chain.
+            if (ownsUnParsedStyles)
+                delete dish;
         }
 
+        // The chain is used up, the rest of it is either deleted above or belongs to the constructor which gave it and may already be gone.
+        unParsedStyles = nullptr;
+        ownsUnParsedStyles = false;
+
         // Now we can one by one add them back via the official channel
         for (element* c : tmp_childs){
             owner->addChild(c);
@@ -366,6 +366,11 @@ namespace GGUI{
 
             virtual styleBase* copy() const = 0;
 
+            /**
+             * @brief Gives the size of the whole object, for the memory accounting of the unparsed style chains.
+             */
+            virtual size_t getSize() const = 0;
+
             /**
              * @brief Overload the | operator to allow for appending of style_bases.
              * @param other The style_base to append.
@@ -467,6 +472,10 @@ namespace GGUI{
                 return new RGBValue(*this);
             }
 
+            inline size_t getSize() const override {
+                return sizeof(RGBValue);
+            }
+
             /**
              * @brief Overload the assignment operator for RGB_VALUE.
              * @param other The other RGB_VALUE object to assign from.
@@ -568,6 +577,10 @@ namespace GGUI{
                 return new boolValue(*this);
             }
 
+            inline size_t getSize() const override {
+                return sizeof(boolValue);
+            }
+
             /**
              * @brief Overload the assignment operator for BOOL_VALUE.
              * @param other The other BOOL_VALUE object to assign from.
@@ -662,6 +675,10 @@ namespace GGUI{
                 return new numberValue(*this);
             }
 
+            inline size_t getSize() const override {
+                return sizeof(numberValue);
+            }
+
             /**
              * @brief Overload the assignment operator for NUMBER_VALUE.
              * @param other The other NUMBER_VALUE object to assign from.
@@ -771,6 +788,10 @@ namespace GGUI{
                 return new enumValue(*this);
             }
 
+            inline size_t getSize() const override {
+                return sizeof(enumValue);
+            }
+
             /**
              * @brief Overload the assignment operator for ENUM_VALUE.
              * @param other The other ENUM_VALUE object to assign from.
@@ -865,6 +886,10 @@ namespace GGUI{
                 return new vectorValue(*this);
             }
 
+            inline size_t getSize() const override {
+                return sizeof(vectorValue);
+            }
+
             /**
              * @brief Overload the assignment operator for Vector.
              * @param other The other Vector object to assign from.
@@ -1118,6 +1143,10 @@ namespace GGUI{
             inline styleBase* copy() const override {
                 return new empty(*this);
             }
+
+            inline size_t getSize() const override {
+                return sizeof(empty);
+            }
         };
     }
 
@@ -1147,6 +1176,10 @@ namespace GGUI{
             return new position(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(position);
+        }
+
         constexpr position(const GGUI::position& other) : vectorValue(other){}
 
         position& operator=(const position& other) = default;
@@ -1191,6 +1224,10 @@ namespace GGUI{
             return new width(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(width);
+        }
+
         constexpr width(const GGUI::width& other) : numberValue(other){}
 
         width& operator=(const width& other) = default;
@@ -1221,6 +1258,10 @@ namespace GGUI{
             return new height(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(height);
+        }
+
         constexpr height(const GGUI::height& other) : numberValue(other){}
 
         height& operator=(const height& other) = default;
@@ -1252,6 +1293,10 @@ namespace GGUI{
             return new enableBorder(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(enableBorder);
+        }
+
         enableBorder& operator=(const enableBorder& other) = default;
 
         constexpr bool operator==(const enableBorder& other) const{
@@ -1282,6 +1327,10 @@ namespace GGUI{
             return new textColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(textColor);
+        }
+
         constexpr textColor(const GGUI::textColor& other) : RGBValue(other){}
 
         textColor& operator=(const textColor& other) = default;
@@ -1306,6 +1355,10 @@ namespace GGUI{
             return new backgroundColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(backgroundColor);
+        }
+
         constexpr backgroundColor(const GGUI::backgroundColor& other) : RGBValue(other){}
 
         backgroundColor& operator=(const backgroundColor& other) = default;
@@ -1330,6 +1383,10 @@ namespace GGUI{
             return new borderColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(borderColor);
+        }
+
         constexpr borderColor(const GGUI::borderColor& other) : RGBValue(other){}
 
         borderColor& operator=(const borderColor& other) = default;
@@ -1354,6 +1411,10 @@ namespace GGUI{
             return new borderBackgroundColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(borderBackgroundColor);
+        }
+
         constexpr borderBackgroundColor(const GGUI::borderBackgroundColor& other) : RGBValue(other){}
 
         borderBackgroundColor& operator=(const borderBackgroundColor& other) = default;
@@ -1378,6 +1439,10 @@ namespace GGUI{
             return new hoverBorderColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(hoverBorderColor);
+        }
+
         constexpr hoverBorderColor(const GGUI::hoverBorderColor& other) : RGBValue(other){}
 
         hoverBorderColor& operator=(const hoverBorderColor& other) = default;
@@ -1402,6 +1467,10 @@ namespace GGUI{
             return new hoverTextColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(hoverTextColor);
+        }
+
         constexpr hoverTextColor(const GGUI::hoverTextColor& other) : RGBValue(other){}
 
         hoverTextColor& operator=(const hoverTextColor& other) = default;
@@ -1426,6 +1495,10 @@ namespace GGUI{
             return new hoverBackgroundColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(hoverBackgroundColor);
+        }
+
         constexpr hoverBackgroundColor(const GGUI::hoverBackgroundColor& other) : RGBValue(other){}
 
         hoverBackgroundColor& operator=(const hoverBackgroundColor& other) = default;
@@ -1450,6 +1523,10 @@ namespace GGUI{
             return new hoverBorderBackgroundColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(hoverBorderBackgroundColor);
+        }
+
         constexpr hoverBorderBackgroundColor(const GGUI::hoverBorderBackgroundColor& other) : RGBValue(other){}
 
         hoverBorderBackgroundColor& operator=(const hoverBorderBackgroundColor& other) = default;
@@ -1474,6 +1551,10 @@ namespace GGUI{
             return new focusBorderColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(focusBorderColor);
+        }
+
         constexpr focusBorderColor(const GGUI::focusBorderColor& other) : RGBValue(other){}
 
         focusBorderColor& operator=(const focusBorderColor& other) = default;
@@ -1498,6 +1579,10 @@ namespace GGUI{
             return new focusTextColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(focusTextColor);
+        }
+
         constexpr focusTextColor(const GGUI::focusTextColor& other) : RGBValue(other){}
 
         focusTextColor& operator=(const focusTextColor& other) = default;
@@ -1522,6 +1607,10 @@ namespace GGUI{
             return new focusBackgroundColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(focusBackgroundColor);
+        }
+
         constexpr focusBackgroundColor(const GGUI::focusBackgroundColor& other) : RGBValue(other){}
 
         focusBackgroundColor& operator=(const focusBackgroundColor& other) = default;
@@ -1546,6 +1635,10 @@ namespace GGUI{
             return new focusBorderBackgroundColor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(focusBorderBackgroundColor);
+        }
+
         constexpr focusBorderBackgroundColor(const GGUI::focusBorderBackgroundColor& other) : RGBValue(other){}
 
         focusBorderBackgroundColor& operator=(const focusBorderBackgroundColor& other) = default;
@@ -1612,6 +1705,10 @@ namespace GGUI{
             return new styledBorder(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(styledBorder);
+        }
+
         constexpr styledBorder& operator=(const styledBorder& other){
             if (other.status >= status){
                 topLeftCorner = other.topLeftCorner;
@@ -1664,6 +1761,10 @@ namespace GGUI{
             return new flowPriority(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(flowPriority);
+        }
+
         constexpr flowPriority(const GGUI::flowPriority& other) : enumValue(other.value, other.status){}
 
         flowPriority& operator=(const flowPriority& other) = default;
@@ -1686,6 +1787,10 @@ namespace GGUI{
             return new wrap(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(wrap);
+        }
+
         constexpr wrap(const GGUI::wrap& other) : boolValue(other.value, other.status){}
 
         wrap& operator=(const wrap& other) = default;
@@ -1708,6 +1813,10 @@ namespace GGUI{
             return new allowOverflow(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(allowOverflow);
+        }
+
         constexpr allowOverflow(const GGUI::allowOverflow& other) : boolValue(other.value, other.status){}
 
         allowOverflow& operator=(const allowOverflow& other) = default;
@@ -1730,6 +1839,10 @@ namespace GGUI{
             return new allowDynamicSize(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(allowDynamicSize);
+        }
+
         constexpr allowDynamicSize(const GGUI::allowDynamicSize& other) : boolValue(other.value, other.status){}
 
         allowDynamicSize& operator=(const allowDynamicSize& other) = default;
@@ -1759,6 +1872,10 @@ namespace GGUI{
             return new margin(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(margin);
+        }
+
         // operator overload for copy operator
         constexpr margin& operator=(const margin& other){
             // Only copy the information if the other is enabled.
@@ -1806,6 +1923,10 @@ namespace GGUI{
             return new opacity(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(opacity);
+        }
+
         constexpr opacity& operator=(const opacity& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -1846,6 +1967,10 @@ namespace GGUI{
             return new allowScrolling(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(allowScrolling);
+        }
+
         constexpr allowScrolling(const GGUI::allowScrolling& other) : boolValue(other.value, other.status){}
 
         allowScrolling& operator=(const allowScrolling& other) = default;
@@ -1868,6 +1993,10 @@ namespace GGUI{
             return new anchor(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(anchor);
+        }
+
         constexpr anchor(const GGUI::anchor& other) : enumValue(other.value, other.status){}
 
         anchor& operator=(const anchor& other) = default;
@@ -1892,6 +2021,10 @@ namespace GGUI{
 
         styleBase* copy() const override;
 
+        inline size_t getSize() const override {
+            return sizeof(node);
+        }
+
         constexpr node& operator=(const node& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -1926,6 +2059,10 @@ namespace GGUI{
 
         styleBase* copy() const override;
 
+        inline size_t getSize() const override {
+            return sizeof(childs);
+        }
+
         constexpr childs& operator=(const childs& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -1973,6 +2110,10 @@ namespace GGUI{
             return new onInit(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onInit);
+        }
+
         constexpr onInit& operator=(const onInit& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2002,6 +2143,10 @@ namespace GGUI{
             return new onDestroy(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onDestroy);
+        }
+
         constexpr onDestroy& operator=(const onDestroy& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2031,6 +2176,10 @@ namespace GGUI{
             return new onHide(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onHide);
+        }
+
         constexpr onHide& operator=(const onHide& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2060,6 +2209,10 @@ namespace GGUI{
             return new onShow(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onShow);
+        }
+
         constexpr onShow& operator=(const onShow& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2089,6 +2242,10 @@ namespace GGUI{
             return new onRender(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onRender);
+        }
+
         constexpr onRender& operator=(const onRender& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2118,6 +2275,10 @@ namespace GGUI{
             return new name(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(name);
+        }
+
         constexpr name& operator=(const name& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2143,6 +2304,10 @@ namespace GGUI{
             return new title(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(title);
+        }
+
         constexpr title(const GGUI::title& other) : name(other.value, other.status){}
 
         constexpr title& operator=(const title& other){
@@ -2172,6 +2337,10 @@ namespace GGUI{
             return new display(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(display);
+        }
+
         constexpr display(const GGUI::display& other) : boolValue(other.value, other.status){}
 
         constexpr display& operator=(const display& other){
@@ -2204,6 +2373,10 @@ namespace GGUI{
             return new onDraw(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onDraw);
+        }
+
         constexpr onDraw& operator=(const onDraw& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2233,6 +2406,10 @@ namespace GGUI{
             return new text(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(text);
+        }
+
         constexpr text& operator=(const text& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2262,6 +2439,10 @@ namespace GGUI{
             return new onClick(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onClick);
+        }
+
         constexpr onClick& operator=(const onClick& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2293,6 +2474,10 @@ namespace GGUI{
             return new onInput(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(onInput);
+        }
+
         constexpr onInput& operator=(const onInput& other){
             // Only copy the information if the other is enabled.
             if (other.status >= status){
@@ -2449,6 +2634,11 @@ namespace GGUI{
         
         void copyUnParsedStyles(const styling* other);
 
+        /**
+         * @brief Gives the bytes held by this styling, its child list and the unparsed style chain it owns.
+         */
+        size_t getMemoryUsage() const;
+
         // Returns the pointer of whom this evaluation is to reference.
         styling* getReference(element* owner);
 
@@ -2476,6 +2666,9 @@ namespace GGUI{
     
         // The construction time given styles are first put here, before embedding them into this class.
         STYLING_INTERNAL::styleBase* unParsedStyles = nullptr;
+
+        // Set when unParsedStyles is a deep copy made by copyUnParsedStyles(), which embedStyles() then deletes.
+        bool ownsUnParsedStyles = false;
     };
 
     namespace STYLES{
@@ -474,7 +474,7 @@ namespace GGUI{
                         break;
 
                     // Replace the current contents of the string with the contents of the Unicode Data.
-                    result.replace(currentUTFInsertIndex, Data.size, Data.text);
+                    result.replace(currentUTFInsertIndex, Data.size, Data.text, Data.size);
                     currentUTFInsertIndex += Data.size;
                 }
                 return result;
@@ -0,0 +1,222 @@
+#include "trace.h"
+#include "logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+#if defined(__linux__)
+    #include <unistd.h>
+#endif
+
+namespace GGUI{
+    namespace INTERNAL{
+        namespace TRACE{
+            struct event{
+                const char* name;
+                int64_t start;
+                int64_t duration;
+                char detail[detailSize];
+            };
+
+            /**
+             * @brief The spans of one thread, written only by it.
+             */
+            struct ring{
+                std::atomic<uint64_t> head = 0;         // Count of spans ever written, the next one goes into head % ringSize.
+                std::atomic<uint64_t> cleared = 0;      // Spans before this were forgotten with clear().
+                unsigned int id = 0;
+                event events[ringSize];
+            };
+
+            struct traceState{
+                std::mutex lock;
+                std::vector<ring*> rings;       // Kept after their threads exit, so that their spans can still be dumped.
+            };
+
+            static traceState& state(){
+                static traceState* instance = new traceState();
+                return *instance;
+            }
+
+            static std::atomic<bool> enabled = false;
+
+            static thread_local ring* localRing = nullptr;
+
+            // All timestamps are relative to the first use, so that they stay small in the JSON.
+            static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+            static int64_t nowNanoseconds(){
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+            }
+
+            /**
+             * @brief Gives the ring of the calling thread, creating it on its first span.
+             */
+            static ring& getLocalRing(){
+                if (!localRing){
+                    localRing = new ring();
+
+                    traceState& self = state();
+                    std::lock_guard<std::mutex> hold(self.lock);
+                    localRing->id = self.rings.size() + 1;
+                    self.rings.push_back(localRing);
+                }
+
+                return *localRing;
+            }
+
+            void enable(bool state){
+                enabled.store(state, std::memory_order_relaxed);
+            }
+
+            bool isEnabled(){
+                return enabled.load(std::memory_order_relaxed);
+            }
+
+            span::span(const char* Name){
+                if (!enabled.load(std::memory_order_relaxed))
+                    return;
+
+                name = Name;
+                detail[0] = '\0';
+                start = nowNanoseconds();
+            }
+
+            span::~span(){
+                if (!name)
+                    return;
+
+                int64_t end = nowNanoseconds();
+                ring& own = getLocalRing();
+                uint64_t index = own.head.load(std::memory_order_relaxed);
+
+                event& current = own.events[index % ringSize];
+                current.name = name;
+                current.start = start;
+                current.duration = end - start;
+                std::memcpy(current.detail, detail, detailSize);
+
+                own.head.store(index + 1, std::memory_order_release);
+            }
+
+            void span::setDetail(const std::string& Detail){
+                size_t length = std::min<size_t>(Detail.size(), detailSize - 1);
+
+                // Never cut in the middle of a UTF-8 sequence, the JSON export would be invalid.
+                while (length > 0 && length < Detail.size() && (static_cast<unsigned char>(Detail[length]) & 0xC0) == 0x80)
+                    length--;
+
+                std::memcpy(detail, Detail.data(), length);
+                detail[length] = '\0';
+            }
+
+            void clear(){
+                traceState& self = state();
+                std::lock_guard<std::mutex> hold(self.lock);
+
+                for (ring* current : self.rings)
+                    current->cleared.store(current->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+
+            static void appendEscaped(std::string& result, const char* text){
+                for (; *text; text++){
+                    unsigned char c = *text;
+
+                    if (c == '"' || c == '\\'){
+                        result += '\\';
+                        result += (char)c;
+                    }
+                    else if (c < 0x20){
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        result += escaped;
+                    }
+                    else{
+                        result += (char)c;
+                    }
+                }
+            }
+
+            std::string toJSON(){
+                std::vector<std::pair<unsigned int, std::vector<event>>> copies;
+
+                {
+                    traceState& self = state();
+                    std::lock_guard<std::mutex> hold(self.lock);
+
+                    for (ring* current : self.rings){
+                        uint64_t end = current->head.load(std::memory_order_acquire);
+                        uint64_t begin = std::max<uint64_t>(end > ringSize ? end - ringSize : 0, current->cleared.load(std::memory_order_relaxed));
+
+                        std::vector<event> copied;
+                        for (uint64_t i = begin; i < end; i++)
+                            copied.push_back(current->events[i % ringSize]);
+
+                        // The owner may have lapped over the oldest ones while they were copied, including the slot it writes now.
+                        uint64_t after = current->head.load(std::memory_order_acquire);
+                        uint64_t valid = after >= ringSize ? after - ringSize + 1 : 0;
+
+                        if (valid > begin)
+                            copied.erase(copied.begin(), copied.begin() + std::min<uint64_t>(valid - begin, copied.size()));
+
+                        copies.emplace_back(current->id, std::move(copied));
+                    }
+                }
+
+            #if defined(__linux__)
+                long processId = getpid();
+            #else
+                long processId = 1;
+            #endif
+
+                std::string result = "{\"traceEvents\":[\n";
+                bool first = true;
+                char numbers[160];
+
+                for (auto& [thread, events] : copies){
+                    for (event& current : events){
+                        if (!first)
+                            result += ",\n";
+                        first = false;
+
+                        result += "{\"name\":\"";
+                        appendEscaped(result, current.name);
+
+                        std::snprintf(numbers, sizeof(numbers), "\",\"cat\":\"ggui\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%u",
+                            current.start / 1000.0, current.duration / 1000.0, processId, thread);
+                        result += numbers;
+
+                        if (current.detail[0]){
+                            result += ",\"args\":{\"detail\":\"";
+                            appendEscaped(result, current.detail);
+                            result += "\"}";
+                        }
+
+                        result += "}";
+                    }
+                }
+
+                result += "\n],\"displayTimeUnit\":\"ms\"}\n";
+                return result;
+            }
+
+            bool dump(const std::string& path){
+                std::ofstream file(path, std::ios::trunc);
+
+                if (!file.is_open()){
+                    LOGGER::log("Failed to open '" + path + "' for the trace.");
+                    return false;
+                }
+
+                file << toJSON();
+                return file.good();
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <string>
+#include <cstdint>
+
+// autoGen: Ignore start
+// Spans are compiled in for the debug and profile builds, and for release builds only when GGUI_TRACE is defined.
+#if !defined(GGUI_RELEASE) || defined(GGUI_TRACE)
+    #define GGUI_TRACING 1
+#else
+    #define GGUI_TRACING 0
+#endif
+
+namespace GGUI {
+    namespace INTERNAL {
+        namespace TRACE {
+            // Spans kept per thread, the oldest are overwritten when a thread records more between dumps.
+            constexpr unsigned int ringSize = 8192;
+
+            // Longest detail kept with a span, like the name of the element or the ID of the event handler.
+            constexpr unsigned int detailSize = 32;
+
+            /**
+             * @brief Starts or stops recording the spans, given as --trace=<file> which also dumps them on exit.
+             * @details While disabled a span costs one relaxed load.
+             */
+            extern void enable(bool state);
+
+            /**
+             * @brief Tells whether the spans are recorded.
+             */
+            extern bool isEnabled();
+
+            /**
+             * @brief Writes the recorded spans of all threads into the file, in the Chrome trace_event format which Perfetto and chrome://tracing read.
+             * @return False if the file could not be written.
+             */
+            extern bool dump(const std::string& path);
+
+            /**
+             * @brief Gives the recorded spans of all threads in the Chrome trace_event JSON format.
+             */
+            extern std::string toJSON();
+
+            /**
+             * @brief Forgets the spans recorded so far.
+             */
+            extern void clear();
+
+            /**
+             * @brief Measures the scope it lives in, recorded into the ring of the calling thread when it ends.
+             * @details Only the owning thread writes into its ring, the dumping thread copies the rings and drops the spans
+             *          which were overwritten while it copied, so recording takes no locks.
+             */
+            class span {
+            public:
+                /**
+                 * @param Name Name of the stage, must outlive the process like a string literal.
+                 */
+                explicit span(const char* Name);
+                ~span();
+
+                span(const span&) = delete;
+                span& operator=(const span&) = delete;
+
+                /**
+                 * @brief Whether the span is being recorded, so that its detail is only built when needed.
+                 */
+                bool isActive() const { return name != nullptr; }
+
+                /**
+                 * @brief Attaches a detail into the span, cut to detailSize at a UTF-8 code point boundary.
+                 */
+                void setDetail(const std::string& detail);
+
+            private:
+                const char* name = nullptr;
+                int64_t start = 0;
+                char detail[detailSize];        // Set only when active, so that the disabled spans cost nothing more.
+            };
+        }
+    }
+}
+
+#if GGUI_TRACING
+    #define GGUI_TRACE_CONCAT_INNER(a, b) a##b
+    #define GGUI_TRACE_CONCAT(a, b) GGUI_TRACE_CONCAT_INNER(a, b)
+
+    // Records the rest of the enclosing scope as a span of the given stage.
+    #define GGUI_TRACE_SCOPE(name) ::GGUI::INTERNAL::TRACE::span GGUI_TRACE_CONCAT(ggui_trace_span_, __LINE__)(name)
+
+    // Like GGUI_TRACE_SCOPE, the detail expression is only evaluated when the span is recorded.
+    #define GGUI_TRACE_SCOPE_DETAIL(name, detail) \
+        ::GGUI::INTERNAL::TRACE::span GGUI_TRACE_CONCAT(ggui_trace_span_, __LINE__)(name); \
+        if (GGUI_TRACE_CONCAT(ggui_trace_span_, __LINE__).isActive()) GGUI_TRACE_CONCAT(ggui_trace_span_, __LINE__).setDetail(detail)
+#else
+    #define GGUI_TRACE_SCOPE(name) ((void)0)
+    #define GGUI_TRACE_SCOPE_DETAIL(name, detail) ((void)0)
+#endif
+// autoGen: Ignore end
+
+#endif
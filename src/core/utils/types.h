@@ -5,7 +5,13 @@
 #include <functional>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
+#include <shared_mutex>
 #include <memory>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
 
 #include "constants.h"
 #include "color.h"
@@ -568,12 +574,19 @@ namespace GGUI{
         unsigned short y = 0;
         char data = 0;
 
+        // Multi-byte payload, only used by constants::PASTE, so that a whole paste is delivered as one input.
+        std::string text;
+
         // The input information like the character written.
         input(char d, unsigned long long t){
             data = d;
             criteria = t;
         }
 
+        input(std::string&& t, unsigned long long c) : text(std::move(t)){
+            criteria = c;
+        }
+
         input(IVector3 c, unsigned long long t){
             x = (unsigned short )c.x;
             y = (unsigned short )c.y;
@@ -586,6 +599,9 @@ namespace GGUI{
         std::function<bool(GGUI::event*)> Job;
         
         std::string ID; 
+
+        // Set for handlers registered as async, their job only hands the work to HANDLER_POOL and is accounted there.
+        bool async = false;
     
         action() = default;
         action(unsigned long long Criteria, std::function<bool(GGUI::event*)> job, std::string id){
@@ -608,14 +624,11 @@ namespace GGUI{
         // By default all memories automatically will not prolong each other similar memories.
         unsigned char flags = 0x0;
 
+        memory() = default;
+
         // When the job starts, job, prolong previous similar job by this time.
-        memory(size_t end, std::function<bool(GGUI::event*)>job, unsigned char Flags = 0x0, std::string id = ""){
-            startTime = std::chrono::high_resolution_clock::now();
-            endTime = end;
-            Job = job;
-            flags = Flags;
-            ID = id;
-        }
+        // The countdown starts from INTERNAL::CLOCK::now(), so that a virtual clock drives the memories too.
+        memory(size_t end, std::function<bool(GGUI::event*)>job, unsigned char Flags = 0x0, std::string id = "");
 
         bool is(const unsigned char f) const{
             return (flags & f) > 0;
@@ -626,6 +639,328 @@ namespace GGUI{
         }
     };
 
+    // Identifies a memory given to the memory scheduler, zero is never given out so it can be used as "no memory".
+    typedef unsigned long long memoryHandle;
+
+    namespace INTERNAL{
+        /**
+         * @brief Keeps the memories in an indexed binary min-heap ordered by their deadlines.
+         * @details The deadline of a memory is its startTime + endTime milliseconds, and it is due once the current time is past it.
+         *          Only the due memories are touched when recalling, and the closest deadline is always at the top of the heap.
+         *          Memories are stored in reusable slots, which know their place in the heap, so prolonging, retriggering and forgetting
+         *          a memory through its handle is O(log n) without searching. PROLONG_MEMORY memories with the same ID are deduplicated
+         *          through a lookup by ID, so adding one again just restarts the countdown of the existing one.
+         *          Due memories are taken out of the scheduler while their jobs run, so that the jobs can freely add new memories.
+         *          Not thread safe by itself, see INTERNAL::remember.
+         */
+        class memoryScheduler{
+        public:
+            typedef std::chrono::high_resolution_clock::time_point timePoint;
+
+            /**
+             * @brief Adds the memory, or restarts the countdown of the live PROLONG_MEMORY memory with the same ID.
+             * @param value The memory to schedule, its deadline is counted from its startTime.
+             * @return Handle to the scheduled memory.
+             */
+            memoryHandle add(memory&& value){
+                if (value.is(MEMORY_FLAGS::PROLONG_MEMORY)){
+                    auto existing = prolongable.find(value.ID);
+
+                    if (existing != prolongable.end() && slots[indexOf(existing->second)].heapIndex != npos){
+                        slot& current = slots[indexOf(existing->second)];
+
+                        current.value.startTime = value.startTime;
+                        current.value.endTime = value.endTime;
+                        reposition(current, value.startTime + std::chrono::milliseconds(value.endTime));
+
+                        return existing->second;
+                    }
+                }
+
+                unsigned int index;
+                if (freeSlots.empty()){
+                    index = (unsigned int)slots.size();
+                    slots.emplace_back();
+                }
+                else{
+                    index = freeSlots.back();
+                    freeSlots.pop_back();
+                }
+
+                slot& current = slots[index];
+                current.used = true;
+                current.forgotten = false;
+                current.deadline = value.startTime + std::chrono::milliseconds(value.endTime);
+                current.value = std::move(value);
+
+                memoryHandle handle = ((memoryHandle)current.generation << 32) | index;
+
+                if (current.value.is(MEMORY_FLAGS::PROLONG_MEMORY))
+                    prolongable[current.value.ID] = handle;
+
+                push(index);
+                return handle;
+            }
+
+            /**
+             * @brief Restarts the countdown of the memory from the given time.
+             * @return False if the handle is not scheduled, or the memory is currently running.
+             */
+            bool prolong(memoryHandle handle, timePoint now){
+                if (!isScheduled(handle))
+                    return false;
+
+                slot& current = slots[indexOf(handle)];
+                current.value.startTime = now;
+                reposition(current, now + std::chrono::milliseconds(current.value.endTime));
+                return true;
+            }
+
+            /**
+             * @brief Makes the memory due immediately, so it runs on the next recall.
+             * @return False if the handle is not scheduled, or the memory is currently running.
+             */
+            bool retrigger(memoryHandle handle){
+                if (!isScheduled(handle))
+                    return false;
+
+                reposition(slots[indexOf(handle)], timePoint::min());
+                return true;
+            }
+
+            /**
+             * @brief Removes the memory without running it.
+             * @details A memory which is currently running is removed once its job returns.
+             * @return False if the handle doesn't point to a live memory.
+             */
+            bool forget(memoryHandle handle){
+                if (!contains(handle))
+                    return false;
+
+                slot& current = slots[indexOf(handle)];
+
+                if (current.heapIndex == npos){
+                    current.forgotten = true;   // Running, release() or reschedule() will free it.
+                }
+                else{
+                    remove(current.heapIndex);
+                    free(indexOf(handle));
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Tells whether the handle points to a live memory, scheduled or running.
+             */
+            bool contains(memoryHandle handle) const {
+                unsigned int index = indexOf(handle);
+                return index < slots.size() && slots[index].used && slots[index].generation == (handle >> 32) && !slots[index].forgotten;
+            }
+
+            /**
+             * @brief Gives the deadline closest to now.
+             * @param result Set to the deadline if there is one.
+             * @return False if there are no scheduled memories.
+             */
+            bool nextDeadline(timePoint& result) const {
+                if (heap.empty())
+                    return false;
+
+                result = slots[heap.front()].deadline;
+                return true;
+            }
+
+            /**
+             * @brief Moves all the memories whose deadline is before the given time out of the scheduler, closest deadline first.
+             * @details Their handles stay valid, and each of them must be given back with release() or reschedule().
+             * @param now The current time.
+             * @param due Where the handles and the memories are appended into.
+             */
+            void takeDue(timePoint now, std::vector<std::pair<memoryHandle, memory>>& due){
+                while (!heap.empty() && slots[heap.front()].deadline < now){
+                    unsigned int index = heap.front();
+                    remove(0);
+
+                    // While running it is not a target for deduplication, reschedule() registers it again.
+                    auto existing = prolongable.find(slots[index].value.ID);
+                    if (existing != prolongable.end() && indexOf(existing->second) == index)
+                        prolongable.erase(existing);
+
+                    due.emplace_back(((memoryHandle)slots[index].generation << 32) | index, std::move(slots[index].value));
+                }
+            }
+
+            /**
+             * @brief Frees a memory taken with takeDue() after its job has finished for good.
+             */
+            void release(memoryHandle handle){
+                unsigned int index = indexOf(handle);
+
+                if (index < slots.size() && slots[index].used && slots[index].generation == (handle >> 32) && slots[index].heapIndex == npos)
+                    free(index);
+            }
+
+            /**
+             * @brief Puts a memory taken with takeDue() back to wait for the given deadline, unless it was forgotten meanwhile.
+             */
+            void reschedule(memoryHandle handle, memory&& value, timePoint deadline){
+                unsigned int index = indexOf(handle);
+
+                if (index >= slots.size() || !slots[index].used || slots[index].generation != (handle >> 32) || slots[index].heapIndex != npos)
+                    return;
+
+                if (slots[index].forgotten){
+                    free(index);
+                    return;
+                }
+
+                slots[index].value = std::move(value);
+                slots[index].deadline = deadline;
+
+                if (slots[index].value.is(MEMORY_FLAGS::PROLONG_MEMORY))
+                    prolongable.emplace(slots[index].value.ID, handle);
+
+                push(index);
+            }
+
+            /**
+             * @brief Number of scheduled memories, not counting the ones taken out by takeDue().
+             */
+            size_t size() const {
+                return heap.size();
+            }
+
+            bool empty() const {
+                return heap.empty();
+            }
+
+            /**
+             * @brief Gives the bytes held by the slots and the heap, see INTERNAL::MEMORY_USAGE.
+             */
+            size_t getMemoryUsage() const {
+                return slots.capacity() * sizeof(slot) + (freeSlots.capacity() + heap.capacity()) * sizeof(unsigned int);
+            }
+
+        private:
+            static constexpr size_t npos = SIZE_MAX;
+
+            struct slot{
+                memory value;
+                timePoint deadline;
+                size_t heapIndex = npos;        // npos while free or taken out by takeDue().
+                unsigned int generation = 1;    // Bumped on every free, so old handles to this slot go stale.
+                bool used = false;
+                bool forgotten = false;         // Forgotten while running.
+            };
+
+            std::vector<slot> slots;
+            std::vector<unsigned int> freeSlots;
+            std::vector<unsigned int> heap;     // Slot indices, the closest deadline first.
+
+            // ID of each live PROLONG_MEMORY memory to its handle.
+            std::unordered_map<std::string, memoryHandle> prolongable;
+
+            static unsigned int indexOf(memoryHandle handle){
+                return (unsigned int)(handle & UINT32_MAX);
+            }
+
+            bool isScheduled(memoryHandle handle) const {
+                return contains(handle) && slots[indexOf(handle)].heapIndex != npos;
+            }
+
+            void free(unsigned int index){
+                slot& current = slots[index];
+
+                auto existing = prolongable.find(current.value.ID);
+                if (existing != prolongable.end() && indexOf(existing->second) == index)
+                    prolongable.erase(existing);
+
+                current.value = memory();
+                current.heapIndex = npos;
+                current.used = false;
+                current.forgotten = false;
+                current.generation++;
+
+                freeSlots.push_back(index);
+            }
+
+            void reposition(slot& current, timePoint deadline){
+                bool earlier = deadline < current.deadline;
+                current.deadline = deadline;
+
+                if (earlier)
+                    siftUp(current.heapIndex);
+                else
+                    siftDown(current.heapIndex);
+            }
+
+            void push(unsigned int index){
+                slots[index].heapIndex = heap.size();
+                heap.push_back(index);
+                siftUp(heap.size() - 1);
+            }
+
+            void remove(size_t position){
+                slots[heap[position]].heapIndex = npos;
+
+                if (position != heap.size() - 1){
+                    place(position, heap.back());
+                    heap.pop_back();
+
+                    siftDown(position);
+                    siftUp(position);
+                }
+                else{
+                    heap.pop_back();
+                }
+            }
+
+            void place(size_t position, unsigned int index){
+                heap[position] = index;
+                slots[index].heapIndex = position;
+            }
+
+            void siftUp(size_t position){
+                unsigned int index = heap[position];
+
+                while (position > 0){
+                    size_t parent = (position - 1) / 2;
+
+                    if (!(slots[index].deadline < slots[heap[parent]].deadline))
+                        break;
+
+                    place(position, heap[parent]);
+                    position = parent;
+                }
+
+                place(position, index);
+            }
+
+            void siftDown(size_t position){
+                unsigned int index = heap[position];
+
+                while (true){
+                    size_t child = position * 2 + 1;
+
+                    if (child >= heap.size())
+                        break;
+
+                    if (child + 1 < heap.size() && slots[heap[child + 1]].deadline < slots[heap[child]].deadline)
+                        child++;
+
+                    if (!(slots[heap[child]].deadline < slots[index].deadline))
+                        break;
+
+                    place(position, heap[child]);
+                    position = child;
+                }
+
+                place(position, index);
+            }
+        };
+    }
+
     namespace INTERNAL{
         struct fittingArea{
             IVector2 negativeOffset;
@@ -828,10 +1163,17 @@ namespace GGUI{
         }
 
         namespace atomic{
+            // How much a guard has been waited upon, for finding the guards which threads fight over.
+            struct contention{
+                unsigned long long acquisitions = 0;    // Every access, exclusive or shared.
+                unsigned long long contended = 0;       // Accesses which had to wait for another thread.
+                unsigned long long waitNanoseconds = 0; // Total time spent waiting in the contended accesses.
+            };
+
             template<typename T>
             class guard {
             public:
-                std::mutex shared; // Mutex to guard shared data
+                std::shared_mutex shared; // Mutex to guard shared data, shared locking for read() and exclusive for the rest.
                 std::unique_ptr<T> data;
 
                 /**
@@ -845,16 +1187,19 @@ namespace GGUI{
                 /**
                  * @brief Functor to execute a job with thread safety.
                  * 
-                 * This operator() function takes a std::function that operates on a reference to a T object.
-                 * It ensures that the job is executed with mutual exclusion by using a std::lock_guard to lock
-                 * the mutex. If the job throws an exception, it catches it and reports the failure.
+                 * This operator() function takes any callable that operates on a reference to a T object.
+                 * The callable is taken as is instead of wrapping it into a std::function, so capturing lambdas don't allocate.
+                 * It ensures that the job is executed with mutual exclusion by locking the mutex exclusively.
+                 * If the job throws an exception, it catches it and reports the failure.
                  * 
-                 * @param job A std::function that takes a reference to a T object and performs some operation.
+                 * @param job A callable that takes a reference to a T object and performs some operation.
                  * 
                  * @throws Any exception thrown by the job function will be caught and reported.
                  */
-                void operator()(std::function<void(T&)> job) {
-                    std::lock_guard<std::mutex> lock(shared); // Automatically manages mutex locking and unlocking
+                template<typename F>
+                void operator()(F&& job) {
+                    std::unique_lock<std::shared_mutex> lock(shared, std::defer_lock);
+                    acquire(lock);
                     try {
                         job(*data);
                     } catch (...) {
@@ -862,19 +1207,52 @@ namespace GGUI{
                     }
                 }
 
+                /**
+                 * @brief Executes a read-only job on the data without copying it.
+                 * 
+                 * The mutex is locked in shared mode, so any number of readers can look at the data at the same time,
+                 * while the writers through operator() wait for them. The job sees a consistent snapshot of the data
+                 * for its whole duration, and must not keep references to it after returning.
+                 * 
+                 * @param job A callable that takes a const reference to a T object.
+                 */
+                template<typename F>
+                void read(F&& job) {
+                    std::shared_lock<std::shared_mutex> lock(shared, std::defer_lock);
+                    acquire(lock);
+                    try {
+                        job(static_cast<const T&>(*data));
+                    } catch (...) {
+                        INTERNAL::LOGGER::log("Failed to execute the function!");
+                    }
+                }
+
                 /**
                  * @brief Reads the data in a thread-safe manner.
                  * 
-                 * This function acquires a lock on the shared mutex to ensure that the data
+                 * This function acquires a shared lock on the mutex to ensure that the data
                  * is read in a thread-safe manner. It returns a copy of the data.
+                 * Prefer read(job) when a copy isn't needed.
                  * 
                  * @return T A copy of the data.
                  */
                 T read() {
-                    std::lock_guard<std::mutex> lock(shared);
+                    std::shared_lock<std::shared_mutex> lock(shared, std::defer_lock);
+                    acquire(lock);
                     return *data;
                 }
 
+                /**
+                 * @brief Returns how often this guard has been accessed and waited upon.
+                 */
+                contention getContention() const {
+                    return {
+                        acquisitions.load(std::memory_order_relaxed),
+                        contended.load(std::memory_order_relaxed),
+                        waitNanoseconds.load(std::memory_order_relaxed)
+                    };
+                }
+
                 /**
                  * @brief Destructor for the Guard class.
                  *
@@ -884,10 +1262,335 @@ namespace GGUI{
                  * released when the destructor exits, preventing potential deadlocks.
                  */
                 ~guard() {
-                    std::lock_guard<std::mutex> lock(shared);
+                    std::lock_guard<std::shared_mutex> lock(shared);
                     data.reset(); // Ensures proper destruction
                 }
+
+            private:
+                // Relaxed counters, since they are only statistics.
+                std::atomic<unsigned long long> acquisitions = 0;
+                std::atomic<unsigned long long> contended = 0;
+                std::atomic<unsigned long long> waitNanoseconds = 0;
+
+                /**
+                 * @brief Locks the given lock, counting the access and the time waited if the lock wasn't free.
+                 */
+                template<typename L>
+                void acquire(L& lock) {
+                    acquisitions.fetch_add(1, std::memory_order_relaxed);
+
+                    if (lock.try_lock())
+                        return;
+
+                    auto start = std::chrono::steady_clock::now();
+                    lock.lock();
+
+                    contended.fetch_add(1, std::memory_order_relaxed);
+                    waitNanoseconds.fetch_add(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+                        std::memory_order_relaxed
+                    );
+                }
             };   
+
+            /**
+             * @brief Lock-free multi-producer single-consumer queue.
+             * @details Producers push nodes onto an atomic singly linked stack with a compare-and-swap, so pushing never waits for a lock
+             *          or for the consumer. The consumer takes the whole stack at once with an exchange, which also rules out ABA problems,
+             *          and reverses it so that the items come out in the order they were pushed.
+             * @tparam T Type of the queued items.
+             */
+            template<typename T>
+            class mpscQueue{
+            public:
+                mpscQueue() = default;
+                mpscQueue(const mpscQueue&) = delete;
+                mpscQueue& operator=(const mpscQueue&) = delete;
+
+                /**
+                 * @brief Pushes an item, safe to call from any thread.
+                 * @param item The item to push.
+                 * @return True if the queue was empty before this push, so the caller knows whether the consumer needs to be woken.
+                 */
+                bool push(T&& item){
+                    node* current = new node{ std::move(item), head.load(std::memory_order_relaxed) };
+
+                    while (!head.compare_exchange_weak(current->next, current, std::memory_order_release, std::memory_order_relaxed));
+
+                    return current->next == nullptr;
+                }
+
+                /**
+                 * @brief Takes all the pushed items and gives them to the job in push order.
+                 * @details Must only be called from one thread at a time. Items pushed while draining are left for the next drain.
+                 * @param job Called with each of the items.
+                 * @return The number of items drained.
+                 */
+                template<typename F>
+                size_t drain(F&& job){
+                    node* stack = head.exchange(nullptr, std::memory_order_acquire);
+
+                    // Reverse the stack into push order.
+                    node* ordered = nullptr;
+                    while (stack){
+                        node* next = stack->next;
+                        stack->next = ordered;
+                        ordered = stack;
+                        stack = next;
+                    }
+
+                    size_t count = 0;
+                    while (ordered){
+                        node* next = ordered->next;
+
+                        job(ordered->value);
+
+                        delete ordered;
+                        ordered = next;
+                        count++;
+                    }
+
+                    return count;
+                }
+
+                /**
+                 * @brief Tells whether there is nothing to drain at the moment.
+                 */
+                bool empty() const {
+                    return head.load(std::memory_order_acquire) == nullptr;
+                }
+
+                ~mpscQueue(){
+                    drain([](T&){});
+                }
+
+            private:
+                struct node{
+                    T value;
+                    node* next;
+                };
+
+                std::atomic<node*> head = nullptr;
+            };
+
+            // States of the rendering thread, held in the renderTicket.
+            enum class status{
+                PAUSED,
+                REQUESTING_RENDERING,
+                RENDERING,
+                NOT_INITIALIZED,
+                TERMINATED
+            };
+
+            /**
+             * @brief Hands the right to touch the elements between the rendering thread and the threads mutating them.
+             * @details The status, the number of pauseGGUI() holds and a scene generation are packed into one atomic word, so that
+             *          requesting a frame, holding and releasing are each a single compare-and-swap instead of a mutex round trip.
+             *          Every frame request bumps the generation. The rendering thread remembers the generation its frame started from,
+             *          and if it has moved by the time the frame is done it renders again, so requests made during a frame are coalesced
+             *          into the next one instead of waiting for it or getting lost.
+             *          Like a futex, the mutex and the condition variable are only used by the threads which actually need to sleep,
+             *          and by the ones waking them up.
+             */
+            class renderTicket{
+            public:
+                renderTicket() = default;
+                renderTicket(const renderTicket&) = delete;
+                renderTicket& operator=(const renderTicket&) = delete;
+
+                status getStatus() const { return statusOf(word.load()); }
+
+                unsigned int getHolds() const { return holdsOf(word.load()); }
+
+                uint32_t getGeneration() const { return generationOf(word.load()); }
+
+                /**
+                 * @brief Moves from NOT_INITIALIZED to PAUSED, after which frames can be requested.
+                 */
+                void initialize(){
+                    update([](uint64_t current){
+                        return pack(status::PAUSED, holdsOf(current), generationOf(current));
+                    });
+
+                    notify();
+                }
+
+                /**
+                 * @brief Requests a frame of the current scene generation, never waits.
+                 * @return True if the rendering thread was idle and got woken up, false if the request rides along with a pending
+                 *         or ongoing frame, or waits for the last hold to be released.
+                 */
+                bool request(){
+                    uint64_t previous = update([](uint64_t current){
+                        status next = statusOf(current);
+
+                        if (next == status::PAUSED && holdsOf(current) == 0)
+                            next = status::REQUESTING_RENDERING;
+
+                        return pack(next, holdsOf(current), generationOf(current) + 1);
+                    });
+
+                    if (statusOf(previous) != status::PAUSED || holdsOf(previous) != 0)
+                        return false;
+
+                    notify();
+                    return true;
+                }
+
+                /**
+                 * @brief Takes one hold on the elements. A frame which was only requested is deferred until the last hold is released.
+                 * @return True if this is the first hold while a frame may be ongoing, in which case the caller must wait for PAUSED.
+                 */
+                bool hold(){
+                    uint64_t previous = update([](uint64_t current){
+                        status next = statusOf(current);
+
+                        if (next == status::REQUESTING_RENDERING)
+                            next = status::PAUSED;
+
+                        return pack(next, holdsOf(current) + 1, generationOf(current));
+                    });
+
+                    return holdsOf(previous) == 0 && statusOf(previous) == status::RENDERING;
+                }
+
+                /**
+                 * @brief Releases one hold taken with hold().
+                 * @return True if this was the last hold after initialization, in which case the caller should request a frame for its changes.
+                 */
+                bool release(){
+                    uint64_t previous = update([](uint64_t current){
+                        return pack(statusOf(current), holdsOf(current) > 0 ? holdsOf(current) - 1 : 0, generationOf(current));
+                    });
+
+                    return holdsOf(previous) <= 1 && statusOf(previous) != status::NOT_INITIALIZED;
+                }
+
+                /**
+                 * @brief Starts a frame if one is requested, only for the thread which renders.
+                 * @return True if the frame was started and finish() must be called after it.
+                 */
+                bool take(){
+                    uint64_t current = word.load();
+
+                    do{
+                        if (statusOf(current) != status::REQUESTING_RENDERING)
+                            return false;
+                    } while (!word.compare_exchange_weak(current, pack(status::RENDERING, holdsOf(current), generationOf(current))));
+
+                    startedFrom = generationOf(current);
+                    return true;
+                }
+
+                /**
+                 * @brief Ends the frame started with take(). Renders again if the generation moved meanwhile and nobody is holding the elements.
+                 * @return True if another frame was requested meanwhile and is now pending.
+                 */
+                bool finish(){
+                    uint32_t started = startedFrom;
+
+                    uint64_t previous = update([started](uint64_t current){
+                        bool again = generationOf(current) != started && holdsOf(current) == 0;
+
+                        return pack(again ? status::REQUESTING_RENDERING : status::PAUSED, holdsOf(current), generationOf(current));
+                    });
+
+                    notify();
+
+                    return generationOf(previous) != started && holdsOf(previous) == 0;
+                }
+
+                /**
+                 * @brief Tells the waiters that the rendering thread won't touch anything anymore.
+                 */
+                void terminate(){
+                    update([](uint64_t current){
+                        return pack(status::TERMINATED, holdsOf(current), generationOf(current));
+                    });
+
+                    notify();
+                }
+
+                /**
+                 * @brief Sleeps until the predicate holds, re-checking it whenever the word changes or notify() is called.
+                 */
+                template<typename P>
+                void waitUntil(P&& predicate){
+                    if (predicate())
+                        return;
+
+                    std::unique_lock lock(mutex);
+                    waiters.fetch_add(1);
+                    condition.wait(lock, predicate);
+                    waiters.fetch_sub(1);
+                }
+
+                /**
+                 * @brief Sleeps until the predicate holds or the timeout passes.
+                 * @return The predicate at the time of returning.
+                 */
+                template<typename P, typename R, typename D>
+                bool waitUntil(P&& predicate, std::chrono::duration<R, D> timeout){
+                    if (predicate())
+                        return true;
+
+                    std::unique_lock lock(mutex);
+                    waiters.fetch_add(1);
+                    bool result = condition.wait_for(lock, timeout, predicate);
+                    waiters.fetch_sub(1);
+
+                    return result;
+                }
+
+                /**
+                 * @brief Wakes the sleeping waiters so that they re-check their predicates, costs nothing when nobody is sleeping.
+                 * @details Needed after changing state which the predicates read outside of the word, like requestTermination.
+                 */
+                void notify(){
+                    // Pairs with the increment in waitUntil(), so either the waiter sees the new state or we see the waiter.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (waiters.load() == 0)
+                        return;
+
+                    std::lock_guard lock(mutex);
+                    condition.notify_all();
+                }
+
+            private:
+                // Bits 0-7 status, 8-31 holds and 32-63 generation.
+                static constexpr uint64_t pack(status s, unsigned int holds, uint32_t generation){
+                    return static_cast<uint64_t>(s) | (static_cast<uint64_t>(holds & 0xFFFFFF) << 8) | (static_cast<uint64_t>(generation) << 32);
+                }
+
+                static constexpr status statusOf(uint64_t value){ return static_cast<status>(value & 0xFF); }
+
+                static constexpr unsigned int holdsOf(uint64_t value){ return static_cast<unsigned int>((value >> 8) & 0xFFFFFF); }
+
+                static constexpr uint32_t generationOf(uint64_t value){ return static_cast<uint32_t>(value >> 32); }
+
+                /**
+                 * @brief Replaces the word with the result of the transition until no other thread got in between.
+                 * @return The word before the transition.
+                 */
+                template<typename F>
+                uint64_t update(F&& transition){
+                    uint64_t current = word.load();
+
+                    while (!word.compare_exchange_weak(current, transition(current)));
+
+                    return current;
+                }
+
+                std::atomic<uint64_t> word = pack(status::NOT_INITIALIZED, 0, 0);
+
+                // Only touched by the rendering thread between take() and finish().
+                uint32_t startedFrom = 0;
+
+                std::atomic<unsigned int> waiters = 0;
+                std::mutex mutex;
+                std::condition_variable condition;
+            };
         }
     
         // This class contains carry flags from previous cycle cross-thread, if another thread had some un-finished things when another thread was already running.
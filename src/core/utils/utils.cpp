@@ -422,7 +422,7 @@ namespace GGUI{
             }
             else{
                 // The position is in bounds, return the contents of that position
-                return &INTERNAL::abstractFrameBuffer->at(Absolute_Position.y * INTERNAL::getMaxWidth() + Absolute_Position.x);
+                return &INTERNAL::currentContext->abstractFrameBuffer->at(Absolute_Position.y * INTERNAL::getMaxWidth() + Absolute_Position.x);
             }
         }
 
@@ -525,6 +525,9 @@ namespace GGUI{
     }
 
     std::string toString(UTF coloredText, bool transparentBackground) {
-        return coloredText.toSuperString(transparentBackground)->toString();
+        // On the stack, so that concurrent callers don't share anything and nothing is left to leak.
+        INTERNAL::superString<GGUI::constants::ANSI::maximumNeededPreAllocationForEncodedSuperString> result;
+        coloredText.toSuperString(&result, transparentBackground);
+        return result.toString();
     }
 }
\ No newline at end of file
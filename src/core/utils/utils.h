@@ -23,13 +23,23 @@ namespace GGUI{
     namespace INTERNAL{
         extern std::string constructLoggerFileName();
 
-        extern bool identicalFrame;
-
         extern void deInitialize();
 
-        extern int BEFORE_ENCODE_BUFFER_SIZE;
-        extern int AFTER_ENCODE_BUFFER_SIZE;
         
+        /**
+         * @brief Renders one frame.
+         * @details Applies the commands posted with GGUI::post(), processes a pending resize, renders the main element and
+         *          writes the changes into the terminal or the DRM backend. Measures the time taken into renderDelay.
+         *          Expects the caller to hold the rendering ticket, so that no other thread touches the elements meanwhile.
+         */
+        extern void renderCycle();
+
+        /**
+         * @brief Gives the rendering ticket back after renderCycle().
+         * @details Pauses the rendering and notifies all waiting threads, or requests another frame if commands were posted meanwhile.
+         */
+        extern void finishRenderCycle();
+
         /**
          * @brief The Renderer function is responsible for managing the rendering loop.
          * It waits for a condition to resume rendering, processes rendering tasks, and
@@ -37,14 +47,9 @@ namespace GGUI{
          * 
          * The function performs the following steps:
          * 1. Waits for the render thread to be resumed.
-         * 2. Saves the current time.
-         * 3. Checks if the rendering scheduler needs to be terminated.
-         * 4. Processes carry flags and updates the maximum width and height if needed.
-         * 5. Renders the main frame buffer.
-         * 6. Encodes the buffer for optimization.
-         * 7. Converts the abstract frame buffer to a string and renders the frame.
-         * 8. Calculates the render delay.
-         * 9. Pauses the render thread and notifies all waiting threads.
+         * 2. Checks if the rendering scheduler needs to be terminated.
+         * 3. Renders the frame with renderCycle().
+         * 4. Gives the ticket back with finishRenderCycle().
          */
         extern void renderer();
 
@@ -65,18 +70,26 @@ namespace GGUI{
          */
         extern void eventThread();
 
+        /**
+         * @brief Runs one round of the passive tasks, which do not need user input.
+         * @details Recalls the due memories, checks file streams which are not watched by the event loop and advances multi-frame canvases.
+         *          Expects the rendering thread to be paused, since the tasks may modify elements.
+         */
+        extern void runEventTasks();
+
+        /**
+         * @brief Translates the queried input and lets the event handlers react to it.
+         * @details Translation, scroll and mouse processing and the event handlers are run under pauseGGUI(),
+         *          repeated while Translate_Inputs() has left mouse button transitions or scrolls for a next batch.
+         */
+        extern void processQueriedInputs();
+
         /**
          * @brief Function that continuously handles user input in a separate thread.
          *
          * This function runs an infinite loop where it performs the following steps:
          * 1. Waits for user input by calling INTERNAL::Query_Inputs().
-         * 2. Pauses the GGUI system and performs the following actions:
-         *    - Records the current time as INTERNAL::Previous_Time.
-         *    - Translates the queried inputs using INTERNAL::Translate_Inputs().
-         *    - Processes scroll and mouse inputs using SCROLL_API() and MOUSE_API().
-         *    - Calls the event handlers to react to the parsed input using Event_Handler().
-         *    - Records the current time as INTERNAL::Current_Time.
-         *    - Calculates the delta time (input delay) and stores it in INTERNAL::Input_Delay.
+         * 2. Processes it with INTERNAL::processQueriedInputs().
          */
         extern void inputThread();
 
@@ -358,7 +371,7 @@ namespace GGUI{
         /**
          * @brief Convert a liquefied UTF conveyorAllocator into a cached std::string.
          *
-         * Re-uses a static std::string buffer between calls to avoid heap churn. The
+         * Re-uses the given std::string buffer between calls to avoid heap churn. The
          * function expects that Liquefied_Size equals the sum of the sizes of all
          * compactString entries in Data and will resize the cached string if the size
          * differs. Multi‑byte (unicode) entries are memcpy'd; single byte ASCII entries
@@ -366,12 +379,10 @@ namespace GGUI{
          *
          * @param Data Contiguous collection of compactString produced by liquifyUTFText().
          * @param Liquefied_Size Pre-computed total number of bytes represented by Data.
-         * @return Pointer to an internally cached std::string containing the concatenated bytes.
-         * @warning The returned pointer becomes invalid after the next call to this function.
+         * @param result The string to write into, kept between renders so that its allocation is reused.
+         * @return Pointer to the result.
          */
-        inline std::string* toString(conveyorAllocator<compactString> Data, unsigned int Liquefied_Size) noexcept {
-            static std::string result; // internal cache between renders
-
+        inline std::string* toString(conveyorAllocator<compactString> Data, unsigned int Liquefied_Size, std::string& result) noexcept {
             if (result.size() != Liquefied_Size){
                 // Resize a std::string to the total size.
                 result.resize(Liquefied_Size, '\0');
@@ -2,6 +2,7 @@
 #include "../core/utils/utils.h"
 
 #include "../core/renderer.h"
+#include "../core/utils/eventLoop.h"
 #include <cmath>
 #include <bitset>
 
@@ -34,9 +35,9 @@ namespace GGUI{
      */
     canvas::~canvas() {
         // Check if this Terminal_Canvas is in the multi-frame list
-        if (INTERNAL::multiFrameCanvas.find(this) != INTERNAL::multiFrameCanvas.end()) {
+        if (INTERNAL::currentContext->multiFrameCanvas.find(this) != INTERNAL::currentContext->multiFrameCanvas.end()) {
             // Remove the canvas from the multi-frame list
-            INTERNAL::multiFrameCanvas.erase(this);
+            INTERNAL::currentContext->multiFrameCanvas.erase(this);
         }
     }
 
@@ -54,8 +55,13 @@ namespace GGUI{
         unsigned int Location = x + y * innerWidth; // Determine the buffer index for the sprite.
 
         // Check for multi-frame support and update the management map if needed.
-        if (!isMultiFrame() && sprite.Frames.size() > 1 && INTERNAL::multiFrameCanvas.find(this) == INTERNAL::multiFrameCanvas.end()){
-            INTERNAL::multiFrameCanvas[this] = true;
+        if (!isMultiFrame() && sprite.Frames.size() > 1){
+            INTERNAL::registerShared(this, [this](){
+                if (INTERNAL::currentContext->multiFrameCanvas.find(this) == INTERNAL::currentContext->multiFrameCanvas.end()){
+                    INTERNAL::currentContext->multiFrameCanvas[this] = true;
+                    INTERNAL::EVENT_LOOP::wake();   // Let the event loop know it needs to animate again.
+                }
+            });
             Multi_Frame = true;
         }
 
@@ -81,8 +87,13 @@ namespace GGUI{
         unsigned int Location = x + y * innerWidth; // Determine the buffer index for the sprite.
 
         // Check for multi-frame support and update the management map if needed.
-        if (!isMultiFrame() && sprite.Frames.size() > 1 && INTERNAL::multiFrameCanvas.find(this) == INTERNAL::multiFrameCanvas.end()){
-            INTERNAL::multiFrameCanvas[this] = true;
+        if (!isMultiFrame() && sprite.Frames.size() > 1){
+            INTERNAL::registerShared(this, [this](){
+                if (INTERNAL::currentContext->multiFrameCanvas.find(this) == INTERNAL::currentContext->multiFrameCanvas.end()){
+                    INTERNAL::currentContext->multiFrameCanvas[this] = true;
+                    INTERNAL::EVENT_LOOP::wake();   // Let the event loop know it needs to animate again.
+                }
+            });
             Multi_Frame = true;
         }
 
@@ -109,8 +120,13 @@ namespace GGUI{
         
         Buffer[Location].Frames.push_back(sprite); // Add the sprite to the buffer at the calculated location.
 
-        if (!isMultiFrame() && Buffer[Location].Frames.size() > 1 && INTERNAL::multiFrameCanvas.find(this) == INTERNAL::multiFrameCanvas.end()){
-            INTERNAL::multiFrameCanvas[this] = true;
+        if (!isMultiFrame() && Buffer[Location].Frames.size() > 1){
+            INTERNAL::registerShared(this, [this](){
+                if (INTERNAL::currentContext->multiFrameCanvas.find(this) == INTERNAL::currentContext->multiFrameCanvas.end()){
+                    INTERNAL::currentContext->multiFrameCanvas[this] = true;
+                    INTERNAL::EVENT_LOOP::wake();   // Let the event loop know it needs to animate again.
+                }
+            });
             Multi_Frame = true;
         }
 
@@ -187,6 +187,19 @@ namespace GGUI{
             // Concatenate class name and Name property to form the full name.
             return "canvas<" + Name + ">";
         }
+
+        /**
+         * @brief Adds the sprites and their animation frames on top of what the element holds.
+         */
+        void accountMemory(INTERNAL::MEMORY_USAGE::elementUsage& usage) const override {
+            element::accountMemory(usage);
+
+            usage.object += sizeof(canvas) - sizeof(element);
+            usage.content += Buffer.capacity() * sizeof(sprite);
+
+            for (const sprite& current : Buffer)
+                usage.content += current.Frames.capacity() * sizeof(UTF);
+        }
     
         /**
          * @brief Embeds a vector of points into the canvas.
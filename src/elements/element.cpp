@@ -4,6 +4,9 @@
 #include "../core/renderer.h"
 #include "../core/utils/utils.h"
 #include "../core/utils/settings.h"
+#include "../core/utils/handlerPool.h"
+#include "../core/utils/trace.h"
+#include "../core/utils/profiler.h"
 
 #include <algorithm>
 #include <vector>
@@ -131,6 +134,17 @@ GGUI::element::~element(){
     // Call handler for on destroying moment.
     check(INTERNAL::STATE::DESTROYED);
 
+    // Nothing deferred to the end of a batch may run on this anymore.
+    INTERNAL::forgetBatched(this);
+
+    // Nor may the registrations which a subtree being built deferred for it.
+    INTERNAL::forgetRegistrations(this);
+
+    // Neither may the async handlers, the running ones are waited for since they may still read this element.
+    INTERNAL::HANDLER_POOL::forget(this);
+
+    INTERNAL::PROFILER::forget(this);
+
     // Make sure this element is not listed in the parent element.
     // And if it does, then remove it from the parent element.
     if (Parent) {
@@ -156,10 +170,13 @@ GGUI::element::~element(){
 
     Style = nullptr;    // For safety, if in future some destruction system is going to need to know if this is no longer accessble
 
-    //now also update the event handlers.
-    for (size_t i = 0; i < INTERNAL::eventHandlers.size();) {
-        if (INTERNAL::eventHandlers[i] == this) {
-            INTERNAL::eventHandlers.erase(INTERNAL::eventHandlers.begin() + i);
+    // An element destroyed while its subtree is built was never registered, and the shared lists belong to another thread meanwhile.
+    bool registered = INTERNAL::detachedRegistrations == nullptr;
+
+    //now also update the event handlers, only elements with handlers are listed there.
+    for (size_t i = 0; registered && !handlers.empty() && i < INTERNAL::currentContext->eventHandlers.size();) {
+        if (INTERNAL::currentContext->eventHandlers[i] == this) {
+            INTERNAL::currentContext->eventHandlers.erase(INTERNAL::currentContext->eventHandlers.begin() + i);
             // don't increment i, since elements shifted left
 
             break;
@@ -171,13 +188,20 @@ GGUI::element::~element(){
         delete handlers[i];
     }
 
+    // Forget the name, unless another element has taken it since, otherwise the names of the removed elements pile up.
+    if (registered){
+        auto named = INTERNAL::currentContext->elementNames.find(getNameAsRaw());
+        if (named != INTERNAL::currentContext->elementNames.end() && named->second == this)
+            INTERNAL::currentContext->elementNames.erase(named);
+    }
+
     // Now make sure that if the Focused_On element points to this element, then set it to nullptr
     if (isFocused())
-        GGUI::INTERNAL::focusedOn = nullptr;
+        GGUI::INTERNAL::currentContext->focusedOn = nullptr;
 
     // Now make sure that if the Hovered_On element points to this element, then set it to nullptr
     if (isHovered())
-        GGUI::INTERNAL::hoveredOn = nullptr;
+        GGUI::INTERNAL::currentContext->hoveredOn = nullptr;
 }   
 
 /**
@@ -217,13 +241,16 @@ std::vector<GGUI::UTF>& GGUI::element::render(){
     }
 
     // This is to tell the rendering thread that some or no changes were made to the rendering buffer.
-    if (this == GGUI::INTERNAL::main && !Dirty.is(INTERNAL::STAIN_TYPE::CLEAN)){
-        GGUI::INTERNAL::identicalFrame = false;
+    if (this == GGUI::INTERNAL::currentContext->main && !Dirty.is(INTERNAL::STAIN_TYPE::CLEAN)){
+        GGUI::INTERNAL::currentContext->identicalFrame = false;
     }
 
     if (Dirty.is(INTERNAL::STAIN_TYPE::CLEAN))
         return renderBuffer;
 
+    // The children may have made this dirty only now.
+    INTERNAL::PROFILER::markDirty(this);
+
     if (Dirty.is(INTERNAL::STAIN_TYPE::MOVE)){
         Dirty.Clean(INTERNAL::STAIN_TYPE::MOVE);
 
@@ -280,8 +307,15 @@ std::vector<GGUI::UTF>& GGUI::element::render(){
             if (c->hasBorder())
                 Childs_With_Borders++;
 
-            std::vector<UTF>* tmp = &c->render();
+            INTERNAL::PROFILER::renderScope cost(this, c);
 
+            std::vector<UTF>* tmp;
+            {
+                GGUI_TRACE_SCOPE_DETAIL("element::render", c->getName());
+                tmp = &c->render();
+            }
+
+            cost.nesting(tmp->size());
             nestElement(this, c, renderBuffer, *tmp);
         }
     }
@@ -578,7 +612,9 @@ void GGUI::element::addChild(element* Child){
     Dirty.Dirty(INTERNAL::STAIN_TYPE::DEEP);
 
     // Add the child element to the parent's child list
-    INTERNAL::elementNames.insert({Child->getNameAsRaw(), Child});
+    INTERNAL::registerShared(Child, [Child](){
+        INTERNAL::currentContext->elementNames.insert({Child->getNameAsRaw(), Child});
+    });
 
     Style->Childs.push_back(Child);
 
@@ -630,8 +666,8 @@ bool GGUI::element::remove(element* handle){
     for (unsigned int i = 0; i < Style->Childs.size(); i++){
         if (Style->Childs[i] == handle){
             // If the mouse is focused on this about to be deleted element, change mouse position into it's parent Position.
-            if (INTERNAL::focusedOn == Style->Childs[i]){
-                INTERNAL::mouse = Style->Childs[i]->Parent->Style->Position.get();
+            if (INTERNAL::currentContext->focusedOn == Style->Childs[i]){
+                INTERNAL::currentContext->mouse = Style->Childs[i]->Parent->Style->Position.get();
             }
 
             delete handle;
@@ -734,8 +770,8 @@ bool GGUI::element::remove(size_t index){
     element* tmp = Style->Childs[index];
 
     // If the mouse is currently focused on the element that is about to be deleted, change the mouse position into the element's parent position.
-    if (INTERNAL::focusedOn == tmp){
-        INTERNAL::mouse = tmp->Parent->Style->Position.get();
+    if (INTERNAL::currentContext->focusedOn == tmp){
+        INTERNAL::currentContext->mouse = tmp->Parent->Style->Position.get();
     }
 
     // Delete the element at the specified index from the vector of child elements.
@@ -948,7 +984,9 @@ GGUI::element* GGUI::element::copy() const {
     }
 
     if (!new_element->handlers.empty()) {
-        INTERNAL::eventHandlers.push_back(new_element);
+        INTERNAL::registerShared(new_element, [new_element](){
+            INTERNAL::currentContext->eventHandlers.push_back(new_element);
+        });
     }
 
     // Clear the Focused on bool
@@ -968,16 +1006,18 @@ GGUI::element* GGUI::element::copy() const {
 void GGUI::element::addEventhandler(action* handler) {
     handlers.push_back(handler);
 
-    // Check if this element has been added to the INTERNAL::eventHandlers, if not, then append this into it.
-    bool found = false;
-    for (auto* h : GGUI::INTERNAL::eventHandlers){
-        if (h == this){
-            found = true;
-            break;
+    INTERNAL::registerShared(this, [this](){
+        // Check if this element has been added to the INTERNAL::eventHandlers, if not, then append this into it.
+        bool found = false;
+        for (auto* h : GGUI::INTERNAL::currentContext->eventHandlers){
+            if (h == this){
+                found = true;
+                break;
+            }
         }
-    }
 
-    if (!found) INTERNAL::eventHandlers.push_back(this);
+        if (!found) INTERNAL::currentContext->eventHandlers.push_back(this);
+    });
 }
 
 void GGUI::element::embedStyles(){
@@ -1608,7 +1648,8 @@ void GGUI::element::postProcessBorders(element* A, element* B, std::vector<UTF>&
 
     // two nested loops rotating the x and y usages.
     // store the line x,y into a array for the nested loops to access.
-    std::vector<int> Vertical_Line_X_Coordinates = {
+    // Fixed arrays instead of vectors, since this runs for every bordered child on every render.
+    const int Vertical_Line_X_Coordinates[] = {
         
         B->Style->Position.get().x,
         A->Style->Position.get().x,
@@ -1623,7 +1664,7 @@ void GGUI::element::postProcessBorders(element* A, element* B, std::vector<UTF>&
 
     };
 
-    std::vector<int> Horizontal_Line_Y_Coordinates = {
+    const int Horizontal_Line_Y_Coordinates[] = {
         
         A->Style->Position.get().y,
         B->Style->Position.get().y + B->getHeight() - 1,
@@ -1637,17 +1678,15 @@ void GGUI::element::postProcessBorders(element* A, element* B, std::vector<UTF>&
 
     };
 
-    std::vector<IVector3> Crossing_Indicies;
+    constexpr size_t Crossing_Count = sizeof(Horizontal_Line_Y_Coordinates) / sizeof(Horizontal_Line_Y_Coordinates[0]);
+    IVector3 Crossing_Indicies[Crossing_Count];
 
     // Go through singular box
-    for (size_t Box_Index = 0; Box_Index < Horizontal_Line_Y_Coordinates.size(); Box_Index++){
+    for (size_t Box_Index = 0; Box_Index < Crossing_Count; Box_Index++){
         // Now just pair the indicies from the two lists.
-        Crossing_Indicies.push_back(
-            // First pair
-            IVector3(
-                Vertical_Line_X_Coordinates[Box_Index],
-                Horizontal_Line_Y_Coordinates[Box_Index]
-            )
+        Crossing_Indicies[Box_Index] = IVector3(
+            Vertical_Line_X_Coordinates[Box_Index],
+            Horizontal_Line_Y_Coordinates[Box_Index]
         );
     }
 
@@ -1715,11 +1754,25 @@ void GGUI::element::postProcessBorders(element* A, element* B, std::vector<UTF>&
  * @details The lambda is given a pointer to the Event object that triggered the call.
  *          The lambda is expected to return true if it was successful and false if it failed.
  * @param action The lambda to be called when the element is clicked.
+ * @param async Whether the lambda is run on a worker thread instead of the input thread, see element::on().
  */
-void GGUI::element::onClick(std::function<bool(GGUI::event*)> job){
-    auto wrapper = [this, job](GGUI::event* e){
+void GGUI::element::onClick(std::function<bool(GGUI::event*)> job, bool async){
+    auto wrapper = [this, job, async](GGUI::event* e){
         // As os 0.1.8 no need to check for mouse collision with current element, since mouse collision is already checked at the eventHandler scheduler.
 
+        if (async){
+            std::string id = getName() + "::onClick";
+            unsigned long long criteria = e->criteria;
+
+            INTERNAL::HANDLER_POOL::submit(this, id, [job, id, criteria](){
+                GGUI::action event2actionWrapper(criteria, job, id);
+                return job(&event2actionWrapper);
+            });
+
+            // The click is consumed here, the result of the job is reported by the pool.
+            return true;
+        }
+
         // Construct an Action from the Event obj
         GGUI::action* event2actionWrapper = new GGUI::action(e->criteria, job, getName() + "::onClick");
 
@@ -1739,6 +1792,9 @@ void GGUI::element::onClick(std::function<bool(GGUI::event*)> job){
         getName() + "::onClick::wrapper::enter"
     );
 
+    mouse->async = async;
+    enter->async = async;
+
     addEventhandler(mouse);
     addEventhandler(enter);
 }
@@ -1750,20 +1806,37 @@ void GGUI::element::onClick(std::function<bool(GGUI::event*)> job){
  * @param criteria The criteria to check for when deciding whether to execute the lambda.
  * @param action The lambda to be called when the element is interacted with.
  * @param GLOBAL Whether the lambda should be executed even if the element is not under the mouse.
+ * @param async Whether the lambda is run on a worker thread instead of the input thread.
+ *              The lambda gets its own copy of the input, its pauseGGUI(f) and batch(f) calls are applied at the start of the next frame
+ *              and it must not call the plain pauseGGUI(). The input counts as consumed as soon as the lambda is queued.
  */
-void GGUI::element::on(unsigned long long criteria, std::function<bool(GGUI::event*)> job, bool GLOBAL){
+void GGUI::element::on(unsigned long long criteria, std::function<bool(GGUI::event*)> job, bool GLOBAL, bool async){
+    std::string id = getName() + "::on::" + std::to_string(criteria);
+
     action* a = new action(
         criteria,
-        [this, job, GLOBAL](GGUI::event* e){
+        [this, job, GLOBAL, async, id](GGUI::event* e){
             if (this->isFocused() || GLOBAL){
+                if (async){
+                    // The input is deleted once consumed, so the worker gets a copy of it.
+                    input copy = *static_cast<input*>(e);
+
+                    INTERNAL::HANDLER_POOL::submit(this, id, [job, copy]() mutable {
+                        return job(&copy);
+                    });
+
+                    return true;
+                }
+
                 // action successfully executed.
                 return job(e);
             }
             // action failed.
             return false;
         },
-        getName() + "::on::" + std::to_string(criteria)
+        id
     );
+    a->async = async;
     addEventhandler(a);
 }
 
@@ -1830,6 +1903,18 @@ std::string GGUI::element::getNameAsRaw() const {
     else return Name;
 }
 
+void GGUI::element::accountMemory(INTERNAL::MEMORY_USAGE::elementUsage& usage) const {
+    usage.object += sizeof(element) + Name.capacity() + handlers.capacity() * sizeof(action*);
+
+    for (const action* handler : handlers)
+        usage.object += sizeof(action) + handler->ID.capacity();
+
+    usage.renderBuffer += renderBuffer.capacity() * sizeof(UTF);
+
+    if (Style)
+        usage.style += Style->getMemoryUsage();
+}
+
 /**
  * @brief Checks if the element's name is empty.
  * 
@@ -1849,7 +1934,9 @@ void GGUI::element::setName(std::string name){
     Name = name;
 
     // Store the element in the global Element_Names map.
-    INTERNAL::elementNames[name] = this;
+    INTERNAL::registerShared(this, [this, name](){
+        INTERNAL::currentContext->elementNames[name] = this;
+    });
 }
 
 /**
@@ -1923,7 +2010,7 @@ void GGUI::element::reOrderChilds() {
  */
 void GGUI::element::focus() {
     // Set the mouse position to the element's position.
-    GGUI::INTERNAL::mouse = this->Style->Position.get();
+    GGUI::INTERNAL::currentContext->mouse = this->Style->Position.get();
     // Update the focused element.
     GGUI::INTERNAL::updateFocusedElement(this);
 }
@@ -2011,4 +2098,76 @@ bool GGUI::element::childIsShown(element* other){
 
     // Return true if the child element is visible within the bounds of the parent
     return X_Is_Inside && Y_Is_Inside;
-}
\ No newline at end of file
+}
+/**
+ * @brief Builds the subtree on the calling thread.
+ * @details Everything the construction would register into the shared registries is collected, and pauseGGUI() and updateFrame() are
+ *          skipped on this thread meanwhile. Then the styles of the root, and through it of the whole subtree, are embedded against a
+ *          stand-in parent of the target size.
+ * @param construct Creates the elements and returns the root of the subtree.
+ * @param targetSize Size of the parent the subtree is going to be attached into, the terminal size by default.
+ */
+GGUI::subtree::subtree(std::function<element*()> construct, IVector2 targetSize){
+    // Subtrees can be built inside of each other.
+    std::vector<std::pair<const void*, std::function<void()>>>* previous = INTERNAL::detachedRegistrations;
+    INTERNAL::detachedRegistrations = &registrations;
+
+    try{
+        root = construct();
+
+        if (root && root->getDirty().is(INTERNAL::STAIN_TYPE::FINALIZE)){
+            if (targetSize.x == 0 && targetSize.y == 0)
+                targetSize = IVector2(INTERNAL::currentContext->maxWidth, INTERNAL::currentContext->maxHeight);
+
+            element standIn;
+            standIn.setDimensions(targetSize.x, targetSize.y);
+
+            root->setParent(&standIn);
+            root->compile();
+            root->setParent(nullptr);
+        }
+    }
+    catch(std::exception& e){
+        INTERNAL::reportStack("Failed to build a subtree: " + std::string(e.what()));
+    }
+
+    INTERNAL::detachedRegistrations = previous;
+}
+
+/**
+ * @brief Deletes the elements if they were never attached, their deferred registrations are dropped with them.
+ */
+GGUI::subtree::~subtree(){
+    if (attached || !root)
+        return;
+
+    // The destructors look into the shared registries.
+    pauseGGUI([this](){
+        delete root;
+    });
+}
+
+/**
+ * @brief Makes the collected registrations and adds the root as a child of the parent, all under one pauseGGUI().
+ * @details When called while another subtree is being built on this thread, the registrations are handed over to that one instead.
+ * @param parent The element to add the root into.
+ * @return False if there was nothing to attach, or it was already attached.
+ */
+bool GGUI::subtree::attach(element* parent){
+    if (!root || !parent || attached)
+        return false;
+
+    pauseGGUI([this, parent](){
+        for (auto& registration : registrations)
+            INTERNAL::registerShared(registration.first, std::move(registration.second));
+
+        registrations.clear();
+
+        root->setParent(parent);
+        parent->addChild(root);
+    });
+
+    attached = true;
+
+    return true;
+}
@@ -17,13 +17,14 @@
 #include "../core/utils/color.h"
 #include "../core/utils/utf.h"
 #include "../core/utils/style.h"
+#include "../core/utils/memoryUsage.h"
 
 namespace GGUI{
     namespace STYLING_INTERNAL {
         class styleBase;
     }
     namespace INTERNAL {
-        extern void renderer();
+        extern void renderCycle();
     }
 
     class element{
@@ -999,6 +1000,13 @@ namespace GGUI{
             return "element<" + getNameAsRaw() + ">";
         }
 
+        /**
+         * @brief Adds the bytes this element holds into the usage, without its children.
+         * @details Element types which hold more than the element itself add their own on top of this.
+         * @param usage Where the bytes are added, see INTERNAL::MEMORY_USAGE.
+         */
+        virtual void accountMemory(INTERNAL::MEMORY_USAGE::elementUsage& usage) const;
+
         /**
          * @brief Retrieves the name of the element as a raw string.
          * 
@@ -1038,8 +1046,10 @@ namespace GGUI{
          * @details The lambda is given a pointer to the Event object that triggered the call.
          *          The lambda is expected to return true if it was successful and false if it failed.
          * @param action The lambda to be called when the element is clicked.
+         * @param async Whether the lambda is run on a worker thread instead of the input thread, see on().
+         *              Its changes to the elements must then be made inside pauseGGUI(f), batch(f) or post().
          */
-        void onClick(std::function<bool(GGUI::event*)> action);
+        void onClick(std::function<bool(GGUI::event*)> action, bool async = false);
 
         /**
          * @brief A function that registers a lambda to be executed when the element is interacted with in any way.
@@ -1048,8 +1058,12 @@ namespace GGUI{
          * @param criteria The criteria to check for when deciding whether to execute the lambda.
          * @param action The lambda to be called when the element is interacted with.
          * @param GLOBAL Whether the lambda should be executed even if the element is not under the mouse.
+         * @param async Whether the lambda is run on a worker thread, so that a slow lambda does not block the rendering and the other input.
+         *              Its pauseGGUI(f) and batch(f) calls are applied at the start of the next frame, and it must not call the plain pauseGGUI().
+         *              Every change it makes to the elements must be made inside pauseGGUI(f), batch(f) or post(), since a direct one, like
+         *              a plain setText(), runs while the rendering thread reads the elements. Such changes are reported and counted per handler.
          */
-        void on(unsigned long long criteria, std::function<bool(GGUI::event*)> action, bool GLOBAL = false);
+        void on(unsigned long long criteria, std::function<bool(GGUI::event*)> action, bool GLOBAL = false, bool async = false);
 
         /**
          * @brief Retrieves an element by its name.
@@ -1414,8 +1428,8 @@ namespace GGUI{
          */
         virtual std::vector<GGUI::UTF>& render();
 
-        // Give thread::renderer() access to our private render method.
-        friend void INTERNAL::renderer();
+        // Give thread::renderCycle() access to our private render method.
+        friend void INTERNAL::renderCycle();
         
         // Give styling class access to some private methods.
         friend class styling;
@@ -1438,6 +1452,50 @@ namespace GGUI{
         void compile() { embedStyles(); }
         
     };
+
+    /**
+     * @brief An element tree built apart from the live one, on any thread, and attached into the live tree with one brief pause.
+     * @details The construction runs without pausing GGUI, since nothing else can reach the elements yet. Registrations into the shared
+     *          registries, like element names and event handlers, are collected and only made in attach(). The styles are embedded against a
+     *          stand-in parent of the target size, so percentages and positions are already resolved by the time the subtree is attached.
+     *          The construction must not touch elements of the live tree.
+     */
+    class subtree{
+    public:
+        /**
+         * @brief Builds the subtree on the calling thread.
+         * @param construct Creates the elements and returns the root of the subtree.
+         * @param targetSize Size of the parent the subtree is going to be attached into, the terminal size by default.
+         */
+        subtree(std::function<element*()> construct, IVector2 targetSize = IVector2());
+
+        subtree(const subtree&) = delete;
+        subtree& operator=(const subtree&) = delete;
+
+        /**
+         * @brief Deletes the elements if they were never attached.
+         */
+        ~subtree();
+
+        element* getRoot() const { return root; }
+
+        bool isAttached() const { return attached; }
+
+        /**
+         * @brief Makes the collected registrations and adds the root as a child of the parent, all under one pauseGGUI().
+         * @details When called while another subtree is being built on this thread, the registrations are handed over to that one instead.
+         * @param parent The element to add the root into.
+         * @return False if there was nothing to attach, or it was already attached.
+         */
+        bool attach(element* parent);
+
+    private:
+        element* root = nullptr;
+        bool attached = false;
+
+        // Registrations deferred during the construction, with the elements they belong to.
+        std::vector<std::pair<const void*, std::function<void()>>> registrations;
+    };
 }
 
 #endif
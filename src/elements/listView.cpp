@@ -134,7 +134,9 @@ void GGUI::listView::addChild(element* e) {
         Dirty.Dirty(INTERNAL::STAIN_TYPE::DEEP);
 
         // Add the child element to the internal structures.
-        INTERNAL::elementNames.insert({e->getNameAsRaw(), e});
+        INTERNAL::registerShared(e, [e](){
+            INTERNAL::currentContext->elementNames.insert({e->getNameAsRaw(), e});
+        });
         Style->Childs.push_back(e);
     });
 }
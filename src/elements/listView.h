@@ -45,8 +45,12 @@ namespace GGUI{
          * allocated by the List_View object, including its child elements.
          */
         ~listView() override {
-            // Delete all child elements to avoid memory leaks.
-            for (element* e : Style->Childs) {
+            // Delete all child elements to avoid memory leaks, take them out first since they would erase themselves from the list while it is iterated.
+            std::vector<element*> owned;
+            owned.swap(Style->Childs);
+
+            for (element* e : owned) {
+                e->setParent(nullptr);
                 delete e;
             }
         }
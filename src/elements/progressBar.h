@@ -34,6 +34,10 @@ namespace GGUI{
             inline styleBase* copy() const override {
                 return new part(*this);
             }
+
+            inline size_t getSize() const override {
+                return sizeof(part);
+            }
             
             constexpr part& operator=(const part& other){
                 // Only copy the information if the other is enabled.
@@ -58,6 +58,10 @@ namespace GGUI{
             return new visualState(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(visualState);
+        }
+
         /**
          * @brief Overloaded assignment operator for the visualState class.
          * 
@@ -129,6 +133,10 @@ namespace GGUI{
             return new singleSelect(*this);
         }
 
+        inline size_t getSize() const override {
+            return sizeof(singleSelect);
+        }
+
         /**
          * @brief Overloaded assignment operator for the singleSelect class.
          * 
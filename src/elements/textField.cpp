@@ -231,7 +231,26 @@ namespace GGUI{
 
         Dirty.Dirty(INTERNAL::STAIN_TYPE::DEEP | INTERNAL::STAIN_TYPE::RESET);
 
-        updateTextCache();
+        // Within GGUI::batch() the cache is re-built once for all of the changes.
+        INTERNAL::deferToBatchEnd(this, [this](){ updateTextCache(); });
+
+        updateFrame();
+    }
+
+    /**
+     * @brief Appends text to the end of the text field.
+     * @details Only the new text is copied and the text cache is re-built once, so that even megabytes of pasted text stay a single operation.
+     * @param text The text to append.
+     */
+    void textField::appendText(const std::string& text){
+        if (text.empty())
+            return;
+
+        Text.append(text);
+
+        Dirty.Dirty(INTERNAL::STAIN_TYPE::DEEP | INTERNAL::STAIN_TYPE::RESET);
+
+        INTERNAL::deferToBatchEnd(this, [this](){ updateTextCache(); });
 
         updateFrame();
     }
@@ -362,7 +381,7 @@ namespace GGUI{
      *          calls the Then function with the character as input. If the event is a backspace, it removes the last character from the text field. In all cases, it marks the text field as
      *          dirty and updates the frame.
      */
-    void textField::input(std::function<void(textField*, char)> Then) {
+    void textField::input(std::function<void(textField*, char)> Then, std::function<void(textField*, const std::string&)> Then_Paste) {
         action* key_press = new action(
             constants::KEY_PRESS,
             [this, Then](GGUI::event* e) {
@@ -386,7 +405,7 @@ namespace GGUI{
         action* enter = new action(
             constants::ENTER,
             [this, Then](GGUI::event* e) {
-                if (Focused && INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER].state) {
+                if (Focused && INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::ENTER].state) {
                     //We know the event was gifted as Input*
                     GGUI::input* input = (GGUI::input*)e;
 
@@ -406,7 +425,7 @@ namespace GGUI{
         action* back_space = new action(
             constants::BACKSPACE,
             [this](GGUI::event*) {
-                if (Focused && INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE].state) {
+                if (Focused && INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE].state) {
                     //If the text field is empty, there is nothing to do
                     if (Text.size() > 0) {
                         Text.pop_back();
@@ -425,5 +444,26 @@ namespace GGUI{
             getName() + "::input::backspace"
         );
         addEventhandler(back_space);
+
+        action* paste = new action(
+            constants::PASTE,
+            [this, Then_Paste](GGUI::event* e) {
+                if (Focused) {
+                    //We know the event was gifted as Input*
+                    GGUI::input* input = (GGUI::input*)e;
+
+                    if (Then_Paste)
+                        Then_Paste(this, input->text);
+                    else
+                        appendText(input->text);
+
+                    return true;
+                }
+                //action failed.
+                return false;
+            },
+            getName() + "::input::paste"
+        );
+        addEventhandler(paste);
     }
 }
\ No newline at end of file
@@ -56,6 +56,14 @@ namespace GGUI{
          */
         void setText(std::string text);
 
+        /**
+         * @brief Appends text to the end of the text field.
+         * @details Unlike calling setText() with the previous text and the addition, this only appends into the existing buffer,
+         *          re-builds the text cache once and does not touch the name of the element. Used for pasting whole clipboards at once.
+         * @param text The text to append.
+         */
+        void appendText(const std::string& text);
+
         /**
          * @brief Gets the text of the text field.
          * @details This function returns the string containing the text of the text field.
@@ -94,12 +102,22 @@ namespace GGUI{
         /**
          * @brief Listens for input and calls a function when user presses any key.
          * @param Then A function that takes a character as input and does something with it.
-         * @details This function creates three actions (for key press, enter, and backspace) that listen for input when the text field is focused. If the event is a key press or enter, it
-         *          calls the Then function with the character as input. If the event is a backspace, it removes the last character from the text field. In all cases, it marks the text field as
-         *          dirty and updates the frame.
+         * @param Then_Paste Optional function that receives a whole bracketed paste at once. If not given, the pasted text is appended with appendText().
+         * @details This function creates four actions (for key press, enter, backspace and paste) that listen for input when the text field is focused. If the event is a key press or enter, it
+         *          calls the Then function with the character as input. If the event is a backspace, it removes the last character from the text field. Pastes are not split into key presses,
+         *          but given as one string to Then_Paste. In all cases, it marks the text field as dirty and updates the frame.
          */
-        void input(std::function<void(textField*, char)> Then);
+        void input(std::function<void(textField*, char)> Then, std::function<void(textField*, const std::string&)> Then_Paste = nullptr);
 
+        /**
+         * @brief Adds the text and its line cache on top of what the element holds.
+         */
+        void accountMemory(INTERNAL::MEMORY_USAGE::elementUsage& usage) const override {
+            element::accountMemory(usage);
+
+            usage.object += sizeof(textField) - sizeof(element);
+            usage.content += Text.capacity() + Text_Cache.capacity() * sizeof(INTERNAL::compactString);
+        }
 
     protected:
         /**
@@ -6,6 +6,25 @@
 #include "units/elementSuite.h"
 #include "units/switchSuite.h"
 #include "units/textFieldSuite.h"
+#include "units/memorySuite.h"
+#include "units/commandQueueSuite.h"
+#include "units/guardSuite.h"
+#include "units/renderTicketSuite.h"
+#include "units/subtreeSuite.h"
+#include "units/batchSuite.h"
+#include "units/handlerPoolSuite.h"
+#include "units/contextSuite.h"
+#include "units/frameServerSuite.h"
+#include "units/backendSuite.h"
+#include "units/sessionSuite.h"
+#include "units/traceSuite.h"
+#include "units/metricsSuite.h"
+#include "units/profilerSuite.h"
+#include "units/allocationSuite.h"
+#include "units/memoryUsageSuite.h"
+#include "units/clockSuite.h"
+#include "units/performanceSuite.h"
+#include "units/eventLoopSuite.h"
 
 int main() {
     std::cout << tester::utils::colorText("GGUI Framework Test Suite\n", GGUI::COLOR::BLUE);
@@ -20,6 +39,29 @@ int main() {
             new tester::elementSuite(),
             new tester::switchSuite(),
             new tester::textFieldSuite(),
+            new tester::memorySuite(),
+            new tester::commandQueueSuite(),
+            new tester::guardSuite(),
+            new tester::renderTicketSuite(),
+            new tester::subtreeSuite(),
+            new tester::batchSuite(),
+            new tester::handlerPoolSuite(),
+            new tester::contextSuite(),
+#if defined(__linux__)
+            new tester::frameServerSuite(),
+#endif
+            new tester::backendSuite(),
+            new tester::sessionSuite(),
+            new tester::traceSuite(),
+            new tester::metricsSuite(),
+            new tester::profilerSuite(),
+            new tester::allocationSuite(),
+            new tester::memoryUsageSuite(),
+            new tester::clockSuite(),
+            new tester::performanceSuite(),
+#if defined(__linux__)
+            new tester::eventLoopSuite(),
+#endif
         });
     } catch (const std::exception& e) {
         std::cout << tester::utils::colorText("Test suite crashed with exception: ", GGUI::COLOR::RED) << e.what() << "\n";
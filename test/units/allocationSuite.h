@@ -0,0 +1,90 @@
+#ifndef _ALLOCATION_SUITE_H_
+#define _ALLOCATION_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// Steady-state frames and input, which must not allocate once warmed up.
+// Only checked in builds which count the allocations, see ALLOCATIONS::isCounting().
+
+namespace tester {
+    class allocationSuite : public utils::TestSuite {
+    public:
+        allocationSuite() : utils::TestSuite("Allocations") {
+            add_test("steady_frame_does_not_allocate", "A warmed up frame repainting a changed element makes no heap allocations", test_steady_frame_does_not_allocate);
+            add_test("steady_input_does_not_allocate", "Warmed up keys are translated and handled without heap allocations", test_steady_input_does_not_allocate);
+        }
+
+    private:
+        // Builds a small bordered scene into the headless backend and runs the given steps on it, on a thread of its own.
+        static void onScene(const std::function<void(GGUI::element* changing)>& steps) {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            utils::onHeadlessScene(30, 8, [&steps](element* main, headlessBackend&) {
+                element* changing = new element(width(8) | height(4) | enableBorder(true) | name("Changing"));
+                element* still = new element(width(8) | height(4) | position(IVector3(12, 0)) | enableBorder(true) | name("Still"));
+                main->addChild(changing);
+                main->addChild(still);
+
+                steps(changing);
+            });
+        }
+
+        static void test_steady_frame_does_not_allocate() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            if (!ALLOCATIONS::isCounting())
+                SKIP_TEST("allocations are only counted in GGUI_PROFILE builds");
+
+            uint64_t allocated = UINT64_MAX;
+
+            onScene([&allocated](element* changing) {
+                // Both colors are rendered once, so that every buffer and cache has reached its size.
+                for (int round = 0; round < 4; round++) {
+                    changing->setBackgroundColor(round % 2 ? COLOR::RED : COLOR::BLUE);
+                    utils::renderOneFrame();
+                }
+
+                changing->setBackgroundColor(COLOR::RED);
+
+                uint64_t before = ALLOCATIONS::onThisThread();
+                utils::renderOneFrame();
+                allocated = ALLOCATIONS::onThisThread() - before;
+            });
+
+            ASSERT_EQ((uint64_t)0, allocated);
+        }
+
+        static void test_steady_input_does_not_allocate() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            if (!ALLOCATIONS::isCounting())
+                SKIP_TEST("allocations are only counted in GGUI_PROFILE builds");
+
+            const char keys[] = "abc\x1b[A\x1b[B";
+            uint64_t allocated = UINT64_MAX;
+
+            onScene([&](element*) {
+                auto type = [&keys]() {
+                    setRawInput(keys, sizeof(keys) - 1);
+                    while (Translate_Inputs());
+                    eventHandler();
+                };
+
+                for (int round = 0; round < 4; round++)
+                    type();
+
+                uint64_t before = ALLOCATIONS::onThisThread();
+                type();
+                allocated = ALLOCATIONS::onThisThread() - before;
+            });
+
+            ASSERT_EQ((uint64_t)0, allocated);
+        }
+    };
+}
+
+#endif
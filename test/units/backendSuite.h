@@ -0,0 +1,75 @@
+#ifndef _BACKEND_SUITE_H_
+#define _BACKEND_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// Rendering and input through the headless backend, without a terminal.
+
+namespace tester {
+    class backendSuite : public utils::TestSuite {
+    public:
+        backendSuite() : utils::TestSuite("Headless backend") {
+            add_test("headless_presents_changed_frames", "Each changed frame is kept with its cells and terminal bytes, identical frames are skipped", test_headless_presents_changed_frames);
+            add_test("headless_feed_reaches_handlers", "Fed bytes are translated into inputs like terminal input", test_headless_feed_reaches_handlers);
+        }
+
+    private:
+        static void test_headless_presents_changed_frames() {
+            using namespace GGUI;
+
+            size_t frames[3] = {};
+            size_t cells = 0;
+            std::string first;
+            std::string last;
+
+            utils::onHeadlessScene(10, 3, [&](element* main, INTERNAL::headlessBackend& output) {
+                main->setBackgroundColor(COLOR::BLUE);
+
+                INTERNAL::renderCycle();
+                frames[0] = output.getFrameCount();
+                cells = output.getCells().size();
+                first = output.getFrame();
+
+                // Nothing changed, nothing is presented.
+                INTERNAL::renderCycle();
+                frames[1] = output.getFrameCount();
+
+                main->setBackgroundColor(COLOR::RED);
+                INTERNAL::renderCycle();
+                frames[2] = output.getFrameCount();
+                last = output.getFrame();
+            });
+
+            ASSERT_EQ((size_t)1, frames[0]);
+            ASSERT_EQ((size_t)1, frames[1]);
+            ASSERT_EQ((size_t)2, frames[2]);
+            ASSERT_EQ((size_t)30, cells);
+
+            // The same bytes the terminal would have got: cursor home and the encoded frame.
+            ASSERT_EQ((size_t)0, first.find("\x1B[H"));
+            ASSERT_TRUE(first.find("\x1B[48;2;0;0;255m") != std::string::npos);
+            ASSERT_NE(first, last);
+        }
+
+        static void test_headless_feed_reaches_handlers() {
+            using namespace GGUI;
+
+            std::string typed;
+
+            utils::onHeadlessScene(10, 3, [&typed](element* main, INTERNAL::headlessBackend& output) {
+                main->setFocus(true);
+                main->on(constants::KEY_PRESS, [&typed](event* e) {
+                    typed += static_cast<input*>(e)->data;
+                    return true;
+                }, true);
+
+                output.feed("hi");
+            });
+
+            ASSERT_EQ(std::string("hi"), typed);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef _BATCH_SUITE_H_
+#define _BATCH_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// Mutations grouped with GGUI::batch().
+
+namespace tester {
+    class batchSuite : public utils::TestSuite {
+    public:
+        batchSuite() : utils::TestSuite("Batched mutations") {
+            add_test("one_frame_for_many_changes", "Any number of setters, even in nested batches, request exactly one frame", test_one_frame_for_many_changes);
+            add_test("deferred_jobs_run_once", "Jobs deferred with the same key run once at the end, the last one given", test_deferred_jobs_run_once);
+            add_test("text_settles_at_end", "Text fields changed many times within a batch end up with the last text", test_text_settles_at_end);
+        }
+
+    private:
+        static void test_one_frame_for_many_changes() {
+            using namespace GGUI;
+
+            std::vector<element*> rows;
+            for (int i = 0; i < 20; i++)
+                rows.push_back(new element(width(5) | height(1)));
+
+            uint32_t before = INTERNAL::currentContext->ticket.getGeneration();
+
+            batch([&rows]() {
+                for (element* row : rows) {
+                    row->setBackgroundColor(COLOR::RED);
+                    row->setTextColor(COLOR::BLUE);
+                    row->setPosition({1, 2});
+                    row->setWidth(6);
+                }
+
+                batch([&rows]() {
+                    rows[0]->setBorderColor(COLOR::GREEN);
+                });
+            });
+
+            ASSERT_EQ(before + 1, INTERNAL::currentContext->ticket.getGeneration());
+            ASSERT_EQ(6, rows[19]->getWidth());
+
+            for (element* row : rows)
+                delete row;
+        }
+
+        static void test_deferred_jobs_run_once() {
+            using namespace GGUI;
+
+            int first = 0, second = 0;
+            std::string order;
+
+            batch([&]() {
+                INTERNAL::deferToBatchEnd(&first, [&]() { first += 1; order += "a"; });
+                INTERNAL::deferToBatchEnd(&second, [&]() { second++; order += "b"; });
+                INTERNAL::deferToBatchEnd(&first, [&]() { first += 10; order += "A"; });
+
+                // Nothing runs before the batch ends.
+                ASSERT_EQ(0, first);
+            });
+
+            ASSERT_EQ(10, first);
+            ASSERT_EQ(1, second);
+            ASSERT_EQ(std::string("Ab"), order);
+
+            // Outside of a batch the job runs right away.
+            INTERNAL::deferToBatchEnd(&first, [&]() { first = -1; });
+            ASSERT_EQ(-1, first);
+        }
+
+        static void test_text_settles_at_end() {
+            using namespace GGUI;
+
+            textField* field = new textField(text("start"));
+
+            batch([field]() {
+                for (int i = 0; i < 100; i++)
+                    field->setText(std::to_string(i));
+            });
+
+            ASSERT_EQ(std::string("99"), field->getText());
+
+            delete field;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef _CLOCK_SUITE_H_
+#define _CLOCK_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// The injectable clock and the animations driven by it.
+
+namespace tester {
+    class clockSuite : public utils::TestSuite {
+    public:
+        clockSuite() : utils::TestSuite("Clock") {
+            add_test("virtual_clock_moves_only_when_told", "A virtual clock stands still until it is set or advanced", test_virtual_clock_moves_only_when_told);
+            add_test("fast_forward_skips_sleeps", "Sleeping on a fast forwarded clock moves it instead of waiting", test_fast_forward_skips_sleeps);
+            add_test("animation_is_repeatable", "Memory driven animations render the same frames on every run of a virtual clock", test_animation_is_repeatable);
+        }
+
+    private:
+        using clock = GGUI::INTERNAL::CLOCK::timePoint::clock;
+
+        static void test_virtual_clock_moves_only_when_told() {
+            using namespace GGUI::INTERNAL;
+
+            CLOCK::timePoint origin = clock::now();
+
+            CLOCK::setVirtual(origin);
+            ASSERT_TRUE(CLOCK::isVirtual());
+            ASSERT_TRUE(CLOCK::getMode() == CLOCK::MODE::VIRTUAL);
+            ASSERT_TRUE(CLOCK::now() == origin);
+
+            CLOCK::advance(std::chrono::milliseconds(5));
+            ASSERT_TRUE(CLOCK::now() == origin + std::chrono::milliseconds(5));
+
+            // Only fast forwarding moves the clock on sleeps.
+            CLOCK::sleepFor(std::chrono::milliseconds(1));
+            ASSERT_TRUE(CLOCK::now() == origin + std::chrono::milliseconds(5));
+
+            CLOCK::useReal();
+            ASSERT_FALSE(CLOCK::isVirtual());
+
+            // The real clock is not moved.
+            CLOCK::timePoint before = clock::now();
+            CLOCK::advance(std::chrono::hours(1));
+            ASSERT_TRUE(CLOCK::now() < before + std::chrono::hours(1));
+        }
+
+        static void test_fast_forward_skips_sleeps() {
+            using namespace GGUI::INTERNAL;
+
+            CLOCK::timePoint origin = clock::now();
+            CLOCK::fastForward(origin);
+
+            auto start = clock::now();
+            CLOCK::sleepFor(std::chrono::seconds(60));
+            auto waited = clock::now() - start;
+
+            CLOCK::timePoint arrived = CLOCK::now();
+            CLOCK::useReal();
+
+            ASSERT_TRUE(arrived == origin + std::chrono::seconds(60));
+            ASSERT_TRUE(waited < std::chrono::seconds(1));
+        }
+
+        // Runs five virtual seconds of blinking panels at 60 frames per second and hashes every frame written.
+        static size_t animate() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            size_t hash = 0;
+
+            utils::onHeadlessScene(30, 6, [&hash](element* main, headlessBackend& output) {
+                CLOCK::fastForward(CLOCK::timePoint());
+
+                const size_t periods[] = { 16, 50, 333 };
+                for (int i = 0; i < 3; i++) {
+                    element* panel = new element(width(10) | height(6) | position(IVector3(i * 10, 0)) | enableBorder(true));
+                    main->addChild(panel);
+
+                    addMemory(memory(periods[i], [panel](event*) {
+                        panel->setBackgroundColor(panel->getBackgroundColor() == COLOR::RED ? COLOR::BLUE : COLOR::RED);
+                        return true;
+                    }, MEMORY_FLAGS::RETRIGGER));
+                }
+
+                for (int frame = 0; frame < 5 * 60; frame++) {
+                    CLOCK::advance(std::chrono::microseconds(16667));
+                    runEventTasks();
+                    utils::renderOneFrame();
+
+                    hash = hash * 31 + std::hash<std::string>()(output.getFrame());
+                }
+
+                CLOCK::useReal();
+            });
+
+            return hash;
+        }
+
+        static void test_animation_is_repeatable() {
+            size_t first = animate();
+            size_t second = animate();
+
+            ASSERT_EQ(first, second);
+        }
+    };
+}
+
+#endif
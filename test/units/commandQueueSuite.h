@@ -0,0 +1,70 @@
+#ifndef _COMMAND_QUEUE_SUITE_H_
+#define _COMMAND_QUEUE_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+
+// Commands posted from other threads with GGUI::post().
+
+namespace tester {
+    class commandQueueSuite : public utils::TestSuite {
+    public:
+        commandQueueSuite() : utils::TestSuite("Posted command queue") {
+            add_test("producers_keep_their_order", "Commands from concurrent producers are all applied, each producer's in its own order", test_producers_keep_their_order);
+            add_test("throwing_command_is_contained", "A throwing command does not stop the commands after it", test_throwing_command_is_contained);
+        }
+
+    private:
+        static void test_producers_keep_their_order() {
+            using namespace GGUI;
+
+            constexpr int producerCount = 4;
+            constexpr int perProducer = 10000;
+
+            std::vector<int> lastSeen(producerCount, -1);
+            bool inOrder = true;
+
+            std::vector<std::thread> producers;
+            for (int p = 0; p < producerCount; p++) {
+                producers.emplace_back([p, &lastSeen, &inOrder]() {
+                    for (int i = 0; i < perProducer; i++) {
+                        post([p, i, &lastSeen, &inOrder]() {
+                            inOrder &= lastSeen[p] == i - 1;
+                            lastSeen[p] = i;
+                        });
+                    }
+                });
+            }
+
+            // Drain concurrently with the producers, like the rendering thread would.
+            size_t applied = 0;
+            while (applied < producerCount * perProducer)
+                applied += INTERNAL::applyCommands();
+
+            for (auto& producer : producers)
+                producer.join();
+
+            ASSERT_TRUE(inOrder);
+            ASSERT_TRUE(INTERNAL::currentContext->commands.empty());
+
+            for (int p = 0; p < producerCount; p++)
+                ASSERT_EQ(perProducer - 1, lastSeen[p]);
+        }
+
+        static void test_throwing_command_is_contained() {
+            using namespace GGUI;
+
+            bool afterRan = false;
+
+            post([]() { throw std::runtime_error("posted failure"); });
+            post([&afterRan]() { afterRan = true; });
+
+            ASSERT_EQ((size_t)2, INTERNAL::applyCommands());
+            ASSERT_TRUE(afterRan);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef _CONTEXT_SUITE_H_
+#define _CONTEXT_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+
+// Separate GGUI instances, each driven from its own thread through its own context.
+
+namespace tester {
+    class contextSuite : public utils::TestSuite {
+    public:
+        contextSuite() : utils::TestSuite("Per-instance context") {
+            add_test("registries_are_per_context", "Handlers, names and posted commands go into the context of the registering thread", test_registries_are_per_context);
+            add_test("contexts_render_concurrently", "Two contexts rendering at the same time never see each other's frames", test_contexts_render_concurrently);
+            add_test("contexts_paste_at_the_same_time", "Each context translates its own input, so their pastes in progress do not mix", test_contexts_paste_at_the_same_time);
+            add_test("canvases_animate_per_context", "Multi-frame canvases register into the context they are made in", test_canvases_animate_per_context);
+            add_test("holds_are_per_context", "Pausing one context does not defer the frames of another", test_holds_are_per_context);
+        }
+
+    private:
+        // Renders directly, like the rendering thread does.
+        class renderedElement : public GGUI::element {
+        public:
+            using GGUI::element::element;
+            using GGUI::element::render;
+        };
+
+        // Sizes its sprite buffer when rendered.
+        class renderedCanvas : public GGUI::canvas {
+        public:
+            using GGUI::canvas::canvas;
+            using GGUI::canvas::render;
+        };
+
+        static void test_registries_are_per_context() {
+            using namespace GGUI;
+
+            INTERNAL::context session;
+            size_t defaultHandlers = INTERNAL::defaultContext.eventHandlers.size();
+            bool registered = false;
+            bool ran = false;
+
+            std::thread([&]() {
+                INTERNAL::currentContext = &session;
+
+                element* host = new element();
+                host->setName("contextSuite::host");
+                host->on(constants::ENTER, [](event*) { return true; }, true);
+
+                registered = session.eventHandlers.size() == 1 && session.elementNames.count("contextSuite::host") == 1;
+
+                post([&ran]() { ran = true; });
+
+                delete host;
+            }).join();
+
+            ASSERT_TRUE(registered);
+            ASSERT_TRUE(session.eventHandlers.empty());
+            ASSERT_EQ(defaultHandlers, INTERNAL::defaultContext.eventHandlers.size());
+            ASSERT_EQ((size_t)0, INTERNAL::defaultContext.elementNames.count("contextSuite::host"));
+
+            // The command waits in the session, the default context has nothing to apply.
+            ASSERT_EQ((size_t)0, INTERNAL::applyCommands());
+            ASSERT_FALSE(ran);
+
+            INTERNAL::currentContext = &session;
+            size_t applied = INTERNAL::applyCommands();
+            INTERNAL::currentContext = &INTERNAL::defaultContext;
+
+            ASSERT_EQ((size_t)1, applied);
+            ASSERT_TRUE(ran);
+        }
+
+        static void test_contexts_render_concurrently() {
+            using namespace GGUI;
+
+            constexpr int frames = 200;
+            bool consistent[2] = { true, true };
+            std::string firstFrames[2];
+
+            auto session = [&consistent, &firstFrames](int index, RGB color) {
+                INTERNAL::context own;
+                INTERNAL::currentContext = &own;
+
+                renderedElement* root = new renderedElement(width(12 + index) | height(3));
+
+                std::string seen[2];
+                for (int frame = 0; frame < frames; frame++) {
+                    root->setBackgroundColor(frame % 2 ? color : COLOR::BLACK);
+
+                    std::vector<UTF>& cells = root->render();
+                    INTERNAL::encodeBuffer(&cells);
+
+                    unsigned int liquefiedSize = 0;
+                    INTERNAL::conveyorAllocator<INTERNAL::compactString> liquefied = INTERNAL::liquifyUTFText(&cells, liquefiedSize, root->getWidth(), root->getHeight());
+                    std::string result = *INTERNAL::toString(liquefied, liquefiedSize, own.encodedFrame);
+
+                    if (frame < 2)
+                        seen[frame] = result;
+                    else
+                        consistent[index] = consistent[index] && seen[frame % 2] == result;
+                }
+
+                firstFrames[index] = seen[1];
+
+                delete root;
+            };
+
+            std::thread first(session, 0, COLOR::RED);
+            std::thread second(session, 1, COLOR::BLUE);
+            first.join();
+            second.join();
+
+            ASSERT_TRUE(consistent[0]);
+            ASSERT_TRUE(consistent[1]);
+            ASSERT_NE(firstFrames[0], firstFrames[1]);
+        }
+
+        static void test_contexts_paste_at_the_same_time() {
+            using namespace GGUI;
+
+            std::string pasted[2];
+            std::atomic<int> opened = 0;
+
+            auto session = [&pasted, &opened](int index) {
+                utils::onHeadlessScene(10, 3, [&pasted, &opened, index](element* main, INTERNAL::headlessBackend& output) {
+                    main->setFocus(true);
+                    main->on(constants::PASTE, [&pasted, index](event* e) {
+                        pasted[index] = static_cast<input*>(e)->text;
+                        return true;
+                    }, true);
+
+                    output.feed(index ? "\x1B[200~left" : "\x1B[200~right");
+
+                    // Both pastes are open before either ends.
+                    opened++;
+                    while (opened < 2)
+                        std::this_thread::yield();
+
+                    output.feed(" hand\x1B[201~");
+                });
+            };
+
+            std::thread first(session, 0);
+            std::thread second(session, 1);
+            first.join();
+            second.join();
+
+            ASSERT_EQ(std::string("right hand"), pasted[0]);
+            ASSERT_EQ(std::string("left hand"), pasted[1]);
+        }
+
+        static void test_canvases_animate_per_context() {
+            using namespace GGUI;
+
+            INTERNAL::context session;
+            bool registered = false;
+            bool released = false;
+
+            std::thread([&]() {
+                INTERNAL::currentContext = &session;
+
+                renderedCanvas* animated = new renderedCanvas(width(2) | height(1), true);
+                animated->render();
+                animated->set(0, 0, sprite({UTF('a'), UTF('b')}), false);
+
+                registered = session.multiFrameCanvas.count(animated) == 1;
+
+                delete animated;
+                released = session.multiFrameCanvas.empty();
+            }).join();
+
+            ASSERT_TRUE(registered);
+            ASSERT_TRUE(released);
+            ASSERT_TRUE(INTERNAL::defaultContext.multiFrameCanvas.empty());
+        }
+
+        static void test_holds_are_per_context() {
+            using namespace GGUI;
+
+            INTERNAL::context first;
+            INTERNAL::context second;
+            first.ticket.initialize();
+            second.ticket.initialize();
+
+            INTERNAL::currentContext = &first;
+            pauseGGUI();
+
+            // A shared ticket would defer this frame until the hold above is released.
+            INTERNAL::currentContext = &second;
+            updateFrame();
+            bool requested = second.ticket.getStatus() == INTERNAL::atomic::status::REQUESTING_RENDERING;
+
+            INTERNAL::currentContext = &first;
+            resumeGGUI();
+            INTERNAL::currentContext = &INTERNAL::defaultContext;
+
+            ASSERT_TRUE(requested);
+            ASSERT_EQ(0u, first.ticket.getHolds());
+        }
+    };
+}
+
+#endif
@@ -29,6 +29,9 @@ namespace tester {
             // add_test("fitting_dimensions_basic", "getFittingDimensions base cases", test_fitting_dimensions_basic);
             add_test("reorder_childs_z", "reOrderChilds sorts by Z", test_reorder_childs_z);
             add_test("mouse_on_hover", "Mouse hover detection and onHover callback", test_mouse_on_hover);
+            add_test("overlapping_hover_once", "Overlapping hoverables only stain the one which ends up hovered", test_overlapping_hover_once);
+            add_test("on_click_outlives_style", "onClick keeps the callback it was embedded with after its style object changes", test_on_click_outlives_style);
+            add_test("copy_and_re_embed_styles", "Copies of styled elements embed their own styles, before and after the original is embedded", test_copy_and_re_embed_styles);
         }
     private:
         // Helper: access STRETCH flag quickly
@@ -237,34 +240,149 @@ namespace tester {
                 true
             );
 
-            INTERNAL::mouse = {0, 0};                   // Let's test it on all four corners
+            INTERNAL::currentContext->mouse = {0, 0};   // Let's test it on all four corners
             INTERNAL::eventHandler();                   // run pipeline 
             ASSERT_TRUE(hoverable.isHovered());         // now let's see if the hoverable has onHover enabled
 
-            INTERNAL::mouse = {w + 1, h + 1};           // Let's move the mouse outside the perimeter to disable hover
+            INTERNAL::currentContext->mouse = {w + 1, h + 1}; // Let's move the mouse outside the perimeter to disable hover
             INTERNAL::eventHandler();
             ASSERT_FALSE(hoverable.isHovered());        // now let's see if the hoverable has onHover disabled
             
-            INTERNAL::mouse = {w - 1, 0};               // now let's try top right corner next
+            INTERNAL::currentContext->mouse = {w - 1, 0}; // now let's try top right corner next
             INTERNAL::eventHandler();                   // run pipeline
             ASSERT_TRUE(hoverable.isHovered());         // now let's see if the hoverable has onHover enabled
 
-            INTERNAL::mouse = {w + 1, h + 1};           // now clear hover
+            INTERNAL::currentContext->mouse = {w + 1, h + 1}; // now clear hover
             INTERNAL::eventHandler();                   // run pipeline
             ASSERT_FALSE(hoverable.isHovered());        // now let's see if the hoverable has onHover disabled
 
-            INTERNAL::mouse = {0, h - 1};               // now let's try bottom left corner next
+            INTERNAL::currentContext->mouse = {0, h - 1}; // now let's try bottom left corner next
             INTERNAL::eventHandler();                   // run pipeline
             ASSERT_TRUE(hoverable.isHovered());         // now let's see if the hoverable has
 
-            INTERNAL::mouse = {w + 1, h + 1};           // now clear hover
+            INTERNAL::currentContext->mouse = {w + 1, h + 1}; // now clear hover
             INTERNAL::eventHandler();                   // run pipeline
             ASSERT_FALSE(hoverable.isHovered());        // now let's see if the hoverable has
 
-            INTERNAL::mouse = {w - 1, h - 1};           // now let's try bottom right corner next
+            INTERNAL::currentContext->mouse = {w - 1, h - 1}; // now let's try bottom right corner next
             INTERNAL::eventHandler();                   // run pipeline
             ASSERT_TRUE(hoverable.isHovered());         // now let's see if the hoverable has
         }
+
+        static void test_overlapping_hover_once() {
+            using namespace GGUI;
+
+            auto clickable = onClick([](element*){
+                return true;
+            });
+
+            element below(width(10) | height(10) | clickable, true);
+            element above(width(10) | height(10) | clickable, true);
+
+            INTERNAL::currentContext->mouse = {20, 20}; // Start outside of both
+            INTERNAL::eventHandler();
+
+            below.getDirty().Clean(INTERNAL::STAIN_TYPE::COLOR);
+
+            INTERNAL::currentContext->mouse = {1, 1};   // Both overlap with the mouse, the later registered one is on top
+            INTERNAL::eventHandler();
+
+            ASSERT_TRUE(above.isHovered());
+            ASSERT_FALSE(below.isHovered());
+            ASSERT_FALSE(below.getDirty().is(INTERNAL::STAIN_TYPE::COLOR));    // Never hovered on the way
+
+            INTERNAL::currentContext->mouse = {20, 20}; // clear hover
+            INTERNAL::eventHandler();
+            ASSERT_FALSE(above.isHovered());
+        }
+
+        static void test_on_click_outlives_style() {
+            using namespace GGUI;
+
+            static int embeddedClicks = 0;
+            static int laterClicks = 0;
+
+            onClick handler([](element*){
+                embeddedClicks++;
+                return true;
+            });
+
+            element clickable(width(10) | height(10) | handler, true);
+
+            // The style objects are usually temporaries, whatever is left of them after embedding is not to be called.
+            handler.value = [](element*){
+                laterClicks++;
+                return true;
+            };
+
+            INTERNAL::currentContext->mouse = {1, 1};
+            INTERNAL::eventHandler();
+            ASSERT_TRUE(clickable.isHovered());
+
+            // The first click focuses, the second one is handled.
+            for (int i = 0; i < 2; i++) {
+                INTERNAL::currentContext->inputs.push_back(new input(0, constants::MOUSE_LEFT_CLICKED));
+                INTERNAL::eventHandler();
+            }
+
+            ASSERT_EQ(1, embeddedClicks);
+            ASSERT_EQ(0, laterClicks);
+
+            INTERNAL::currentContext->mouse = {20, 20}; // clear hover
+            INTERNAL::eventHandler();
+        }
+
+        static void test_copy_and_re_embed_styles() {
+            using namespace GGUI;
+
+            static int clicks = 0;
+
+            element parent(width(20) | height(10), true);
+
+            // Not embedded yet, so the styles are kept as a deep copy until then.
+            element* original = new element(width(4) | height(2) | backgroundColor(COLOR::RED) | onClick([](element*){
+                clicks++;
+                return true;
+            }), false);
+
+            element* earlyCopy = original->copy();
+            parent.addChild(original);
+            parent.addChild(earlyCopy);
+
+            // The original is embedded by now, and its styles released.
+            element* lateCopy = original->copy();
+            parent.addChild(lateCopy);
+
+            for (element* styled : { original, earlyCopy, lateCopy }) {
+                ASSERT_EQ(4, styled->getWidth());
+                ASSERT_EQ(2, styled->getHeight());
+                ASSERT_EQ(COLOR::RED, styled->getBackgroundColor());
+
+                // Nothing is left to embed, the style is only the styling itself.
+                INTERNAL::MEMORY_USAGE::elementUsage usage;
+                styled->accountMemory(usage);
+                ASSERT_EQ(sizeof(styling), usage.style);
+            }
+
+            // The early copy embedded its click handler from its own styles, which are released by now. The late copy copied the
+            // handlers of the original, which still refer to it, so both go before the original.
+            parent.remove(lateCopy);
+            parent.remove(original);
+
+            INTERNAL::currentContext->mouse = {1, 1};
+            INTERNAL::eventHandler();
+            ASSERT_TRUE(earlyCopy->isHovered());
+
+            for (int i = 0; i < 2; i++) {
+                INTERNAL::currentContext->inputs.push_back(new input(0, constants::MOUSE_LEFT_CLICKED));
+                INTERNAL::eventHandler();
+            }
+
+            ASSERT_EQ(1, clicks);
+
+            INTERNAL::currentContext->mouse = {30, 30}; // clear hover
+            INTERNAL::eventHandler();
+        }
     };
 }
 
@@ -0,0 +1,160 @@
+#ifndef _EVENT_LOOP_SUITE_H_
+#define _EVENT_LOOP_SUITE_H_
+
+// The event loop only runs on Linux.
+#if defined(__linux__)
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+#include <chrono>
+
+// Waking the event loop from other threads and firing the timed work from its timer.
+
+namespace tester {
+    class eventLoopSuite : public utils::TestSuite {
+    public:
+        eventLoopSuite() : utils::TestSuite("Event loop") {
+            add_test("wake_returns_dispatch", "A wake from another thread returns a dispatch which would wait for seconds", test_wake_returns_dispatch);
+            add_test("memory_deadline_fires_timer", "A memory runs when the timer armed to its deadline fires", test_memory_deadline_fires_timer);
+            add_test("tick_runs_memories_and_frames", "tick() runs a due memory and renders its frame, a pending frame makes the deadline 0", test_tick_runs_memories_and_frames);
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        // Runs the steps in cooperative mode on a headless scene, so that the due tasks run without a rendering thread to pause.
+        // The loop is set up on the thread of the scene, so that the signals it takes over stay unblocked for the tester itself.
+        static void onLoop(const std::function<void(GGUI::element* main, GGUI::INTERNAL::headlessBackend& output)>& steps, bool& initialized) {
+            using namespace GGUI;
+
+            utils::onHeadlessScene(10, 3, [&](element* main, INTERNAL::headlessBackend& output) {
+                bool cooperative = INTERNAL::cooperativeMode;
+                INTERNAL::cooperativeMode = true;
+
+                initialized = INTERNAL::EVENT_LOOP::init(false);
+
+                if (initialized) {
+                    // Whatever earlier suites left for the loop.
+                    INTERNAL::EVENT_LOOP::dispatch(0);
+                    steps(main, output);
+                }
+
+                INTERNAL::cooperativeMode = cooperative;
+            });
+        }
+
+        static void test_wake_returns_dispatch() {
+            using namespace GGUI::INTERNAL;
+
+            bool initialized = false;
+            bool dispatched = false;
+            clock::duration waited = clock::duration::max();
+
+            onLoop([&](GGUI::element*, headlessBackend&) {
+                std::thread waker([]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    EVENT_LOOP::wake();
+                });
+
+                auto start = clock::now();
+                dispatched = EVENT_LOOP::dispatch(5000);
+                waited = clock::now() - start;
+
+                waker.join();
+            }, initialized);
+
+            ASSERT_TRUE(initialized);
+            ASSERT_TRUE(dispatched);
+
+            // Slept until the wake, and not a moment longer than needed.
+            ASSERT_TRUE(waited >= std::chrono::milliseconds(15));
+            ASSERT_TRUE(waited < std::chrono::seconds(2));
+        }
+
+        static void test_memory_deadline_fires_timer() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            bool initialized = false;
+            bool fired = false;
+            long long armedTo = -1;
+            clock::duration waited = clock::duration::max();
+
+            onLoop([&](element*, headlessBackend&) {
+                addMemory(memory(30, [&fired](event*) {
+                    fired = true;
+                    return true;
+                }));
+
+                armedTo = EVENT_LOOP::nextDeadline();
+
+                // The first dispatch only takes the wake of addMemory() and arms the timer, the timer is then the only thing to wake up for.
+                auto start = clock::now();
+                for (int i = 0; i < 4 && !fired; i++)
+                    EVENT_LOOP::dispatch(5000);
+                waited = clock::now() - start;
+            }, initialized);
+
+            ASSERT_TRUE(initialized);
+            ASSERT_TRUE(armedTo > 0 && armedTo <= 31);
+            ASSERT_TRUE(fired);
+            ASSERT_TRUE(waited >= std::chrono::milliseconds(25));
+            ASSERT_TRUE(waited < std::chrono::seconds(2));
+        }
+
+        static void test_tick_runs_memories_and_frames() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            bool initialized = false;
+            bool fired = false;
+            bool sameHandle = false;
+            long long scheduled = -1, pending = -1, rendered = 0;
+            size_t framesBefore = 0, framesAfter = 0;
+
+            onLoop([&](element* main, headlessBackend& output) {
+                // Frames are only requested once initialized, like initGGUI() does. It stays so for the suites after this one.
+                currentContext->ticket.initialize();
+                main->setBackgroundColor(COLOR::GREEN);
+                utils::renderOneFrame();
+                framesBefore = output.getFrameCount();
+
+                sameHandle = getEventHandle() == EVENT_LOOP::getHandle() && getEventHandle() >= 0;
+
+                addMemory(memory(20, [&fired, main](event*) {
+                    fired = true;
+                    main->setBackgroundColor(COLOR::RED);
+                    return true;
+                }));
+
+                scheduled = getNextDeadline();
+
+                for (int i = 0; i < 4 && !fired; i++)
+                    tick(1000);
+
+                // The frame requested by the memory is rendered by the same tick() which ran it.
+                framesAfter = output.getFrameCount();
+
+                main->setBackgroundColor(COLOR::BLUE);
+                pending = getNextDeadline();
+
+                tick(0);
+                rendered = getNextDeadline();
+            }, initialized);
+
+            ASSERT_TRUE(initialized);
+            ASSERT_TRUE(sameHandle);
+            ASSERT_TRUE(scheduled > 0 && scheduled <= 21);
+            ASSERT_TRUE(fired);
+            ASSERT_EQ(framesBefore + 1, framesAfter);
+            ASSERT_EQ(0LL, pending);
+            ASSERT_NE(0LL, rendered);
+        }
+    };
+}
+
+#endif
+
+#endif
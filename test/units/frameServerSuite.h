@@ -0,0 +1,136 @@
+#ifndef _FRAME_SERVER_SUITE_H_
+#define _FRAME_SERVER_SUITE_H_
+
+// The frame server only runs on Linux.
+#if defined(__linux__)
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Streaming the published frames to subscribers over a Unix domain socket.
+
+namespace tester {
+    class frameServerSuite : public utils::TestSuite {
+    public:
+        frameServerSuite() : utils::TestSuite("Frame server") {
+            add_test("keyframe_then_changes", "A subscriber gets the whole frame first and then only the changed cells", test_keyframe_then_changes);
+            add_test("lagging_subscriber_skips_ahead", "A subscriber which falls out of the ring is given a keyframe instead of the backlog", test_lagging_subscriber_skips_ahead);
+        }
+
+    private:
+        static std::string socketPath() {
+            return "/tmp/ggui_frameServerSuite_" + std::to_string(getpid()) + ".sock";
+        }
+
+        static int subscribe() {
+            int handle = socket(AF_UNIX, SOCK_STREAM, 0);
+
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::string path = socketPath();
+            path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+            if (connect(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                close(handle);
+                return -1;
+            }
+
+            // Wait until the server has accepted us, so that the next publish counts us in.
+            for (int i = 0; i < 100 && GGUI::INTERNAL::FRAME_SERVER::getStats().subscribers == 0; i++)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+            return handle;
+        }
+
+        // Reads until nothing arrives for a while.
+        static std::string receive(int handle) {
+            std::string result;
+            char buffer[65536];
+            pollfd wait{ handle, POLLIN, 0 };
+
+            while (poll(&wait, 1, 200) > 0) {
+                ssize_t length = read(handle, buffer, sizeof(buffer));
+                if (length <= 0)
+                    break;
+                result.append(buffer, length);
+            }
+
+            return result;
+        }
+
+        static size_t occurrences(const std::string& text, const std::string& part) {
+            size_t count = 0;
+            for (size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + part.size()))
+                count++;
+            return count;
+        }
+
+        static void test_keyframe_then_changes() {
+            using namespace GGUI;
+
+            ASSERT_TRUE(INTERNAL::FRAME_SERVER::start(socketPath()));
+            int handle = subscribe();
+            ASSERT_TRUE(handle >= 0);
+
+            std::vector<UTF> cells(4 * 2, UTF('a', { COLOR::WHITE, COLOR::BLACK }));
+            INTERNAL::FRAME_SERVER::publish(cells, 4, 2, "first");
+
+            ASSERT_EQ(std::string("\x1B[2J\x1B[Hfirst"), receive(handle));
+
+            cells[1 * 4 + 2] = UTF('b', { COLOR::WHITE, COLOR::BLACK });
+            INTERNAL::FRAME_SERVER::publish(cells, 4, 2, "second");
+
+            std::string changes = receive(handle);
+            ASSERT_EQ((size_t)0, changes.find("\x1B[2;3H"));
+            ASSERT_TRUE(changes.find('b') != std::string::npos);
+            ASSERT_TRUE(changes.find('a') == std::string::npos);
+
+            close(handle);
+            INTERNAL::FRAME_SERVER::stop();
+        }
+
+        static void test_lagging_subscriber_skips_ahead() {
+            using namespace GGUI;
+
+            ASSERT_TRUE(INTERNAL::FRAME_SERVER::start(socketPath()));
+            int handle = subscribe();
+            ASSERT_TRUE(handle >= 0);
+
+            INTERNAL::FRAME_SERVER::serverStats before = INTERNAL::FRAME_SERVER::getStats();
+
+            // Every frame changes every cell, so the changes are far larger than the socket buffer of the subscriber which is not reading.
+            constexpr unsigned int width = 100, height = 50;
+            constexpr unsigned int frames = INTERNAL::FRAME_SERVER::ringSize * 2;
+            std::vector<UTF> cells(width * height);
+
+            for (unsigned int frame = 0; frame < frames; frame++) {
+                for (UTF& cell : cells)
+                    cell = UTF('x', { COLOR::WHITE, frame % 2 ? COLOR::RED : COLOR::BLUE });
+
+                INTERNAL::FRAME_SERVER::publish(cells, width, height, "keyframe");
+            }
+
+            std::string received = receive(handle);
+            INTERNAL::FRAME_SERVER::serverStats after = INTERNAL::FRAME_SERVER::getStats();
+
+            // The first keyframe and at least one more once the subscriber fell behind, with far less than all the changes sent.
+            ASSERT_TRUE(occurrences(received, "\x1B[2J\x1B[Hkeyframe") >= 2);
+            ASSERT_EQ((size_t)frames, after.published - before.published);
+            ASSERT_TRUE(after.diffsSent - before.diffsSent < frames - 1);
+            ASSERT_TRUE(after.bytesSent - before.bytesSent < after.bytesEncoded - before.bytesEncoded);
+
+            close(handle);
+            INTERNAL::FRAME_SERVER::stop();
+        }
+    };
+}
+
+#endif
+
+#endif
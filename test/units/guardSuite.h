@@ -0,0 +1,88 @@
+#ifndef _GUARD_SUITE_H_
+#define _GUARD_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// The shared reads of atomic::guard and its contention counters.
+
+namespace tester {
+    class guardSuite : public utils::TestSuite {
+    public:
+        guardSuite() : utils::TestSuite("Guarded data") {
+            add_test("readers_share_the_lock", "Concurrent read() jobs run at the same time instead of one after another", test_readers_share_the_lock);
+            add_test("held_writer_is_counted", "Waiting for a held writer lock is counted as contended, with the time waited", test_held_writer_is_counted);
+        }
+
+    private:
+        static void test_readers_share_the_lock() {
+            using namespace GGUI::INTERNAL;
+
+            atomic::guard<int> data;
+            std::atomic<int> inside = 0;
+            bool met[2] = {};
+
+            // Each reader waits inside its job for the other one, which only arrives if the lock is shared.
+            auto reader = [&data, &inside, &met](int index) {
+                data.read([&inside, &met, index](const int&) {
+                    inside++;
+
+                    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+                    while (inside < 2 && std::chrono::steady_clock::now() < deadline)
+                        std::this_thread::yield();
+
+                    met[index] = inside == 2;
+                });
+            };
+
+            std::thread first(reader, 0);
+            std::thread second(reader, 1);
+            first.join();
+            second.join();
+
+            ASSERT_TRUE(met[0] && met[1]);
+            ASSERT_EQ(2ULL, data.getContention().acquisitions);
+        }
+
+        static void test_held_writer_is_counted() {
+            using namespace GGUI::INTERNAL;
+
+            atomic::guard<int> data;
+            std::atomic<bool> holding = false;
+
+            atomic::contention before = data.getContention();
+
+            std::thread writer([&data, &holding]() {
+                data([&holding](int& value) {
+                    holding = true;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    value = 1;
+                });
+            });
+
+            while (!holding)
+                std::this_thread::yield();
+
+            int seen = 0;
+            data.read([&seen](const int& value) {
+                seen = value;
+            });
+
+            writer.join();
+
+            atomic::contention after = data.getContention();
+
+            // The reader waited for the writer to finish.
+            ASSERT_EQ(1, seen);
+            ASSERT_EQ(before.acquisitions + 2, after.acquisitions);
+            ASSERT_EQ(before.contended + 1, after.contended);
+            ASSERT_TRUE(after.waitNanoseconds - before.waitNanoseconds >= 10'000'000ULL);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef _HANDLER_POOL_SUITE_H_
+#define _HANDLER_POOL_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <atomic>
+#include <thread>
+
+// Async event handlers run on the worker pool, and the execution time accounting of all handlers.
+
+namespace tester {
+    class handlerPoolSuite : public utils::TestSuite {
+    public:
+        handlerPoolSuite() : utils::TestSuite("Async handler pool") {
+            add_test("async_handler_posts_mutations", "An async handler runs off the calling thread and its pauseGGUI(f) is applied with the posted commands", test_async_handler_posts_mutations);
+            add_test("direct_changes_are_reported", "Element changes an async handler makes outside of pauseGGUI(f) are counted, the posted ones are not", test_direct_changes_are_reported);
+            add_test("slow_handlers_are_flagged", "Calls over SETTINGS::handlerBudget are counted per handler", test_slow_handlers_are_flagged);
+            add_test("destroy_waits_for_running_job", "Destroying an element waits for its running async handler", test_destroy_waits_for_running_job);
+        }
+
+    private:
+        static void test_async_handler_posts_mutations() {
+            using namespace GGUI;
+
+            element host;
+            std::thread::id ranOn;
+            bool applied = false;
+
+            host.on(constants::ENTER, [&ranOn, &applied](event* e) {
+                ranOn = std::this_thread::get_id();
+
+                // The copy of the input is still intact, even though the original is gone by now.
+                bool intact = static_cast<input*>(e)->data == 'x';
+
+                pauseGGUI([&applied]() { applied = true; });
+                return intact;
+            }, true, true);
+
+            input original('x', constants::ENTER);
+            ASSERT_TRUE(host.getEventHandlers().back()->async);
+            ASSERT_TRUE(host.getEventHandlers().back()->Job(&original));
+            original.data = 0;
+
+            INTERNAL::HANDLER_POOL::waitIdle();
+
+            ASSERT_TRUE(ranOn != std::this_thread::get_id());
+            ASSERT_FALSE(applied);
+
+            INTERNAL::applyCommands();
+            ASSERT_TRUE(applied);
+        }
+
+        static void test_direct_changes_are_reported() {
+            using namespace GGUI;
+
+            element host;
+            host.setName("handlerPoolSuite::direct");
+
+            host.on(constants::ENTER, [&host](event*) {
+                host.setBackgroundColor(COLOR::RED);
+                host.setBackgroundColor(COLOR::BLUE);
+
+                pauseGGUI([&host]() { host.setBackgroundColor(COLOR::GREEN); });
+                return true;
+            }, true, true);
+
+            input in('\n', constants::ENTER);
+            ASSERT_TRUE(host.getEventHandlers().back()->Job(&in));
+
+            INTERNAL::HANDLER_POOL::waitIdle();
+            INTERNAL::applyCommands();
+            ASSERT_TRUE(host.getBackgroundColor() == COLOR::GREEN);
+
+            std::string id = host.getEventHandlers().back()->ID;
+            size_t found = 0;
+
+            for (auto& stats : INTERNAL::HANDLER_POOL::getStats()) {
+                if (stats.id == id) {
+                    ASSERT_EQ((size_t)2, stats.directChanges);
+                    found++;
+                }
+            }
+
+            ASSERT_EQ((size_t)1, found);
+        }
+
+        static void test_slow_handlers_are_flagged() {
+            using namespace GGUI;
+
+            unsigned long long previousBudget = SETTINGS::handlerBudget;
+            SETTINGS::handlerBudget = 1;
+
+            INTERNAL::HANDLER_POOL::record("handlerPoolSuite::slow", std::chrono::milliseconds(5), false);
+            INTERNAL::HANDLER_POOL::record("handlerPoolSuite::slow", std::chrono::milliseconds(3), false);
+            INTERNAL::HANDLER_POOL::record("handlerPoolSuite::fast", std::chrono::microseconds(10), false);
+
+            SETTINGS::handlerBudget = previousBudget;
+
+            size_t found = 0;
+            for (auto& stats : INTERNAL::HANDLER_POOL::getStats()) {
+                if (stats.id == "handlerPoolSuite::slow") {
+                    ASSERT_EQ((size_t)2, stats.calls);
+                    ASSERT_EQ((size_t)2, stats.overBudget);
+                    ASSERT_EQ(5000ULL, stats.maxMicroseconds);
+                    ASSERT_EQ(8000ULL, stats.totalMicroseconds);
+                    found++;
+                }
+                else if (stats.id == "handlerPoolSuite::fast") {
+                    ASSERT_EQ((size_t)0, stats.overBudget);
+                    found++;
+                }
+            }
+
+            ASSERT_EQ((size_t)2, found);
+        }
+
+        static void test_destroy_waits_for_running_job() {
+            using namespace GGUI;
+
+            element* host = new element();
+            std::atomic<bool> started = false;
+            std::atomic<bool> finished = false;
+
+            host->on(constants::ENTER, [&started, &finished](event*) {
+                started = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                finished = true;
+                return true;
+            }, true, true);
+
+            input in('\n', constants::ENTER);
+            host->getEventHandlers().back()->Job(&in);
+
+            while (!started)
+                std::this_thread::yield();
+
+            delete host;
+            ASSERT_TRUE(finished);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef _MEMORY_SUITE_H_
+#define _MEMORY_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// Smart memory scheduler ordering, deduplication and handles.
+
+namespace tester {
+    class memorySuite : public utils::TestSuite {
+    public:
+        memorySuite() : utils::TestSuite("Memory scheduler") {
+            add_test("due_in_deadline_order", "Only the memories past their deadline are taken out, closest first", test_due_in_deadline_order);
+            add_test("prolong_deduplicates_by_id", "Adding a PROLONG_MEMORY memory with a live ID restarts the existing one", test_prolong_deduplicates_by_id);
+            add_test("stale_handles_do_nothing", "Forgotten handles stay invalid after their slot is reused", test_stale_handles_do_nothing);
+            add_test("recall_retriggers_and_releases", "recallMemories reschedules RETRIGGER memories and drops successful ones", test_recall_retriggers_and_releases);
+        }
+
+    private:
+        using clock = std::chrono::high_resolution_clock;
+
+        static GGUI::memory at(clock::time_point start, size_t end, std::string id, unsigned char flags = 0x0) {
+            GGUI::memory result(end, [](GGUI::event*){ return true; }, flags, id);
+            result.startTime = start;
+            return result;
+        }
+
+        static void test_due_in_deadline_order() {
+            using namespace GGUI;
+
+            INTERNAL::memoryScheduler scheduler;
+            clock::time_point start = clock::now();
+
+            scheduler.add(at(start, 300, "late"));
+            scheduler.add(at(start, 100, "first"));
+            scheduler.add(at(start, 200, "second"));
+
+            clock::time_point deadline;
+            ASSERT_TRUE(scheduler.nextDeadline(deadline));
+            ASSERT_TRUE(deadline == start + std::chrono::milliseconds(100));
+
+            std::vector<std::pair<memoryHandle, memory>> due;
+            scheduler.takeDue(start + std::chrono::milliseconds(250), due);
+
+            ASSERT_EQ((size_t)2, due.size());
+            ASSERT_EQ(std::string("first"), due[0].second.ID);
+            ASSERT_EQ(std::string("second"), due[1].second.ID);
+            ASSERT_EQ((size_t)1, scheduler.size());
+        }
+
+        static void test_prolong_deduplicates_by_id() {
+            using namespace GGUI;
+
+            INTERNAL::memoryScheduler scheduler;
+            clock::time_point start = clock::now();
+
+            memoryHandle firstHandle = scheduler.add(at(start, 100, "clear", MEMORY_FLAGS::PROLONG_MEMORY));
+            memoryHandle secondHandle = scheduler.add(at(start + std::chrono::milliseconds(50), 100, "clear", MEMORY_FLAGS::PROLONG_MEMORY));
+
+            ASSERT_EQ(firstHandle, secondHandle);
+            ASSERT_EQ((size_t)1, scheduler.size());
+
+            clock::time_point deadline;
+            ASSERT_TRUE(scheduler.nextDeadline(deadline));
+            ASSERT_TRUE(deadline == start + std::chrono::milliseconds(150));
+        }
+
+        static void test_stale_handles_do_nothing() {
+            using namespace GGUI;
+
+            INTERNAL::memoryScheduler scheduler;
+            clock::time_point start = clock::now();
+
+            memoryHandle forgotten = scheduler.add(at(start, 100, "a"));
+            ASSERT_TRUE(scheduler.forget(forgotten));
+            ASSERT_FALSE(scheduler.forget(forgotten));
+
+            // Reuses the slot of the forgotten memory.
+            memoryHandle reused = scheduler.add(at(start, 100, "b"));
+
+            ASSERT_NE(forgotten, reused);
+            ASSERT_FALSE(scheduler.contains(forgotten));
+            ASSERT_FALSE(scheduler.retrigger(forgotten));
+            ASSERT_TRUE(scheduler.retrigger(reused));
+
+            std::vector<std::pair<memoryHandle, memory>> due;
+            scheduler.takeDue(start, due);
+
+            ASSERT_EQ((size_t)1, due.size());
+            ASSERT_EQ(std::string("b"), due[0].second.ID);
+        }
+
+        static void test_recall_retriggers_and_releases() {
+            using namespace GGUI;
+
+            int retriggerRuns = 0;
+            int onceRuns = 0;
+
+            memoryHandle retrigger = addMemory(memory(0, [&retriggerRuns](event*){ retriggerRuns++; return true; }, MEMORY_FLAGS::RETRIGGER, "retrigger"));
+            memoryHandle once = addMemory(memory(0, [&onceRuns](event*){ onceRuns++; return true; }, 0x0, "once"));
+
+            ASSERT_TRUE(retriggerMemory(retrigger));
+            ASSERT_TRUE(retriggerMemory(once));
+
+            INTERNAL::recallMemories();
+
+            ASSERT_EQ(1, retriggerRuns);
+            ASSERT_EQ(1, onceRuns);
+            ASSERT_FALSE(prolongMemory(once));
+            ASSERT_TRUE(prolongMemory(retrigger));
+
+            ASSERT_TRUE(forgetMemory(retrigger));
+            ASSERT_FALSE(forgetMemory(retrigger));
+        }
+    };
+}
+
+#endif
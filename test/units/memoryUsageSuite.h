@@ -0,0 +1,125 @@
+#ifndef _MEMORY_USAGE_SUITE_H_
+#define _MEMORY_USAGE_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <algorithm>
+
+// Accounting the bytes held by each element and each subsystem.
+
+namespace tester {
+    class memoryUsageSuite : public utils::TestSuite {
+    public:
+        memoryUsageSuite() : utils::TestSuite("Memory usage") {
+            add_test("elements_are_accounted", "Each element accounts its render buffer, style and content, heaviest first", test_elements_are_accounted);
+            add_test("subsystems_are_accounted", "The subsystems are listed with the elements and names they hold", test_subsystems_are_accounted);
+            add_test("usage_exports_as_json", "The usage is one JSON line with escaped names", test_usage_exports_as_json);
+        }
+
+    private:
+        // Renders one frame of a main element with a text field and an element into the headless backend, then runs the check on it.
+        static void onScene(const std::function<void()>& check) {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            utils::onHeadlessScene(20, 5, [&check](element* main, headlessBackend&) {
+                textField* big = new textField(width(10) | height(2) | name("Big"));
+                element* small = new element(width(4) | height(2) | position(IVector3(12, 0)) | name("Sm\"all"));
+                main->addChild(big);
+                main->addChild(small);
+
+                big->setText(std::string(1000, 'x'));
+                utils::renderOneFrame();
+
+                check();
+            });
+        }
+
+        static const GGUI::INTERNAL::MEMORY_USAGE::elementUsage* find(const std::vector<GGUI::INTERNAL::MEMORY_USAGE::elementUsage>& usages, const std::string& name) {
+            auto found = std::find_if(usages.begin(), usages.end(), [&name](const GGUI::INTERNAL::MEMORY_USAGE::elementUsage& usage) {
+                return usage.name == name;
+            });
+
+            return found == usages.end() ? nullptr : &*found;
+        }
+
+        static void test_elements_are_accounted() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            std::vector<MEMORY_USAGE::elementUsage> usages;
+            std::vector<MEMORY_USAGE::elementUsage> heaviest;
+
+            onScene([&]() {
+                usages = MEMORY_USAGE::top(0);
+                heaviest = MEMORY_USAGE::top(1);
+            });
+
+            ASSERT_EQ((size_t)3, usages.size());
+            ASSERT_EQ((size_t)1, heaviest.size());
+            ASSERT_EQ(usages.front().name, heaviest.front().name);
+
+            for (size_t i = 1; i < usages.size(); i++)
+                ASSERT_TRUE(usages[i - 1].total() >= usages[i].total());
+
+            const MEMORY_USAGE::elementUsage* big = find(usages, "element<Big>");
+            const MEMORY_USAGE::elementUsage* small = find(usages, "element<Sm\"all>");
+            ASSERT_TRUE(big != nullptr);
+            ASSERT_TRUE(small != nullptr);
+
+            ASSERT_TRUE(small->renderBuffer >= 4 * 2 * sizeof(UTF));
+            ASSERT_TRUE(small->object >= sizeof(element));
+            ASSERT_TRUE(small->style >= sizeof(styling));
+            ASSERT_EQ((size_t)0, small->content);
+
+            // The text and its line cache.
+            ASSERT_TRUE(big->content >= 1000);
+        }
+
+        static void test_subsystems_are_accounted() {
+            using namespace GGUI::INTERNAL;
+
+            std::vector<MEMORY_USAGE::subsystemUsage> systems;
+
+            onScene([&]() {
+                systems = MEMORY_USAGE::subsystems();
+            });
+
+            auto named = [&systems](const std::string& name) {
+                return std::find_if(systems.begin(), systems.end(), [&name](const MEMORY_USAGE::subsystemUsage& system) {
+                    return system.name == name;
+                });
+            };
+
+            ASSERT_TRUE(named("elements") != systems.end());
+            ASSERT_EQ((size_t)3, named("elements")->count);
+            ASSERT_TRUE(named("elements")->bytes > 0);
+
+            ASSERT_TRUE(named("names") != systems.end());
+            ASSERT_EQ((size_t)3, named("names")->count);
+
+            ASSERT_TRUE(named("frame") != systems.end());
+            ASSERT_TRUE(named("events") != systems.end());
+            ASSERT_TRUE(named("classes") != systems.end());
+            ASSERT_TRUE(named("logger") != systems.end());
+        }
+
+        static void test_usage_exports_as_json() {
+            using namespace GGUI::INTERNAL;
+
+            std::string json;
+
+            onScene([&]() {
+                json = MEMORY_USAGE::toJSON(MEMORY_USAGE::subsystems(), MEMORY_USAGE::top(0));
+            });
+
+            ASSERT_TRUE(json.rfind("{\"resident\":", 0) == 0);
+            ASSERT_TRUE(json.find("\"elements\":{\"bytes\":") != std::string::npos);
+            ASSERT_TRUE(json.find("{\"name\":\"element<Sm\\\"all>\",\"object\":") != std::string::npos);
+            ASSERT_EQ('}', json.back());
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef _METRICS_SUITE_H_
+#define _METRICS_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// The metrics registry, its log-linear histograms and the frame metrics recorded by the renderer.
+
+namespace tester {
+    class metricsSuite : public utils::TestSuite {
+    public:
+        metricsSuite() : utils::TestSuite("Metrics") {
+            add_test("histogram_buckets_bound_values", "Buckets are exact below 16 and keep larger values within 6.25%", test_histogram_buckets_bound_values);
+            add_test("histogram_percentiles", "Percentiles, minimum, maximum and mean follow the recorded values", test_histogram_percentiles);
+            add_test("counters_in_snapshot", "Counters are read by name from snapshots and their JSON", test_counters_in_snapshot);
+            add_test("frames_are_recorded", "Presented frames record their time and changed cells, identical frames are counted", test_frames_are_recorded);
+            add_test("input_latency_follows_changes", "Only input whose handlers changed the frame records its latency, once the frame is written", test_input_latency_follows_changes);
+            add_test("throwing_command_restores_cause", "A posted command which throws does not leave its input cause to the later frame requests", test_throwing_command_restores_cause);
+        }
+
+    private:
+        static void test_histogram_buckets_bound_values() {
+            using namespace GGUI::INTERNAL::METRICS;
+
+            for (uint64_t value = 0; value < 16; value++)
+                ASSERT_EQ(value, histogram::highestOf(histogram::bucketOf(value)));
+
+            for (uint64_t value = 16; value < (1ULL << 62); value = value * 3 + 7) {
+                uint64_t highest = histogram::highestOf(histogram::bucketOf(value));
+
+                ASSERT_TRUE(highest >= value);
+                ASSERT_TRUE(highest - value <= value / 16);
+            }
+
+            ASSERT_TRUE(histogram::bucketOf(UINT64_MAX) < histogram::bucketCount);
+        }
+
+        static void test_histogram_percentiles() {
+            using namespace GGUI::INTERNAL::METRICS;
+
+            histogram values("cells");
+
+            ASSERT_EQ((uint64_t)0, values.getPercentile(50));
+            ASSERT_EQ((uint64_t)0, values.getMin());
+
+            for (uint64_t value = 1; value <= 1000; value++)
+                values.record(value);
+
+            ASSERT_EQ((uint64_t)1000, values.getCount());
+            ASSERT_EQ((uint64_t)1, values.getMin());
+            ASSERT_EQ((uint64_t)1000, values.getMax());
+            ASSERT_TRUE(values.getMean() > 500 && values.getMean() < 501);
+
+            uint64_t median = values.getPercentile(50);
+            ASSERT_TRUE(median >= 500 && median <= 500 + 500 / 16);
+
+            ASSERT_EQ((uint64_t)1000, values.getPercentile(100));
+            ASSERT_EQ((uint64_t)1, values.getPercentile(0));
+            ASSERT_EQ(std::string("cells"), values.getUnit());
+
+            values.reset();
+            ASSERT_EQ((uint64_t)0, values.getCount());
+            ASSERT_EQ((uint64_t)0, values.getMax());
+        }
+
+        static void test_counters_in_snapshot() {
+            using namespace GGUI::INTERNAL::METRICS;
+
+            counter& tested = getCounter("test.counter");
+            tested.reset();
+            tested.add(3);
+
+            ASSERT_TRUE(&tested == &getCounter("test.counter"));
+
+            histogram& sizes = getHistogram("test.sizes", "bytes");
+            sizes.reset();
+            sizes.record(12);
+
+            snapshot current = takeSnapshot();
+            ASSERT_EQ((uint64_t)3, current.getCounter("test.counter"));
+            ASSERT_EQ((uint64_t)0, current.getCounter("test.missing"));
+            ASSERT_EQ(std::string("bytes"), current.getHistogram("test.sizes").unit);
+            ASSERT_EQ((uint64_t)12, current.getHistogram("test.sizes").p99);
+
+            std::string json = toJSON(current);
+            ASSERT_TRUE(json.find("\"test.counter\":3") != std::string::npos);
+            ASSERT_TRUE(json.find("\"test.sizes\":{\"unit\":\"bytes\",\"count\":1") != std::string::npos);
+            ASSERT_TRUE(json.find('\n') == std::string::npos);
+        }
+
+        static void test_frames_are_recorded() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            METRICS::counter& presented = METRICS::getCounter("frames.presented");
+            METRICS::counter& identical = METRICS::getCounter("frames.identical");
+            METRICS::histogram& cells = METRICS::getHistogram("frame.cellsChanged", "cells");
+            METRICS::histogram& frameTime = METRICS::getHistogram("frame.time");
+
+            utils::onHeadlessScene(10, 3, [](element* main, headlessBackend&) {
+                main->setBackgroundColor(COLOR::BLUE);
+                element* corner = new element(width(2) | height(1) | backgroundColor(COLOR::BLUE));
+                main->addChild(corner);
+
+                // Only the frames of this test are measured.
+                utils::renderOneFrame();
+                METRICS::resetAll();
+
+                main->setBackgroundColor(COLOR::GREEN);
+                utils::renderOneFrame();
+
+                corner->setBackgroundColor(COLOR::RED);
+                utils::renderOneFrame();
+
+                utils::renderOneFrame();
+            });
+
+            ASSERT_EQ((uint64_t)2, presented.get());
+            ASSERT_EQ((uint64_t)1, identical.get());
+            ASSERT_EQ((uint64_t)2, frameTime.getCount());
+
+            // The whole main element, then the corner alone.
+            ASSERT_EQ((uint64_t)2, cells.getCount());
+            ASSERT_EQ((uint64_t)2, cells.getMin());
+            ASSERT_EQ((uint64_t)30, cells.getMax());
+        }
+
+        static void test_input_latency_follows_changes() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            METRICS::histogram& latency = METRICS::getHistogram("input.latency");
+
+            uint64_t recorded[3] = {};
+            bool attributed = false;
+            unsigned long long presenting = 1;
+            unsigned long long causes = 0;
+
+            utils::onHeadlessScene(10, 3, [&](element* main, headlessBackend& output) {
+                main->setBackgroundColor(COLOR::BLUE);
+                main->setFocus(true);
+                main->on(constants::KEY_PRESS, [](event* e) {
+                    // Only the 'c' key changes anything.
+                    if (static_cast<input*>(e)->data == 'c')
+                        currentContext->main->setBackgroundColor(COLOR::RED);
+                    return true;
+                }, true);
+
+                utils::renderOneFrame();
+                latency.reset();
+
+                output.feed("a");
+                utils::renderOneFrame();
+                recorded[0] = latency.getCount();
+
+                output.feed("c");
+                attributed = currentContext->frameCause.id != 0;
+                utils::renderOneFrame();
+                recorded[1] = latency.getCount();
+
+                // Nothing left to attribute to the next frame.
+                utils::renderOneFrame();
+                recorded[2] = latency.getCount();
+
+                presenting = currentContext->presentingCause.id;
+                causes = currentContext->lastCauseId;
+            });
+
+            ASSERT_TRUE(attributed);
+            ASSERT_EQ((unsigned long long)0, presenting);
+            ASSERT_EQ((unsigned long long)2, causes);
+            ASSERT_EQ((uint64_t)0, recorded[0]);
+            ASSERT_EQ((uint64_t)1, recorded[1]);
+            ASSERT_EQ((uint64_t)1, recorded[2]);
+            ASSERT_TRUE(latency.getMax() > 0);
+        }
+
+        static void test_throwing_command_restores_cause() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            unsigned long long during = 0;
+            unsigned long long after = 1;
+
+            utils::onHeadlessScene(10, 3, [&](element*, headlessBackend&) {
+                // Posted from a handler reacting to an input.
+                activeCause.id = 7;
+                post([&during]() {
+                    during = activeCause.id;
+                    throw std::runtime_error("Failing command");
+                });
+                activeCause = inputCause();
+
+                applyCommands();
+                after = activeCause.id;
+            });
+
+            ASSERT_EQ((unsigned long long)7, during);
+            ASSERT_EQ((unsigned long long)0, after);
+        }
+    };
+}
+
+#endif
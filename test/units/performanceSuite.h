@@ -0,0 +1,174 @@
+#ifndef _PERFORMANCE_SUITE_H_
+#define _PERFORMANCE_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+// Budgets on counters which do not depend on the machine: cells changed, cells touched, bytes and allocations per frame,
+// and render calls per dirty element. An algorithmic regression, like a full repaint for a one cell change, fails these.
+
+namespace tester {
+    class performanceSuite : public utils::TestSuite {
+    public:
+        performanceSuite() : utils::TestSuite("Performance budgets") {
+            add_test("panel_change_stays_local", "Recolouring one panel changes and re-renders only the panel and its parent", test_panel_change_stays_local);
+            add_test("text_change_stays_local", "A one cell text change changes one cell and re-renders only its ancestors", test_text_change_stays_local);
+            add_test("unchanged_frame_is_free", "A frame without changes renders nothing and emits nothing", test_unchanged_frame_is_free);
+            add_test("full_change_bytes_per_cell", "Recolouring every panel renders each once and stays within the bytes per cell", test_full_change_bytes_per_cell);
+        }
+
+    private:
+        // The canonical scene, an 80x24 screen of 8x4 bordered panels, with a label in one of them.
+        static constexpr unsigned int screenWidth = 80;
+        static constexpr unsigned int screenHeight = 24;
+        static constexpr unsigned int screenCells = screenWidth * screenHeight;
+        static constexpr unsigned int panelCells = 10 * 6;
+        static constexpr unsigned int panelCount = 8 * 4;
+        static constexpr unsigned int frames = 10;
+
+        // The main element renders its own buffer and nests every child into it, the changed elements render their own on top.
+        static constexpr double mainCellsTouched = 2 * screenCells;
+
+        // The frame is encoded whole, with a colour change only where the colour changes. With the default colours that is
+        // mostly one glyph per cell, with coloured panels the colours switch at each border. A colour per cell would be ~38.
+        static constexpr double plainBytesPerCell = 2.5;
+        static constexpr double colouredBytesPerCell = 8;
+
+        struct counters {
+            uint64_t cellsChanged = 0;      // The most cells changed in a frame.
+            uint64_t bytes = 0;             // The most bytes emitted in a frame.
+            uint64_t presented = 0;         // Frames which emitted anything.
+            uint64_t allocations = 0;       // The most heap allocations in a frame, when counted.
+            double renders = 0;             // render() calls per frame.
+            double dirtyRenders = 0;        // Of which had changes to render, per frame.
+            double cellsTouched = 0;        // Cells re-rendered or nested per frame.
+        };
+
+        // Builds the scene, warms it up with the change and counts the frames which follow it, each after the change of its index.
+        static counters measure(const std::function<void(std::vector<GGUI::element*>& panels, GGUI::textField* label, unsigned int index)>& change) {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            counters result;
+
+            utils::onHeadlessScene(screenWidth, screenHeight, [&](element* main, headlessBackend&) {
+                std::vector<element*> panels;
+                for (unsigned int y = 0; y < 4; y++)
+                    for (unsigned int x = 0; x < 8; x++) {
+                        element* panel = new element(width(10) | height(6) | position(IVector3(x * 10, y * 6)) | enableBorder(true));
+                        main->addChild(panel);
+                        panels.push_back(panel);
+                    }
+
+                textField* label = new textField(width(8) | height(1) | name("Label"));
+                panels[9]->addChild(label);
+                label->setText("00000000");
+
+                // Both states of the change are rendered once, so that every buffer and cache has reached its size.
+                for (unsigned int i = 0; i < 4; i++) {
+                    change(panels, label, i);
+                    utils::renderOneFrame();
+                }
+
+                // The frame metrics first, without the profiler which allocates for its own accounting.
+                METRICS::resetAll();
+
+                for (unsigned int i = 0; i < frames; i++) {
+                    change(panels, label, i);
+                    utils::renderOneFrame();
+                }
+
+                METRICS::snapshot current = METRICS::takeSnapshot();
+                result.cellsChanged = current.getHistogram("frame.cellsChanged").max;
+                result.bytes = current.getHistogram("frame.bytes").max;
+                result.presented = current.getHistogram("frame.bytes").count;
+                result.allocations = current.getHistogram("frame.allocations").max;
+
+                // Then the same frames again for the renders of each element.
+                PROFILER::reset();
+                PROFILER::enable(true);
+
+                for (unsigned int i = 0; i < frames; i++) {
+                    change(panels, label, i);
+                    utils::renderOneFrame();
+                }
+
+                PROFILER::enable(false);
+
+                for (const PROFILER::elementReport& report : PROFILER::top(0)) {
+                    result.renders += (double)report.renders / frames;
+                    result.dirtyRenders += (double)report.dirtyRenders / frames;
+                    result.cellsTouched += report.cellsTouched;
+                }
+
+                PROFILER::reset();
+            });
+
+            return result;
+        }
+
+        static void test_panel_change_stays_local() {
+            counters result = measure([](std::vector<GGUI::element*>& panels, GGUI::textField*, unsigned int index) {
+                panels[0]->setBackgroundColor(index % 2 ? GGUI::COLOR::RED : GGUI::COLOR::BLUE);
+            });
+
+            ASSERT_EQ((uint64_t)frames, result.presented);
+            ASSERT_TRUE(result.cellsChanged <= panelCells);
+            ASSERT_TRUE(result.bytes <= screenCells * plainBytesPerCell);
+            ASSERT_EQ((uint64_t)0, result.allocations);
+
+            // The main element visits each child once, only the panel and the main element have changes.
+            ASSERT_TRUE(result.renders <= 1 + panelCount);
+            ASSERT_TRUE(result.dirtyRenders <= 2);
+            ASSERT_TRUE(result.cellsTouched <= mainCellsTouched + panelCells);
+        }
+
+        static void test_text_change_stays_local() {
+            counters result = measure([](std::vector<GGUI::element*>&, GGUI::textField* label, unsigned int index) {
+                label->setText(index % 2 ? "00000001" : "00000000");
+            });
+
+            ASSERT_EQ((uint64_t)frames, result.presented);
+            ASSERT_TRUE(result.cellsChanged <= 1);
+            ASSERT_TRUE(result.bytes <= screenCells * plainBytesPerCell);
+            ASSERT_EQ((uint64_t)0, result.allocations);
+
+            // The label, its panel and the main element, the label is rendered and nested into the panel.
+            ASSERT_TRUE(result.renders <= 2 + panelCount);
+            ASSERT_TRUE(result.dirtyRenders <= 3);
+            ASSERT_TRUE(result.cellsTouched <= mainCellsTouched + panelCells + 2 * 8);
+        }
+
+        static void test_unchanged_frame_is_free() {
+            counters result = measure([](std::vector<GGUI::element*>&, GGUI::textField*, unsigned int) {});
+
+            ASSERT_EQ((uint64_t)0, result.presented);
+            ASSERT_EQ((uint64_t)0, result.cellsChanged);
+            ASSERT_EQ((uint64_t)0, result.allocations);
+
+            // Only the main element is asked, which finds nothing to do.
+            ASSERT_TRUE(result.renders <= 1);
+            ASSERT_TRUE(result.dirtyRenders == 0);
+            ASSERT_TRUE(result.cellsTouched == 0);
+        }
+
+        static void test_full_change_bytes_per_cell() {
+            counters result = measure([](std::vector<GGUI::element*>& panels, GGUI::textField*, unsigned int index) {
+                for (GGUI::element* panel : panels)
+                    panel->setBackgroundColor(index % 2 ? GGUI::COLOR::RED : GGUI::COLOR::BLUE);
+            });
+
+            ASSERT_EQ((uint64_t)frames, result.presented);
+            ASSERT_EQ((uint64_t)screenCells, result.cellsChanged);
+            ASSERT_TRUE(result.bytes <= screenCells * colouredBytesPerCell);
+            ASSERT_EQ((uint64_t)0, result.allocations);
+
+            // Every element is rendered once per frame, the label stays as it was.
+            ASSERT_TRUE(result.renders <= 2 + panelCount);
+            ASSERT_TRUE(result.renders <= result.dirtyRenders + 1);
+            ASSERT_TRUE(result.cellsTouched <= mainCellsTouched + panelCount * panelCells + 8);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef _PROFILER_SUITE_H_
+#define _PROFILER_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <algorithm>
+
+// Accounting the render cost of each element and listing the costliest.
+
+namespace tester {
+    class profilerSuite : public utils::TestSuite {
+    public:
+        profilerSuite() : utils::TestSuite("Element profiler") {
+            add_test("disabled_renders_are_not_accounted", "Nothing is accounted while the profiler is disabled", test_disabled_renders_are_not_accounted);
+            add_test("renders_are_accounted_per_element", "Renders, dirty renders and touched cells are accounted to each element", test_renders_are_accounted_per_element);
+            add_test("report_exports_as_csv", "The report is CSV with quoted names, destroyed elements are dropped", test_report_exports_as_csv);
+        }
+
+    private:
+        // Renders the frames of a main element with the two children into the headless backend.
+        static void renderFrames(const std::function<void(GGUI::element* changing)>& frames) {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            utils::onHeadlessScene(20, 5, [&frames](element* main, headlessBackend&) {
+                element* changing = new element(width(4) | height(2) | name("Changing"));
+                element* still = new element(width(4) | height(2) | position(IVector3(10, 0)) | name("Still"));
+                main->addChild(changing);
+                main->addChild(still);
+
+                frames(changing);
+            });
+        }
+
+        static const GGUI::INTERNAL::PROFILER::elementReport* find(const std::vector<GGUI::INTERNAL::PROFILER::elementReport>& reports, const std::string& name) {
+            auto found = std::find_if(reports.begin(), reports.end(), [&name](const GGUI::INTERNAL::PROFILER::elementReport& report) {
+                return report.name == name;
+            });
+
+            return found == reports.end() ? nullptr : &*found;
+        }
+
+        static void test_disabled_renders_are_not_accounted() {
+            using namespace GGUI::INTERNAL;
+
+            PROFILER::enable(false);
+            PROFILER::reset();
+
+            size_t reported = 1;
+            renderFrames([&reported](GGUI::element*) {
+                utils::renderOneFrame();
+                reported = PROFILER::top(0).size();
+            });
+
+            ASSERT_EQ((size_t)0, reported);
+        }
+
+        static void test_renders_are_accounted_per_element() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            std::vector<PROFILER::elementReport> reports;
+
+            renderFrames([&reports](element* changing) {
+                utils::renderOneFrame();
+
+                PROFILER::reset();
+                PROFILER::enable(true);
+
+                changing->setBackgroundColor(COLOR::RED);
+                utils::renderOneFrame();
+                changing->setBackgroundColor(COLOR::BLUE);
+                utils::renderOneFrame();
+
+                PROFILER::enable(false);
+                reports = PROFILER::top(0);
+            });
+
+            const PROFILER::elementReport* main = find(reports, "element<Main>");
+            const PROFILER::elementReport* changed = find(reports, "element<Changing>");
+            const PROFILER::elementReport* still = find(reports, "element<Still>");
+
+            ASSERT_TRUE(main && changed && still);
+
+            ASSERT_EQ((unsigned long long)2, changed->renders);
+            ASSERT_EQ((unsigned long long)2, changed->dirtyRenders);
+            ASSERT_EQ((unsigned long long)2, still->renders);
+            ASSERT_EQ((unsigned long long)0, still->dirtyRenders);
+
+            // The main element is dirtied by its changed child, and re-renders its own cells and nests both children.
+            ASSERT_EQ((unsigned long long)2, main->dirtyRenders);
+            ASSERT_TRUE(changed->cellsTouched == 8.0);
+            ASSERT_TRUE(still->cellsTouched == 0.0);
+            ASSERT_TRUE(main->cellsTouched == 100.0 + 8 + 8);
+
+            ASSERT_TRUE(main->renderNanoseconds >= changed->renderNanoseconds + still->renderNanoseconds);
+            ASSERT_TRUE(main->nestNanoseconds > 0);
+        }
+
+        static void test_report_exports_as_csv() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            std::vector<PROFILER::elementReport> reports;
+            size_t afterDelete = 0;
+
+            renderFrames([&](element* changing) {
+                PROFILER::reset();
+                PROFILER::enable(true);
+                utils::renderOneFrame();
+                PROFILER::enable(false);
+
+                reports = PROFILER::top(2);
+
+                currentContext->main->remove(changing);
+                afterDelete = PROFILER::top(0).size();
+            });
+
+            PROFILER::reset();
+
+            ASSERT_EQ((size_t)2, reports.size());
+            ASSERT_EQ((size_t)2, afterDelete);
+
+            reports[0].name = "a \"quoted\", name";
+            std::string csv = PROFILER::toCSV(reports);
+
+            ASSERT_EQ((size_t)0, csv.find("name,renders,dirtyRenders,renderNanoseconds,selfNanoseconds,nestNanoseconds,cellsTouched\n"));
+            ASSERT_TRUE(csv.find("\n\"a \"\"quoted\"\", name\",1,1,") != std::string::npos);
+            ASSERT_EQ((size_t)3, (size_t)std::count(csv.begin(), csv.end(), '\n'));
+        }
+    };
+}
+
+#endif
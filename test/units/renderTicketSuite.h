@@ -0,0 +1,99 @@
+#ifndef _RENDER_TICKET_SUITE_H_
+#define _RENDER_TICKET_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+
+// Handoff of the elements between the rendering thread and the mutating threads.
+
+namespace tester {
+    class renderTicketSuite : public utils::TestSuite {
+    public:
+        renderTicketSuite() : utils::TestSuite("Render ticket") {
+            add_test("request_during_frame_renders_again", "Requests made during a frame are coalesced into one more frame", test_request_during_frame_renders_again);
+            add_test("hold_defers_request", "A pending request waits for the last hold to be released", test_hold_defers_request);
+            add_test("hold_waits_for_ongoing_frame", "The first hold during a frame waits until the frame is finished", test_hold_waits_for_ongoing_frame);
+        }
+
+    private:
+        using status = GGUI::INTERNAL::atomic::status;
+
+        static void test_request_during_frame_renders_again() {
+            GGUI::INTERNAL::atomic::renderTicket ticket;
+
+            ASSERT_FALSE(ticket.request());
+            ticket.initialize();
+
+            ASSERT_TRUE(ticket.request());
+            ASSERT_TRUE(ticket.take());
+
+            // Both ride along with the ongoing frame.
+            ASSERT_FALSE(ticket.request());
+            ASSERT_FALSE(ticket.request());
+
+            ASSERT_TRUE(ticket.finish());
+            ASSERT_TRUE(ticket.getStatus() == status::REQUESTING_RENDERING);
+
+            ASSERT_TRUE(ticket.take());
+            ASSERT_FALSE(ticket.finish());
+            ASSERT_TRUE(ticket.getStatus() == status::PAUSED);
+        }
+
+        static void test_hold_defers_request() {
+            GGUI::INTERNAL::atomic::renderTicket ticket;
+            ticket.initialize();
+
+            ASSERT_TRUE(ticket.request());
+
+            // Nothing is rendering yet, so there is nothing to wait for.
+            ASSERT_FALSE(ticket.hold());
+            ASSERT_FALSE(ticket.hold());
+            ASSERT_TRUE(ticket.getStatus() == status::PAUSED);
+
+            ASSERT_FALSE(ticket.request());
+            ASSERT_FALSE(ticket.take());
+
+            ASSERT_FALSE(ticket.release());
+            ASSERT_TRUE(ticket.release());
+            ASSERT_EQ(0u, ticket.getHolds());
+
+            ASSERT_TRUE(ticket.request());
+            ASSERT_TRUE(ticket.take());
+        }
+
+        static void test_hold_waits_for_ongoing_frame() {
+            GGUI::INTERNAL::atomic::renderTicket ticket;
+            ticket.initialize();
+
+            ticket.request();
+            ASSERT_TRUE(ticket.take());
+
+            std::atomic<bool> frameDone = false;
+            std::atomic<bool> sawFrameDone = false;
+
+            std::thread mutator([&ticket, &frameDone, &sawFrameDone]() {
+                if (ticket.hold()) {
+                    ticket.waitUntil([&ticket]() { return ticket.getStatus() != status::RENDERING; });
+                }
+
+                sawFrameDone = frameDone.load();
+                ticket.release();
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            frameDone = true;
+
+            // The hold came in during the frame, so it must not render again behind the mutator's back.
+            ASSERT_FALSE(ticket.finish());
+
+            mutator.join();
+
+            ASSERT_TRUE(sawFrameDone.load());
+            ASSERT_TRUE(ticket.getStatus() == status::PAUSED);
+        }
+    };
+}
+
+#endif
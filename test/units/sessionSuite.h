@@ -0,0 +1,176 @@
+#ifndef _SESSION_SUITE_H_
+#define _SESSION_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+// Recording the input and resizes of a session and replaying it through the headless backend.
+
+namespace tester {
+    class sessionSuite : public utils::TestSuite {
+    public:
+        sessionSuite() : utils::TestSuite("Session record and replay") {
+            add_test("replay_is_deterministic", "Replaying the same recording twice presents the same frames", test_replay_is_deterministic);
+            add_test("replay_rejects_other_files", "A file without the session header is not replayed", test_replay_rejects_other_files);
+            add_test("replay_runs_timed_memories", "Memories falling due between the recorded events run at their own time in the replay", test_replay_runs_timed_memories);
+        }
+
+    private:
+        // Unique to this run, so that testers running side by side do not replay each other's recordings.
+        static std::string sessionPath() {
+            static const std::string path = (std::filesystem::temp_directory_path() /
+                ("ggui_sessionSuite_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".bin")).string();
+
+            return path;
+        }
+
+        static void record() {
+            using namespace GGUI;
+
+            utils::onHeadlessScene(10, 3, [](element*, INTERNAL::headlessBackend&) {
+                INTERNAL::SESSION::startRecording(sessionPath());
+                INTERNAL::SESSION::recordInput("ab", 2);
+                INTERNAL::SESSION::recordResize(12, 4);
+                INTERNAL::SESSION::recordInput("c", 1);
+                INTERNAL::SESSION::stopRecording();
+            });
+        }
+
+        static void test_replay_is_deterministic() {
+            using namespace GGUI;
+
+            record();
+
+            INTERNAL::SESSION::replayReport reports[2];
+            std::string typed[2];
+            bool replayed[2] = {};
+
+            for (int i = 0; i < 2; i++) {
+                utils::onHeadlessScene(10, 3, [&](element* main, INTERNAL::headlessBackend&) {
+                    main->setBackgroundColor(COLOR::BLUE);
+                    main->setFocus(true);
+                    main->on(constants::KEY_PRESS, [&typed, i](event* e) {
+                        typed[i] += static_cast<input*>(e)->data;
+                        INTERNAL::currentContext->main->setBackgroundColor(typed[i].size() % 2 ? COLOR::RED : COLOR::GREEN);
+                        return true;
+                    }, true);
+
+                    replayed[i] = INTERNAL::SESSION::replay(sessionPath(), reports[i]);
+                });
+            }
+
+            std::remove(sessionPath().c_str());
+
+            #if defined(_WIN32)
+            // The console input is not read as raw bytes, so the recording is refused instead of replayed.
+            ASSERT_FALSE(replayed[0] || replayed[1]);
+            return;
+            #endif
+
+            ASSERT_TRUE(replayed[0] && replayed[1]);
+            ASSERT_EQ(std::string("abc"), typed[0]);
+            ASSERT_EQ(typed[0], typed[1]);
+
+            // The starting frame, one after each of the three records and one at the end of the recording.
+            ASSERT_EQ((size_t)5, reports[0].frames.size());
+            ASSERT_EQ(reports[0].frames.size(), reports[1].frames.size());
+            ASSERT_EQ(reports[0].checksum, reports[1].checksum);
+
+            for (size_t i = 0; i < reports[0].frames.size(); i++) {
+                ASSERT_EQ(reports[0].frames[i].checksum, reports[1].frames[i].checksum);
+                ASSERT_EQ(reports[0].frames[i].bytes, reports[1].frames[i].bytes);
+            }
+
+            // The end of the recording has nothing to change.
+            for (size_t i = 0; i < 4; i++)
+                ASSERT_TRUE(reports[0].frames[i].presented);
+            ASSERT_FALSE(reports[0].frames[4].presented);
+
+            // The resize grew the frame.
+            ASSERT_TRUE(reports[0].frames[2].bytes > reports[0].frames[1].bytes);
+
+            std::string text = INTERNAL::SESSION::formatReport(reports[0]);
+            ASSERT_EQ((size_t)0, text.find("frame\ttime_us\tpresented"));
+            ASSERT_EQ((size_t)6, (size_t)std::count(text.begin(), text.end(), '\n'));
+        }
+
+        static void test_replay_rejects_other_files() {
+            using namespace GGUI;
+
+            std::string path = sessionPath();
+            FILE* file = std::fopen(path.c_str(), "wb");
+            std::fputs("not a session", file);
+            std::fclose(file);
+
+            INTERNAL::SESSION::replayReport report;
+            bool replayed = INTERNAL::SESSION::replay(path, report);
+
+            std::remove(path.c_str());
+
+            ASSERT_FALSE(replayed);
+            ASSERT_FALSE(INTERNAL::SESSION::replay(path, report));
+        }
+
+        static void test_replay_runs_timed_memories() {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            // A key at 10 ms and the end of the recording at 110 ms, on the virtual clock so that the times are exact.
+            utils::onHeadlessScene(10, 3, [](element*, headlessBackend&) {
+                CLOCK::setVirtual(CLOCK::timePoint());
+                SESSION::startRecording(sessionPath());
+                CLOCK::advance(std::chrono::milliseconds(10));
+                SESSION::recordInput("a", 1);
+                CLOCK::advance(std::chrono::milliseconds(100));
+                SESSION::stopRecording();
+                CLOCK::useReal();
+            });
+
+            SESSION::replayReport reports[2];
+            bool replayed[2] = {};
+            unsigned long long firedAt[2] = {};
+
+            for (int i = 0; i < 2; i++) {
+                utils::onHeadlessScene(10, 3, [&](element* main, headlessBackend&) {
+                    main->setBackgroundColor(COLOR::BLUE);
+
+                    // Between the key and the end of the recording, so only a replay which runs the due memories changes the frame.
+                    CLOCK::setVirtual(CLOCK::now());
+                    CLOCK::timePoint start = CLOCK::now();
+                    addMemory(memory(50, [&firedAt, i, main, start](event*) {
+                        firedAt[i] = std::chrono::duration_cast<std::chrono::microseconds>(CLOCK::now() - start).count();
+                        main->setBackgroundColor(COLOR::RED);
+                        return true;
+                    }));
+
+                    replayed[i] = SESSION::replay(sessionPath(), reports[i]);
+                });
+            }
+
+            std::remove(sessionPath().c_str());
+
+            #if defined(_WIN32)
+            ASSERT_FALSE(replayed[0] || replayed[1]);
+            return;
+            #endif
+
+            ASSERT_TRUE(replayed[0] && replayed[1]);
+            ASSERT_TRUE(firedAt[0] >= 50'000 && firedAt[0] < 110'000);
+            ASSERT_EQ(firedAt[0], firedAt[1]);
+            ASSERT_EQ(reports[0].checksum, reports[1].checksum);
+
+            // The starting frame, the key, the memory and the end of the recording, the memory changed the frame at its own time.
+            ASSERT_EQ((size_t)4, reports[0].frames.size());
+            ASSERT_EQ(firedAt[0], reports[0].frames[2].time);
+            ASSERT_TRUE(reports[0].frames[2].presented);
+            ASSERT_NE(reports[0].frames[1].checksum, reports[0].frames[2].checksum);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef _SUBTREE_SUITE_H_
+#define _SUBTREE_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+
+// Subtrees built apart from the live tree and attached into it.
+
+namespace tester {
+    class subtreeSuite : public utils::TestSuite {
+    public:
+        subtreeSuite() : utils::TestSuite("Detached subtree") {
+            add_test("registers_on_attach", "Names of a subtree built on another thread are only registered once attached", test_registers_on_attach);
+            add_test("deleted_element_is_not_registered", "An element deleted while its subtree is built leaves no registration behind", test_deleted_element_is_not_registered);
+            add_test("layout_against_target_size", "Percentages are resolved against the target size before attaching", test_layout_against_target_size);
+        }
+
+    private:
+        static void test_registers_on_attach() {
+            using namespace GGUI;
+
+            std::unique_ptr<subtree> built;
+
+            std::thread builder([&built]() {
+                built = std::make_unique<subtree>([]() {
+                    listView* rows = new listView(flowPriority(DIRECTION::COLUMN) | allowDynamicSize(true));
+
+                    for (int i = 0; i < 50; i++){
+                        element* row = new element(width(4) | height(1));
+                        row->setName("subtreeRow" + std::to_string(i));
+                        rows->addChild(row);
+                    }
+
+                    return rows;
+                }, IVector2(10, 60));
+            });
+            builder.join();
+
+            ASSERT_TRUE(built->getRoot() != nullptr);
+            ASSERT_EQ((size_t)50, built->getRoot()->getChilds().size());
+            ASSERT_TRUE(getElement("subtreeRow7") == nullptr);
+
+            element parent(width(10) | height(60));
+            ASSERT_TRUE(built->attach(&parent));
+            ASSERT_FALSE(built->attach(&parent));
+
+            ASSERT_TRUE(built->getRoot()->getParent() == &parent);
+            ASSERT_TRUE(getElement("subtreeRow7") != nullptr);
+        }
+
+        static void test_deleted_element_is_not_registered() {
+            using namespace GGUI;
+
+            subtree built([]() {
+                element* root = new element(width(10) | height(4));
+
+                element* dropped = new element(width(4) | height(1));
+                dropped->setName("subtreeDropped");
+                root->addChild(dropped);
+                delete dropped;
+
+                return root;
+            }, IVector2(10, 4));
+
+            element parent(width(10) | height(4));
+            ASSERT_TRUE(built.attach(&parent));
+
+            ASSERT_TRUE(built.getRoot()->getChilds().empty());
+            ASSERT_TRUE(getElement("subtreeDropped") == nullptr);
+        }
+
+        static void test_layout_against_target_size() {
+            using namespace GGUI;
+
+            subtree built([]() {
+                return new element(width(0.5f) | height(1.0f));
+            }, IVector2(40, 20));
+
+            ASSERT_EQ(20, built.getRoot()->getWidth());
+            ASSERT_EQ(20, built.getRoot()->getHeight());
+            ASSERT_TRUE(built.getRoot()->getParent() == nullptr);
+        }
+    };
+}
+
+#endif
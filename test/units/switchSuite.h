@@ -24,24 +24,24 @@ namespace tester {
             SB.compile();
 
             // For an element to get onFocus it needs to be hovered upon first:
-            INTERNAL::mouse = {0, 0};            // Let's test it on all four corners
+            INTERNAL::currentContext->mouse = {0, 0}; // Let's test it on all four corners
             INTERNAL::eventHandler();            // run pipeline 
             ASSERT_TRUE(SB.isHovered());         // now let's see if the hoverable has onHover enabled
         
             // Now we can create an click input ourselves and put it into the inputs list and call eventHandler to parse it
-            INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
+            INTERNAL::currentContext->inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
             INTERNAL::eventHandler();            // run pipeline
 
             // Now we can simply check if SB has isFocused enabled
             ASSERT_TRUE(SB.isFocused());
 
             // Now let's send the left click again and see if it changes the switchbox status 
-            INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
+            INTERNAL::currentContext->inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
             INTERNAL::eventHandler();            // run pipeline
             ASSERT_TRUE(SB.isSelected());
 
             // Now we can also test that pressing the switchBox again should disable it
-            INTERNAL::inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
+            INTERNAL::currentContext->inputs.push_back(new GGUI::input(0, constants::MOUSE_LEFT_CLICKED));
             INTERNAL::eventHandler();            // run pipeline
             ASSERT_FALSE(SB.isSelected());
         }
@@ -12,6 +12,8 @@ namespace tester {
         textFieldSuite() : utils::TestSuite("Text field input behaviour") {
             add_test("mouse_focus_typing", "Typing characters through internal inputs updates textField text", test_mouse_focus_typing);
             add_test("backspace_removes_character", "Backspace input removes the trailing character", test_backspace_removes_character);
+            add_test("paste_appends_at_once", "Bracketed paste split over multiple reads arrives as one input and is appended once", test_paste_appends_at_once);
+            add_test("paste_start_split_between_reads", "A paste start marker split between two reads starts the paste instead of being typed", test_paste_start_split_between_reads);
         }
 
     private:
@@ -24,14 +26,14 @@ namespace tester {
         }
 
         static void hoverElement(GGUI::element& el) {
-            GGUI::INTERNAL::mouse = {0, 0, 0};
+            GGUI::INTERNAL::currentContext->mouse = {0, 0, 0};
             GGUI::INTERNAL::eventHandler();
             ASSERT_TRUE(el.isHovered());
         }
 
         static void focusElement(GGUI::element& el) {
             hoverElement(el);
-            GGUI::INTERNAL::inputs.push_back(new GGUI::input(0, GGUI::constants::MOUSE_LEFT_CLICKED));
+            GGUI::INTERNAL::currentContext->inputs.push_back(new GGUI::input(0, GGUI::constants::MOUSE_LEFT_CLICKED));
             GGUI::INTERNAL::eventHandler();
             ASSERT_TRUE(el.isFocused());
         }
@@ -47,7 +49,7 @@ namespace tester {
 
             const std::string typed = "Hi";
             for (char ch : typed) {
-                INTERNAL::inputs.push_back(new input(ch, constants::KEY_PRESS));
+                INTERNAL::currentContext->inputs.push_back(new input(ch, constants::KEY_PRESS));
                 INTERNAL::eventHandler();
             }
 
@@ -65,18 +67,86 @@ namespace tester {
 
             const std::string initial = "OK";
             for (char ch : initial) {
-                INTERNAL::inputs.push_back(new input(ch, constants::KEY_PRESS));
+                INTERNAL::currentContext->inputs.push_back(new input(ch, constants::KEY_PRESS));
                 INTERNAL::eventHandler();
             }
             ASSERT_EQ(initial, field.getText());
 
-            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(true);
-            INTERNAL::inputs.push_back(new input(' ', constants::BACKSPACE));
+            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(true);
+            INTERNAL::currentContext->inputs.push_back(new input(' ', constants::BACKSPACE));
             INTERNAL::eventHandler();
-            INTERNAL::KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(false);
+            INTERNAL::currentContext->KEYBOARD_STATES[KEYBOARD_BUTTONS::BACKSPACE] = INTERNAL::buttonState(false);
 
             ASSERT_EQ(std::string("O"), field.getText());
         }
+
+        static void test_paste_appends_at_once() {
+            using namespace GGUI;
+
+            textField field;
+            field.compile();
+
+            int characterCalls = 0;
+            field.input([&characterCalls](textField*, char) { characterCalls++; });
+
+            focusElement(field);
+
+            // Terminal splits the paste and even the end marker over separate reads.
+            const std::string first = "Hello\r\nwor";
+            const std::string second = "ld\x1B[20";
+            const std::string third = "1~x";
+
+            INTERNAL::currentContext->pasteInProgress = true;
+            ASSERT_EQ(first.size(), INTERNAL::consumeBracketedPaste((const unsigned char*)first.data(), first.size()));
+            ASSERT_EQ(second.size(), INTERNAL::consumeBracketedPaste((const unsigned char*)second.data(), second.size()));
+            ASSERT_TRUE(INTERNAL::currentContext->pasteInProgress);
+            ASSERT_TRUE(INTERNAL::currentContext->inputs.empty());
+
+            // Only the end marker is consumed, the trailing 'x' is normal input again.
+            ASSERT_EQ(third.size() - 1, INTERNAL::consumeBracketedPaste((const unsigned char*)third.data(), third.size()));
+            ASSERT_TRUE(!INTERNAL::currentContext->pasteInProgress);
+            ASSERT_EQ((size_t)1, INTERNAL::currentContext->inputs.size());
+
+            INTERNAL::eventHandler();
+
+            ASSERT_EQ(std::string("Hello\nworld"), field.getText());
+            ASSERT_EQ(0, characterCalls);
+        }
+
+        static void test_paste_start_split_between_reads() {
+            using namespace GGUI;
+
+            textField field;
+            field.compile();
+            attachInputHandler(field);
+
+            focusElement(field);
+
+            // Terminal splits the start marker over separate reads.
+            const std::string first = "ab\x1B[20";
+            const std::string second = "0~hello\x1B[201~";
+
+            // Raw input can only be given on terminals which read bytes.
+            if (INTERNAL::setRawInput(first.data(), first.size()) == 0)
+                return;
+
+            while (INTERNAL::Translate_Inputs());
+
+            // Only the keys before the marker are translated, the marker waits for the rest of it.
+            ASSERT_EQ((size_t)2, INTERNAL::currentContext->inputs.size());
+            ASSERT_TRUE(!INTERNAL::currentContext->pasteInProgress);
+
+            ASSERT_EQ(second.size(), INTERNAL::setRawInput(second.data(), second.size()));
+            while (INTERNAL::Translate_Inputs());
+
+            ASSERT_TRUE(!INTERNAL::currentContext->pasteInProgress);
+            ASSERT_EQ((size_t)3, INTERNAL::currentContext->inputs.size());
+            ASSERT_TRUE(INTERNAL::currentContext->inputs.back()->criteria == constants::PASTE);
+
+            INTERNAL::eventHandler();
+
+            ASSERT_EQ(std::string("abhello"), field.getText());
+        }
     };
 }
 
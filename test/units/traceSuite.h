@@ -0,0 +1,87 @@
+#ifndef _TRACE_SUITE_H_
+#define _TRACE_SUITE_H_
+
+#include "utils.h"
+#include <ggui_dev.h>
+
+#include <thread>
+
+// Recording the frame stages into per thread rings and exporting them as Chrome trace JSON.
+
+namespace tester {
+    class traceSuite : public utils::TestSuite {
+    public:
+        traceSuite() : utils::TestSuite("Trace spans") {
+            add_test("disabled_spans_are_not_recorded", "Spans outside of enable() leave no events", test_disabled_spans_are_not_recorded);
+            add_test("spans_export_as_chrome_trace", "Spans of each thread are exported with their detail and thread", test_spans_export_as_chrome_trace);
+        }
+
+    private:
+        static size_t count(const std::string& text, const std::string& part) {
+            size_t found = 0;
+            for (size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + 1))
+                found++;
+            return found;
+        }
+
+        static void test_disabled_spans_are_not_recorded() {
+            using namespace GGUI::INTERNAL;
+
+            TRACE::enable(false);
+            TRACE::clear();
+
+            {
+                TRACE::span ignored("ignored");
+                ASSERT_FALSE(ignored.isActive());
+            }
+
+            ASSERT_EQ((size_t)0, count(TRACE::toJSON(), "\"ph\":\"X\""));
+        }
+
+        static void test_spans_export_as_chrome_trace() {
+            using namespace GGUI::INTERNAL;
+
+            TRACE::clear();
+            TRACE::enable(true);
+
+            {
+                TRACE::span outer("outer");
+                TRACE::span inner("inner");
+                inner.setDetail("a \"quoted\" name which is longer than the detail can keep");
+            }
+
+            {
+                // The euro sign would straddle the end of the detail.
+                TRACE::span cut("cut");
+                cut.setDetail(std::string(30, 'x') + "\xE2\x82\xAC");
+            }
+
+            std::thread([]() {
+                TRACE::span other("otherThread");
+            }).join();
+
+            TRACE::enable(false);
+
+            std::string json = TRACE::toJSON();
+            TRACE::clear();
+
+            ASSERT_EQ((size_t)0, json.find("{\"traceEvents\":["));
+            ASSERT_EQ((size_t)4, count(json, "\"ph\":\"X\""));
+            ASSERT_EQ((size_t)1, count(json, "\"name\":\"outer\""));
+            ASSERT_EQ((size_t)1, count(json, "\"name\":\"otherThread\""));
+
+            // The detail is escaped and cut to fit.
+            ASSERT_EQ((size_t)1, count(json, "\"detail\":\"a \\\"quoted\\\" name which is longer\""));
+
+            // A multi-byte character which does not fit is left out whole.
+            ASSERT_EQ((size_t)1, count(json, "\"detail\":\"" + std::string(30, 'x') + "\""));
+
+            // The other thread has a ring of its own.
+            size_t outerThread = json.find("\"tid\":", json.find("\"name\":\"outer\""));
+            size_t otherThread = json.find("\"tid\":", json.find("\"name\":\"otherThread\""));
+            ASSERT_NE(json.substr(outerThread, 8), json.substr(otherThread, 8));
+        }
+    };
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include <cassert>
 #include <iomanip>
 #include <cctype>
+#include <thread>
 
 namespace tester {
     namespace utils {
@@ -24,13 +25,17 @@ namespace tester {
             int total_tests = 0;
             int passed_tests = 0;
             int failed_tests = 0;
+            int skipped_tests = 0;
             std::vector<std::string> failed_test_names;
+            std::vector<std::string> skipped_test_names;
             
             void reset() {
                 total_tests = 0;
                 passed_tests = 0;
                 failed_tests = 0;
+                skipped_tests = 0;
                 failed_test_names.clear();
+                skipped_test_names.clear();
             }
             
             void print_summary() {
@@ -38,6 +43,7 @@ namespace tester {
                 std::cout << "Total Tests: " << total_tests << "\n";
                 std::cout << colorText("Passed: ", GGUI::COLOR::GREEN) << passed_tests << "\n";
                 std::cout << colorText("Failed: ", GGUI::COLOR::RED) << failed_tests << "\n";
+                std::cout << colorText("Skipped: ", GGUI::COLOR::YELLOW) << skipped_tests << "\n";
                 
                 if (!failed_test_names.empty()) {
                     std::cout << colorText("\nFailed Tests:\n", GGUI::COLOR::RED);
@@ -45,9 +51,18 @@ namespace tester {
                         std::cout << "  - " << name << "\n";
                     }
                 }
+
+                // Skipped tests checked nothing, so they are listed for a green run not to be read as covering them.
+                if (!skipped_test_names.empty()) {
+                    std::cout << colorText("\nSkipped Tests:\n", GGUI::COLOR::YELLOW);
+                    for (const auto& name : skipped_test_names) {
+                        std::cout << "  - " << name << "\n";
+                    }
+                }
                 
+                int run_tests = total_tests - skipped_tests;
                 std::cout << colorText("\nSuccess Rate: ", GGUI::COLOR::YELLOW) 
-                        << (total_tests > 0 ? (passed_tests * 100.0 / total_tests) : 0) 
+                        << (run_tests > 0 ? (passed_tests * 100.0 / run_tests) : 0) 
                         << "%\n\n";
             }
 
@@ -55,7 +70,9 @@ namespace tester {
                 total_tests += stats.total_tests;
                 passed_tests += stats.passed_tests;
                 failed_tests += stats.failed_tests;
+                skipped_tests += stats.skipped_tests;
                 failed_test_names.insert(failed_test_names.end(), stats.failed_test_names.begin(), stats.failed_test_names.end());
+                skipped_test_names.insert(skipped_test_names.end(), stats.skipped_test_names.begin(), stats.skipped_test_names.end());
             }
         };
 
@@ -64,6 +81,11 @@ namespace tester {
         // Test case function type
         using TestFunction = std::function<void()>;
 
+        // Thrown by SKIP_TEST() when a test cannot check anything in this build or on this platform.
+        struct TestSkipped {
+            std::string reason;
+        };
+
         // Test case structure
         struct TestCase {
             std::string name;
@@ -109,6 +131,10 @@ namespace tester {
                     test_case.test_func();
                     std::cout << colorText("PASSED", GGUI::COLOR::GREEN) << "\n";
                     stats.passed_tests++;
+                } catch (const TestSkipped& skipped) {
+                    std::cout << colorText("SKIPPED", GGUI::COLOR::YELLOW) << " - " << skipped.reason << "\n";
+                    stats.skipped_tests++;
+                    stats.skipped_test_names.push_back(test_case.name);
                 } catch (const std::exception& e) {
                     std::cout << colorText("FAILED", GGUI::COLOR::RED) << " - " << e.what() << "\n";
                     stats.failed_tests++;
@@ -277,6 +303,40 @@ namespace tester {
         #define ASSERT_EQ(expected, actual) tester::utils::assert_eq((expected), (actual), __FILE__, __LINE__)
         #define ASSERT_NE(expected, actual) tester::utils::assert_ne((expected), (actual), __FILE__, __LINE__)
         #define ASSERT_FLOAT_EQ(expected, actual, epsilon) tester::utils::assert_float_eq((expected), (actual), (epsilon), __FILE__, __LINE__)
+        #define SKIP_TEST(reason) throw tester::utils::TestSkipped{reason}
+
+        // Renders one frame like the render thread does, finishing the cycle only when the ticket was taken for it.
+        void renderOneFrame() {
+            using namespace GGUI::INTERNAL;
+
+            bool taken = currentContext->ticket.take();
+            renderCycle();
+            if (taken)
+                finishRenderCycle();
+        }
+
+        // Runs the steps on a thread of its own, with a context of its own presenting into a headless backend of the given size.
+        // The main element fills the backend and is deleted with its children after the steps, so the checks belong after the call.
+        void onHeadlessScene(unsigned int w, unsigned int h, const std::function<void(GGUI::element* main, GGUI::INTERNAL::headlessBackend& output)>& steps) {
+            using namespace GGUI;
+            using namespace GGUI::INTERNAL;
+
+            headlessBackend output(w, h);
+
+            std::thread([&]() {
+                context session;
+                currentContext = &session;
+                setBackend(&output);
+                updateMaxWidthAndHeight();
+
+                // Embedded on construction like initGGUI() does for the real main element.
+                session.main = new element(width(w) | height(h) | name("Main"), true);
+
+                steps(session.main, output);
+
+                delete session.main;
+            }).join();
+        }
 
         // Function to run all test suites
         void run_all_tests(const std::vector<TestSuite*>& test_suites) {